@@ -0,0 +1,71 @@
+//*****************************************************************************
+//
+// HAL_MSP_EXP430FR5529_Clock.h - Clock system of the board.
+//
+// Clock_Init() raises the core voltage, starts the XT1 watch crystal and locks
+// the FLL to it, giving MCLK and SMCLK from the DCO and ACLK from XT1. The
+// rates below are the rates it actually produces. Every delay, SPI divider and
+// timer period is computed from them, so changing CLOCK_TARGET_HZ retunes the
+// whole program.
+//
+// Only constants live here, the host tools include it as well.
+//
+//*****************************************************************************
+
+#ifndef __HAL_MSP_EXP430FR5529_CLOCK_H__
+#define __HAL_MSP_EXP430FR5529_CLOCK_H__
+
+//*****************************************************************************
+//
+// User Configuration for the clock system
+//
+//*****************************************************************************
+
+// Frequency of the XT1 watch crystal, which is both the FLL reference and ACLK
+#define CLOCK_XT1_HZ			32768UL
+
+// Wanted MCLK and SMCLK. The MSP430F5529 runs up to 25MHz at PMMCOREV_3.
+#define CLOCK_TARGET_HZ			25000000UL
+
+//*****************************************************************************
+//
+// Derived rates
+//
+//*****************************************************************************
+
+// FLL multiplier, with FLLD = 1 and FLLREFDIV = 1: DCOCLK = (N + 1) * XT1
+#define CLOCK_FLL_N				(((CLOCK_TARGET_HZ + CLOCK_XT1_HZ / 2) / CLOCK_XT1_HZ) - 1)
+
+// The rates Clock_Init() sets up. MCLK is 25.001984MHz for a 25MHz target.
+#define CLOCK_MCLK_HZ			((CLOCK_FLL_N + 1) * CLOCK_XT1_HZ)
+#define CLOCK_SMCLK_HZ			CLOCK_MCLK_HZ
+#define CLOCK_ACLK_HZ			CLOCK_XT1_HZ
+
+// Lowest core voltage level that supports MCLK
+#define CLOCK_VCORE_LEVEL		((CLOCK_MCLK_HZ > 20000000UL) ? 3 :			\
+								 (CLOCK_MCLK_HZ > 12000000UL) ? 2 :			\
+								 (CLOCK_MCLK_HZ >  8000000UL) ? 1 : 0)
+
+//*****************************************************************************
+//
+// Conversions, all of them compile time constants when their arguments are
+//
+//*****************************************************************************
+
+// Ticks of a clock of rate ulClkHz in one period of a ulHz event, rounded
+#define CLOCK_TICKS(ulClkHz, ulHz)	(((ulClkHz) + (ulHz) / 2) / (ulHz))
+
+// MCLK cycles in a number of milliseconds, for __delay_cycles()
+#define CLOCK_MS_CYCLES(ulMs)		((CLOCK_MCLK_HZ / 1000) * (ulMs))
+
+// UCxBR divider of SMCLK giving a SPI clock no faster than ulHz
+#define CLOCK_SPI_DIV(ulHz)			((CLOCK_SMCLK_HZ + (ulHz) - 1) / (ulHz))
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+extern void Clock_Init(void);
+
+#endif // __HAL_MSP_EXP430FR5529_CLOCK_H__
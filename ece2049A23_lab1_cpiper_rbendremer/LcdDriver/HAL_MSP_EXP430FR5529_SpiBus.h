@@ -0,0 +1,91 @@
+//*****************************************************************************
+//
+// HAL_MSP_EXP430FR5529_SpiBus.h - Sharing of the UCB0 SPI bus between the
+// Sharp LCD and the other SPI devices of the board, such as the DAC.
+//
+// The LCD owns the bus for the length of a transaction, between AssertCS()
+// and DeassertCS(), or from the grant of SpiBus_Request() to DeassertCS() for
+// a DMA frame. Other devices hand short transactions to the bus with
+// SpiBus_Submit(). The queue is sent from USCI_B0_ISR a byte at a time, as
+// soon as the bus is free, and never from the caller. A DMA frame to the LCD
+// releases the bus between two lines whenever a transaction is queued, so a
+// DAC write waits for one line at most, and takes it back once the queue has
+// been sent.
+//
+// Every device states its clock divisor, clock phase and polarity and chip
+// select. The USCI is only reconfigured when the device changes.
+//
+//*****************************************************************************
+
+#ifndef __HAL_MSP_EXP430FR5529_SPIBUS_H__
+#define __HAL_MSP_EXP430FR5529_SPIBUS_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+//*****************************************************************************
+//
+// Transactions that can be waiting for the bus
+//
+//*****************************************************************************
+#define SPI_BUS_QUEUE_LENGTH		4
+
+//*****************************************************************************
+//
+// Longest transaction, in bytes
+//
+//*****************************************************************************
+#define SPI_BUS_TRANSACTION_MAX		4
+
+//*****************************************************************************
+//
+//! A device on the bus.
+//
+//*****************************************************************************
+typedef struct
+{
+	//! Output register of the port of the chip select pin, or NULL for the
+	//! LCD, which drives its own chip select
+	volatile uint8_t *pucCsOut;
+	//! Chip select pin
+	uint8_t ucCsPin;
+	//! True when the device is selected by driving its chip select high
+	bool bCsActiveHigh;
+	//! UCCKPH, UCCKPL and UCMSB bits of UCB0CTL0 for the device
+	uint8_t ucCtl0;
+	//! Divisor of the SPI clock source
+	uint16_t uiClkDiv;
+} tSpiBusDevice;
+
+//*****************************************************************************
+//
+//! A transaction queued with SpiBus_Submit().
+//
+//*****************************************************************************
+typedef struct
+{
+	//! Device the transaction is addressed to
+	const tSpiBusDevice *psDevice;
+	//! Bytes to send. They are copied when the transaction starts to go out,
+	//! and may be rewritten until then.
+	const uint8_t *pucData;
+	//! Number of bytes to send, at most SPI_BUS_TRANSACTION_MAX
+	uint8_t ucSize;
+	//! Called from USCI_B0_ISR once the chip select has been released, or
+	//! NULL
+	void (*pfnDone)(void);
+} tSpiBusTransaction;
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+extern void SpiBus_Acquire(const tSpiBusDevice *psDevice);
+extern void SpiBus_Request(const tSpiBusDevice *psDevice,
+                           void (*pfnGranted)(void));
+extern void SpiBus_Release(void);
+extern bool SpiBus_Pending(void);
+extern bool SpiBus_Submit(const tSpiBusTransaction *psTransaction);
+
+#endif // __HAL_MSP_EXP430FR5529_SPIBUS_H__
@@ -0,0 +1,130 @@
+//*****************************************************************************
+//
+// button.c - The rectangular button widget declared by button.h.
+//
+// A button is a filled rectangle with an optional border and a string. It
+// is drawn through the grlib primitives, so only the display lines under the
+// button are touched when it is drawn again.
+//
+//*****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "grlib.h"
+#include "button.h"
+
+//*****************************************************************************
+//
+// Draws a button with the colors of the given state.
+//
+//*****************************************************************************
+static void drawButton(const Graphics_Context *context,
+                       const Graphics_Button *button, bool selected)
+{
+    Graphics_Context sContext = *context;
+    Graphics_Rectangle sRect;
+    uint8_t i;
+
+    sRect.xMin = button->xMin;
+    sRect.yMin = button->yMin;
+    sRect.xMax = button->xMax;
+    sRect.yMax = button->yMax;
+
+    Graphics_setForegroundColor(&sContext,
+                                selected ? button->selectedColor : button->fillColor);
+    Graphics_fillRectangle(&sContext, &sRect);
+
+    // The border is drawn inwards, a rectangle per pixel of width
+    Graphics_setForegroundColor(&sContext, button->borderColor);
+
+    for(i = 0; i < button->borderWidth; i++)
+    {
+        Graphics_drawRectangle(&sContext, &sRect);
+        sRect.xMin++;
+        sRect.yMin++;
+        sRect.xMax--;
+        sRect.yMax--;
+    }
+
+    if(button->text)
+    {
+        Graphics_setForegroundColor(&sContext,
+                                    selected ? button->selectedTextColor :
+                                    button->textColor);
+        Graphics_setFont(&sContext, button->font);
+        Graphics_drawString(&sContext, (uint8_t *)button->text,
+                            AUTO_STRING_LENGTH, button->textXPos,
+                            button->textYPos, TRANSPARENT_TEXT);
+    }
+}
+
+//*****************************************************************************
+//
+//! Draws a button in its current state.
+//!
+//! \param context is a pointer to the drawing context to use.
+//! \param button is a pointer to the button.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void Graphics_drawButton(const Graphics_Context *context,
+                         const Graphics_Button *button)
+{
+    drawButton(context, button, button->selected);
+}
+
+//*****************************************************************************
+//
+//! Checks whether a point is on a button.
+//!
+//! \param button is a pointer to the button.
+//! \param x is the X coordinate of the point.
+//! \param y is the Y coordinate of the point.
+//!
+//! \return Returns true if the point is within the button.
+//
+//*****************************************************************************
+bool Graphics_isButtonSelected(const Graphics_Button *button, uint16_t x,
+                               uint16_t y)
+{
+    return((x >= button->xMin) && (x <= button->xMax) &&
+           (y >= button->yMin) && (y <= button->yMax));
+}
+
+//*****************************************************************************
+//
+//! Draws a button with its selected colors.
+//!
+//! \param context is a pointer to the drawing context to use.
+//! \param button is a pointer to the button.
+//!
+//! The selected field of the button is not changed.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void Graphics_drawSelectedButton(const Graphics_Context *context,
+                                 const Graphics_Button *button)
+{
+    drawButton(context, button, true);
+}
+
+//*****************************************************************************
+//
+//! Draws a button with its released colors.
+//!
+//! \param context is a pointer to the drawing context to use.
+//! \param button is a pointer to the button.
+//!
+//! The selected field of the button is not changed.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void Graphics_drawReleasedButton(const Graphics_Context *context,
+                                 const Graphics_Button *button)
+{
+    drawButton(context, button, false);
+}
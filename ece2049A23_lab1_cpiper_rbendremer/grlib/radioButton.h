@@ -70,5 +70,7 @@ extern void Graphics_drawSelectedRadioButton(const Graphics_Context *context,
 		const Graphics_RadioButton *radioButton);
 extern void Graphics_drawReleasedRadioButton(const Graphics_Context *context,
 		const Graphics_RadioButton *radioButton);
+extern void Graphics_getRadioButtonRectangle(const Graphics_Context *context,
+		const Graphics_RadioButton *radioButton, Graphics_Rectangle *rect);
 
 #endif /* RADIOBUTTON_H_ */
@@ -0,0 +1,383 @@
+//*****************************************************************************
+//
+// widget.c - A tree of the button, check box, radio button and image button
+// widgets, with the rectangle each one covers.
+//
+// Every widget records the rectangle it draws into when it is initialized,
+// and every group the rectangle around its widgets. Drawing a widget only
+// draws inside its rectangle, and selecting or releasing one only redraws the
+// part of it that shows the state, so the display driver only has the lines
+// under that part to send on the next flush.
+//
+//*****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "grlib.h"
+#include "button.h"
+#include "checkbox.h"
+#include "radioButton.h"
+#include "imageButton.h"
+#include "widget.h"
+
+//*****************************************************************************
+//
+// Returns the selected field of a widget, or NULL for a group.
+//
+//*****************************************************************************
+static bool *selectedField(const Graphics_Widget *widget)
+{
+    switch(widget->type)
+    {
+    case GRAPHICS_WIDGET_BUTTON:
+        return &((Graphics_Button *)widget->object)->selected;
+
+    case GRAPHICS_WIDGET_CHECKBOX:
+        return &((Graphics_CheckBox *)widget->object)->selected;
+
+    case GRAPHICS_WIDGET_RADIOBUTTON:
+        return &((Graphics_RadioButton *)widget->object)->selected;
+
+    case GRAPHICS_WIDGET_IMAGEBUTTON:
+        return &((Graphics_ImageButton *)widget->object)->selected;
+
+    default:
+        return NULL;
+    }
+}
+
+//*****************************************************************************
+//
+// Grows the rectangle of a group and of the groups holding it to cover a
+// rectangle.
+//
+//*****************************************************************************
+static void growBounds(Graphics_Widget *group, const Graphics_Rectangle *rect)
+{
+    for(; group; group = group->parent)
+    {
+        if(group->bounds.xMin > group->bounds.xMax)
+        {
+            group->bounds = *rect;
+            continue;
+        }
+
+        if(rect->xMin < group->bounds.xMin)
+        {
+            group->bounds.xMin = rect->xMin;
+        }
+
+        if(rect->yMin < group->bounds.yMin)
+        {
+            group->bounds.yMin = rect->yMin;
+        }
+
+        if(rect->xMax > group->bounds.xMax)
+        {
+            group->bounds.xMax = rect->xMax;
+        }
+
+        if(rect->yMax > group->bounds.yMax)
+        {
+            group->bounds.yMax = rect->yMax;
+        }
+    }
+}
+
+//*****************************************************************************
+//
+//! Initializes a widget and records the rectangle it covers.
+//!
+//! \param context is a pointer to the drawing context the widget will be
+//! drawn with, used to measure text.
+//! \param widget is a pointer to the widget to initialize.
+//! \param type is the type of the widget, one of GRAPHICS_WIDGET_xxx.
+//! \param object is a pointer to the Graphics_Button, Graphics_CheckBox,
+//! Graphics_RadioButton or Graphics_ImageButton, or NULL for a group.
+//!
+//! A group covers nothing until widgets are added to it. The widget must be
+//! initialized again if its position, size or, for check boxes and radio
+//! buttons, its text changes.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void Graphics_initWidget(const Graphics_Context *context,
+                         Graphics_Widget *widget, uint8_t type, void *object)
+{
+    const Graphics_Button *button;
+
+    widget->type = type;
+    widget->object = object;
+    widget->parent = NULL;
+    widget->child = NULL;
+    widget->next = NULL;
+
+    switch(type)
+    {
+    case GRAPHICS_WIDGET_BUTTON:
+        button = (const Graphics_Button *)object;
+        widget->bounds.xMin = button->xMin;
+        widget->bounds.yMin = button->yMin;
+        widget->bounds.xMax = button->xMax;
+        widget->bounds.yMax = button->yMax;
+        break;
+
+    case GRAPHICS_WIDGET_CHECKBOX:
+        Graphics_getCheckBoxRectangle(context, (const Graphics_CheckBox *)object,
+                                      &widget->bounds);
+        break;
+
+    case GRAPHICS_WIDGET_RADIOBUTTON:
+        Graphics_getRadioButtonRectangle(context,
+                                         (const Graphics_RadioButton *)object,
+                                         &widget->bounds);
+        break;
+
+    case GRAPHICS_WIDGET_IMAGEBUTTON:
+        Graphics_getImageButtonRectangle((const Graphics_ImageButton *)object,
+                                         &widget->bounds);
+        break;
+
+    default:
+        // Empty
+        widget->bounds.xMin = 0;
+        widget->bounds.yMin = 0;
+        widget->bounds.xMax = -1;
+        widget->bounds.yMax = -1;
+        break;
+    }
+}
+
+//*****************************************************************************
+//
+//! Adds a widget to the end of a group.
+//!
+//! \param group is a pointer to the group.
+//! \param widget is a pointer to the widget to add, which must not be in a
+//! group already.
+//!
+//! The rectangles of the group and of the groups holding it grow to cover the
+//! widget.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void Graphics_addWidget(Graphics_Widget *group, Graphics_Widget *widget)
+{
+    Graphics_Widget **ppLink = &group->child;
+
+    while(*ppLink)
+    {
+        ppLink = &(*ppLink)->next;
+    }
+
+    *ppLink = widget;
+    widget->parent = group;
+    widget->next = NULL;
+
+    if(widget->bounds.xMin <= widget->bounds.xMax)
+    {
+        growBounds(group, &widget->bounds);
+    }
+}
+
+//*****************************************************************************
+//
+//! Draws a widget in its current state, or every widget of a group.
+//!
+//! \param context is a pointer to the drawing context to use.
+//! \param widget is a pointer to the widget.
+//!
+//! Nothing is drawn outside the rectangle of the widget. Use this to show a
+//! change other than selection, such as new button text.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void Graphics_drawWidget(const Graphics_Context *context,
+                         const Graphics_Widget *widget)
+{
+    const Graphics_Widget *child;
+
+    switch(widget->type)
+    {
+    case GRAPHICS_WIDGET_BUTTON:
+        Graphics_drawButton(context, (const Graphics_Button *)widget->object);
+        break;
+
+    case GRAPHICS_WIDGET_CHECKBOX:
+        Graphics_drawCheckBox(context, (const Graphics_CheckBox *)widget->object);
+        break;
+
+    case GRAPHICS_WIDGET_RADIOBUTTON:
+        Graphics_drawRadioButton(context,
+                                 (const Graphics_RadioButton *)widget->object);
+        break;
+
+    case GRAPHICS_WIDGET_IMAGEBUTTON:
+        Graphics_drawImageButton(context,
+                                 (const Graphics_ImageButton *)widget->object);
+        break;
+
+    default:
+        for(child = widget->child; child; child = child->next)
+        {
+            Graphics_drawWidget(context, child);
+        }
+        break;
+    }
+}
+
+//*****************************************************************************
+//
+//! Finds the widget under a point.
+//!
+//! \param widget is a pointer to the widget or group to search.
+//! \param x is the X coordinate of the point.
+//! \param y is the Y coordinate of the point.
+//!
+//! Groups are searched in order and the first widget, other than a group,
+//! whose rectangle holds the point is returned. Groups that do not cover the
+//! point are skipped whole.
+//!
+//! \return Returns a pointer to the widget, or NULL if there is none.
+//
+//*****************************************************************************
+Graphics_Widget *Graphics_findWidget(Graphics_Widget *widget, uint16_t x,
+                                     uint16_t y)
+{
+    Graphics_Widget *child;
+    Graphics_Widget *found;
+
+    if(((int16_t)x < widget->bounds.xMin) || ((int16_t)x > widget->bounds.xMax) ||
+       ((int16_t)y < widget->bounds.yMin) || ((int16_t)y > widget->bounds.yMax))
+    {
+        return NULL;
+    }
+
+    if(GRAPHICS_WIDGET_GROUP != widget->type)
+    {
+        return widget;
+    }
+
+    for(child = widget->child; child; child = child->next)
+    {
+        found = Graphics_findWidget(child, x, y);
+
+        if(found)
+        {
+            return found;
+        }
+    }
+
+    return NULL;
+}
+
+//*****************************************************************************
+//
+//! Checks whether a widget is selected.
+//!
+//! \param widget is a pointer to the widget.
+//!
+//! \return Returns true if the widget is selected, false if it is not or is a
+//! group.
+//
+//*****************************************************************************
+bool Graphics_isWidgetSelected(const Graphics_Widget *widget)
+{
+    bool *pbSelected = selectedField(widget);
+
+    return pbSelected && *pbSelected;
+}
+
+//*****************************************************************************
+//
+//! Selects or releases a widget, redrawing it only if its state changes.
+//!
+//! \param context is a pointer to the drawing context to use.
+//! \param widget is a pointer to the widget, which must have been drawn.
+//! \param selected is true to select the widget, false to release it.
+//!
+//! Only the part of the widget that shows its state is redrawn: the whole of
+//! a button, the inside of a check box or radio button and the border of an
+//! image button. Selecting a radio button releases the other radio buttons of
+//! its group. Groups cannot be selected.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void Graphics_selectWidget(const Graphics_Context *context,
+                           Graphics_Widget *widget, bool selected)
+{
+    bool *pbSelected = selectedField(widget);
+    Graphics_Widget *sibling;
+
+    if(!pbSelected || (*pbSelected == selected))
+    {
+        return;
+    }
+
+    if(selected && (GRAPHICS_WIDGET_RADIOBUTTON == widget->type) &&
+       widget->parent)
+    {
+        for(sibling = widget->parent->child; sibling; sibling = sibling->next)
+        {
+            if((sibling != widget) &&
+               (GRAPHICS_WIDGET_RADIOBUTTON == sibling->type))
+            {
+                Graphics_selectWidget(context, sibling, false);
+            }
+        }
+    }
+
+    *pbSelected = selected;
+
+    switch(widget->type)
+    {
+    case GRAPHICS_WIDGET_BUTTON:
+        Graphics_drawButton(context, (const Graphics_Button *)widget->object);
+        break;
+
+    case GRAPHICS_WIDGET_CHECKBOX:
+        if(selected)
+        {
+            Graphics_drawSelectedCheckBox(context,
+                                          (const Graphics_CheckBox *)widget->object);
+        }
+        else
+        {
+            Graphics_drawReleasedCheckBox(context,
+                                          (const Graphics_CheckBox *)widget->object);
+        }
+        break;
+
+    case GRAPHICS_WIDGET_RADIOBUTTON:
+        if(selected)
+        {
+            Graphics_drawSelectedRadioButton(context,
+                                             (const Graphics_RadioButton *)widget->object);
+        }
+        else
+        {
+            Graphics_drawReleasedRadioButton(context,
+                                             (const Graphics_RadioButton *)widget->object);
+        }
+        break;
+
+    default:
+        if(selected)
+        {
+            Graphics_drawSelectedImageButton(context,
+                                             (const Graphics_ImageButton *)widget->object);
+        }
+        else
+        {
+            Graphics_drawReleasedImageButton(context,
+                                             (const Graphics_ImageButton *)widget->object);
+        }
+        break;
+    }
+}
@@ -0,0 +1,55 @@
+//*****************************************************************************
+//
+// widget.h - A tree of the button, check box, radio button and image button
+// widgets, with the rectangle each one covers.
+//
+//*****************************************************************************
+
+#ifndef WIDGET_H_
+#define WIDGET_H_
+
+//*****************************************************************************
+// defines
+//*****************************************************************************
+
+//! A widget that only holds other widgets. Radio buttons in the same group
+//! release each other when selected.
+#define GRAPHICS_WIDGET_GROUP           0
+#define GRAPHICS_WIDGET_BUTTON          1
+#define GRAPHICS_WIDGET_CHECKBOX        2
+#define GRAPHICS_WIDGET_RADIOBUTTON     3
+#define GRAPHICS_WIDGET_IMAGEBUTTON     4
+
+//*****************************************************************************
+// typedefs
+//*****************************************************************************
+
+
+//! \brief This structure defines a node of a widget tree
+//!
+typedef struct Graphics_Widget
+{
+	uint8_t type;                    /*!< One of GRAPHICS_WIDGET_xxx */
+	void *object;                    /*!< The Graphics_Button, Graphics_CheckBox... NULL for a group */
+	Graphics_Rectangle bounds;       /*!< Every pixel the widget draws, those of its children for a group */
+	struct Graphics_Widget *parent;  /*!< Group holding the widget, or NULL */
+	struct Graphics_Widget *child;   /*!< First widget of a group */
+	struct Graphics_Widget *next;    /*!< Next widget of the same group */
+} Graphics_Widget;
+
+//*****************************************************************************
+// the function prototypes
+//*****************************************************************************
+extern void Graphics_initWidget(const Graphics_Context *context,
+		Graphics_Widget *widget, uint8_t type, void *object);
+extern void Graphics_addWidget(Graphics_Widget *group,
+		Graphics_Widget *widget);
+extern void Graphics_drawWidget(const Graphics_Context *context,
+		const Graphics_Widget *widget);
+extern Graphics_Widget *Graphics_findWidget(Graphics_Widget *widget,
+		uint16_t x, uint16_t y);
+extern bool Graphics_isWidgetSelected(const Graphics_Widget *widget);
+extern void Graphics_selectWidget(const Graphics_Context *context,
+		Graphics_Widget *widget, bool selected);
+
+#endif /* WIDGET_H_ */
@@ -46,4 +46,21 @@
 extern const tImage  LPRocket_96x37_1BPP_UNCOMP;
 extern const tImage  TI_Logo_69x64_1BPP_UNCOMP;
 
+//*****************************************************************************
+//
+// The same images pre-rotated for the Sharp96x96 driver, in images_rot90.c.
+//
+//*****************************************************************************
+extern const Sharp96x96_RotatedImage LPRocket_96x37_ROT90;
+extern const Sharp96x96_RotatedImage TI_Logo_69x64_ROT90;
+
+//*****************************************************************************
+//
+// The same images packed for the Sharp96x96 driver from the PBMs in this
+// directory, in images_packed.c.
+//
+//*****************************************************************************
+extern const Sharp96x96_PackedImage LPRocket_96x37_PACKED;
+extern const Sharp96x96_PackedImage TI_Logo_69x64_PACKED;
+
 #endif // __IMAGES_H__
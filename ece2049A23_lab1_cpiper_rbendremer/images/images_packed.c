@@ -0,0 +1,83 @@
+//*****************************************************************************
+//
+// Generated by tools/pack_image.c, do not edit.
+//
+//*****************************************************************************
+
+#include <stdint.h>
+#include "grlib.h"
+#include "LcdDriver/Sharp96x96.h"
+
+#include "images/images.h"
+
+static const uint8_t g_pucPackedLPRocket_96x37Data[] =
+{
+    0xff, 0xff, 0xff, 0xf0, 0x1f, 0xf5, 0x2f, 0xf4, 0x11, 0x1f, 0xf3, 0x12,
+    0x1f, 0xf2, 0x22, 0x1f, 0xf1, 0x23, 0x1f, 0xf0, 0x24, 0x1f, 0xf0, 0x15,
+    0x1f, 0xe2, 0x51, 0xfd, 0x26, 0x1f, 0xd1, 0x71, 0xfc, 0x27, 0x1f, 0xc1,
+    0x81, 0x21, 0xf8, 0x23, 0x23, 0x4f, 0x81, 0x41, 0x42, 0x11, 0xf7, 0x14,
+    0x23, 0x22, 0x1f, 0x71, 0x41, 0x41, 0x31, 0xf6, 0x14, 0x19, 0x1f, 0x61,
+    0x41, 0x91, 0xf5, 0x14, 0x1a, 0x1f, 0x51, 0x41, 0xa1, 0xf4, 0x23, 0x1a,
+    0x2f, 0x41, 0x41, 0xa2, 0xf3, 0x23, 0x16, 0x23, 0x1f, 0x41, 0x41, 0x61,
+    0x41, 0xf4, 0x13, 0x26, 0x14, 0x1f, 0x32, 0x31, 0x71, 0x41, 0xf3, 0x14,
+    0x16, 0x24, 0x1f, 0x31, 0x31, 0x72, 0x32, 0xf2, 0x23, 0x17, 0x14, 0x1f,
+    0x31, 0x41, 0x71, 0x41, 0xf3, 0x13, 0x18, 0x14, 0x1f, 0x31, 0x31, 0x71,
+    0x41, 0xf4, 0x13, 0x17, 0x14, 0x1f, 0x32, 0x22, 0x71, 0x41, 0xf3, 0x13,
+    0x17, 0x14, 0x1f, 0x41, 0x31, 0x71, 0x41, 0xf4, 0x13, 0x16, 0x23, 0x2f,
+    0x41, 0x31, 0x61, 0x41, 0xf5, 0x12, 0x25, 0x23, 0x2f, 0x51, 0x21, 0x61,
+    0x41, 0xf6, 0x12, 0x15, 0x23, 0x1f, 0x71, 0x21, 0x51, 0x32, 0xf2, 0x26,
+    0x14, 0x14, 0x1f, 0x32, 0x61, 0x41, 0x32, 0xf3, 0x25, 0x21, 0x16, 0x1f,
+    0x33, 0x52, 0x11, 0x51, 0xf4, 0x11, 0x15, 0x11, 0x24, 0x2f, 0x32, 0x11,
+    0x51, 0x12, 0x32, 0x32, 0xe1, 0x21, 0x72, 0x31, 0x42, 0xe1, 0x32, 0x51,
+    0x82, 0xe2, 0x44, 0x12, 0x82, 0xe1, 0x52, 0x24, 0x61, 0x11, 0xe1, 0x52,
+    0x27, 0x22, 0x11, 0xe1, 0x42, 0x32, 0x34, 0x22, 0xe1, 0x42, 0x32, 0x32,
+    0x41, 0xf0, 0x13, 0x24, 0x23, 0x24, 0x1f, 0x01, 0x22, 0x42, 0x41, 0x51,
+    0xf0, 0x12, 0x24, 0x24, 0x14, 0x1f, 0x12, 0x12, 0x42, 0x32, 0x41, 0xf2,
+    0x34, 0x33, 0x23, 0x2f, 0x23, 0x42, 0x42, 0x31, 0xf3, 0x24, 0x34, 0x22,
+    0x1f, 0x42, 0x43, 0x42, 0x11, 0xf5, 0x24, 0x34, 0x3f, 0x52, 0xc2, 0xf6,
+    0x3a, 0x2f, 0x74, 0x92, 0xf6, 0x77, 0x2f, 0x6f, 0x0f, 0x7f, 0x0f, 0x7f,
+    0x0f, 0x6f, 0x1f, 0x6f, 0x0f, 0x7f, 0x0f, 0x7f, 0x0f, 0x7e, 0xf8, 0x12,
+    0xbf, 0x72, 0x48, 0xf8, 0x28, 0x4f, 0x82, 0xa1, 0xf9, 0x29, 0x2f, 0x92,
+    0x92, 0xf9, 0x28, 0x2f, 0xa2, 0x72, 0xfb, 0x27, 0x2f, 0xb2, 0x62, 0xfd,
+    0x24, 0x3f, 0xd2, 0x33, 0xfe, 0x31, 0x3f, 0xf1, 0x5f, 0xff, 0xff, 0xff,
+    0xff, 0x40,
+};
+
+const Sharp96x96_PackedImage LPRocket_96x37_PACKED =
+{
+    96,
+    37,
+    338,
+    g_pucPackedLPRocket_96x37Data
+};
+
+static const uint8_t g_pucPackedTI_Logo_69x64Data[] =
+{
+    0xfb, 0x3f, 0xff, 0xf1, 0x4f, 0xff, 0xf0, 0x5f, 0xff, 0xe5, 0xff, 0xfe,
+    0x6f, 0xff, 0xd7, 0xff, 0xfc, 0x8f, 0xff, 0xb9, 0xff, 0xfa, 0xbf, 0xff,
+    0x8e, 0xff, 0xf5, 0xf1, 0xff, 0xf3, 0xf2, 0xff, 0xf2, 0xf3, 0xff, 0xf1,
+    0xf4, 0xff, 0xf0, 0xf4, 0xff, 0xf0, 0xf4, 0xff, 0xf0, 0xf4, 0xff, 0xf0,
+    0xf4, 0xf4, 0xff, 0xef, 0x5f, 0xfe, 0xf5, 0xff, 0xdf, 0x6f, 0xfc, 0xf7,
+    0xff, 0xcf, 0x7f, 0xfc, 0xf7, 0xff, 0xcf, 0x7f, 0xfc, 0xf7, 0xff, 0xdf,
+    0x6f, 0xfe, 0xf5, 0xff, 0xf0, 0xf4, 0xff, 0xf2, 0xf2, 0xf8, 0x4f, 0x6f,
+    0x1f, 0x57, 0xf8, 0xef, 0x57, 0xfa, 0xdf, 0x47, 0x98, 0xaf, 0x87, 0x75,
+    0xea, 0xf7, 0x6f, 0xbc, 0xf5, 0x6f, 0x32, 0x7c, 0xf4, 0x4f, 0x07, 0x7d,
+    0xff, 0x2c, 0x8d, 0xfc, 0xf1, 0x8e, 0xf6, 0xf6, 0x8e, 0xf3, 0xf9, 0x8f,
+    0x0a, 0x43, 0xf9, 0x8f, 0x09, 0x62, 0xf8, 0x9f, 0x18, 0x62, 0xf4, 0xdf,
+    0x18, 0x62, 0xef, 0x3f, 0x18, 0x62, 0x9e, 0x35, 0xf2, 0x94, 0x35, 0xe7,
+    0x5f, 0x2a, 0x2f, 0x3c, 0x5f, 0x2f, 0xce, 0x2c, 0x36, 0xfc, 0xfa, 0x92,
+    0xf2, 0x47, 0xf8, 0xfd, 0x67, 0xf7, 0xfe, 0x67, 0xf6, 0xff, 0x06, 0x7f,
+    0x5f, 0xf1, 0x65, 0xf6, 0xff, 0x2f, 0xf1, 0xff, 0x3f, 0xf1, 0xff, 0x3f,
+    0xf0, 0xff, 0x4f, 0xef, 0xf5, 0xfe, 0xff, 0x5f, 0xdf, 0xf6, 0xfd, 0xff,
+    0x6f, 0xcf, 0xf8, 0xfb, 0xff, 0xf3, 0xf0, 0xff, 0xf6, 0xdf, 0xff, 0x7b,
+    0xff, 0xf9, 0x8f, 0xc0,
+};
+
+const Sharp96x96_PackedImage TI_Logo_69x64_PACKED =
+{
+    69,
+    64,
+    208,
+    g_pucPackedTI_Logo_69x64Data
+};
+
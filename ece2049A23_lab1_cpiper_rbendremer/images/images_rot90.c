@@ -0,0 +1,199 @@
+//*****************************************************************************
+//
+// Generated by tools/rotate_assets.c, do not edit.
+//
+//*****************************************************************************
+
+#include <stdint.h>
+#include "grlib.h"
+#include "LcdDriver/Sharp96x96.h"
+
+#include "images/images.h"
+
+static const uint8_t g_pucRotatedLPRocket_96x37Data[] =
+{
+    0xff, 0xff, 0xff, 0xff, 0xf8,
+    0xff, 0xff, 0xff, 0xff, 0xf8,
+    0xff, 0xff, 0xff, 0xfe, 0xf8,
+    0xff, 0xff, 0xff, 0xfc, 0xf8,
+    0xff, 0xff, 0xff, 0xfa, 0xf8,
+    0xff, 0xff, 0xff, 0xf6, 0xf8,
+    0xff, 0xff, 0xff, 0xe6, 0xf8,
+    0xff, 0xff, 0xff, 0xce, 0xf8,
+    0xff, 0xff, 0xff, 0x9e, 0xf8,
+    0xff, 0xff, 0xff, 0xbe, 0xf8,
+    0xff, 0xff, 0xff, 0x3e, 0xf8,
+    0xff, 0xff, 0xfe, 0x7e, 0xf8,
+    0xff, 0xff, 0xfe, 0xfe, 0xf8,
+    0xff, 0xff, 0xfc, 0xfe, 0xf8,
+    0xff, 0xff, 0xfd, 0xfe, 0xd8,
+    0xff, 0xff, 0xf9, 0xce, 0x18,
+    0xff, 0xff, 0xfb, 0xde, 0x58,
+    0xff, 0xff, 0xf7, 0x9c, 0xd8,
+    0xff, 0xff, 0xf7, 0xbd, 0xd8,
+    0xff, 0xff, 0xef, 0x7f, 0xd8,
+    0xff, 0xff, 0xef, 0x7f, 0xd8,
+    0xff, 0xff, 0xde, 0xff, 0xd8,
+    0xff, 0xff, 0xde, 0xff, 0xd8,
+    0xff, 0xff, 0x9d, 0xff, 0x98,
+    0xff, 0xff, 0xbd, 0xff, 0x98,
+    0xff, 0xff, 0x3b, 0xf3, 0xb8,
+    0xff, 0xff, 0x7b, 0xf7, 0xb8,
+    0xff, 0xff, 0x73, 0xf7, 0xb8,
+    0xff, 0xfe, 0x77, 0xf7, 0xb8,
+    0xff, 0xfe, 0xf7, 0xe7, 0xb8,
+    0xff, 0xfe, 0xef, 0xe7, 0x38,
+    0xff, 0xfc, 0xef, 0xef, 0x78,
+    0xff, 0xfd, 0xef, 0xef, 0x78,
+    0xff, 0xfd, 0xdf, 0xef, 0x78,
+    0xff, 0xfd, 0xdf, 0xde, 0xf8,
+    0xff, 0xfd, 0xdf, 0xde, 0xf8,
+    0xff, 0xf9, 0x9f, 0xde, 0xf8,
+    0xff, 0xfb, 0xbf, 0xbd, 0xf8,
+    0xff, 0xfb, 0xbf, 0xbd, 0xf8,
+    0xff, 0xfb, 0xbf, 0x39, 0xf8,
+    0xff, 0xfb, 0xbf, 0x7b, 0xf8,
+    0xff, 0xfb, 0x3e, 0x73, 0xf8,
+    0xff, 0xfb, 0x7e, 0xf7, 0xf8,
+    0xff, 0xfb, 0x7c, 0xef, 0xf8,
+    0xff, 0xfb, 0x7d, 0xcf, 0xf8,
+    0xff, 0x3f, 0x7b, 0xdf, 0xf8,
+    0xff, 0x3f, 0x7b, 0x9f, 0xf8,
+    0xff, 0x3e, 0x5f, 0xbf, 0xf8,
+    0xfe, 0x3e, 0x5f, 0x7f, 0xf8,
+    0xfe, 0xbe, 0x9e, 0x7f, 0xf8,
+    0xfc, 0xbe, 0x9c, 0xe7, 0xf8,
+    0xfd, 0xbf, 0x9d, 0xe7, 0xf8,
+    0xfd, 0xcf, 0xbf, 0xcf, 0xf8,
+    0xf9, 0xe1, 0x3f, 0xcf, 0xf8,
+    0xfb, 0xe6, 0x1f, 0xaf, 0xf8,
+    0xfb, 0xe6, 0x03, 0x2f, 0xf8,
+    0xfb, 0xce, 0x70, 0xcf, 0xf8,
+    0xfb, 0xce, 0x73, 0xdf, 0xf8,
+    0xfb, 0x9e, 0x73, 0xdf, 0xf8,
+    0xfb, 0x3c, 0xf7, 0xdf, 0xf8,
+    0xfb, 0x3c, 0xf7, 0xbf, 0xf8,
+    0xf9, 0x3c, 0xe7, 0xbf, 0xf8,
+    0xfc, 0x78, 0xe7, 0x3f, 0xf8,
+    0xfc, 0x79, 0xe7, 0x7f, 0xf8,
+    0xfc, 0xf1, 0xe6, 0xff, 0xf8,
+    0xfc, 0xf1, 0xe5, 0xff, 0xf8,
+    0xfc, 0xf1, 0xe3, 0xff, 0xf8,
+    0xf9, 0xff, 0xe7, 0xff, 0xf8,
+    0xf8, 0xff, 0xcf, 0xff, 0xf8,
+    0xf8, 0x7f, 0xcf, 0xff, 0xf8,
+    0xf0, 0x1f, 0xcf, 0xff, 0xf8,
+    0xf0, 0x00, 0x1f, 0xff, 0xf8,
+    0xf0, 0x00, 0x1f, 0xff, 0xf8,
+    0xf0, 0x00, 0x1f, 0xff, 0xf8,
+    0xe0, 0x00, 0x1f, 0xff, 0xf8,
+    0xe0, 0x00, 0x3f, 0xff, 0xf8,
+    0xe0, 0x00, 0x3f, 0xff, 0xf8,
+    0xe0, 0x00, 0x3f, 0xff, 0xf8,
+    0xe0, 0x00, 0x7f, 0xff, 0xf8,
+    0xec, 0x00, 0x7f, 0xff, 0xf8,
+    0xcf, 0x00, 0xff, 0xff, 0xf8,
+    0xcf, 0xf0, 0xff, 0xff, 0xf8,
+    0xcf, 0xfd, 0xff, 0xff, 0xf8,
+    0xcf, 0xf9, 0xff, 0xff, 0xf8,
+    0xcf, 0xf9, 0xff, 0xff, 0xf8,
+    0xcf, 0xf3, 0xff, 0xff, 0xf8,
+    0xcf, 0xe7, 0xff, 0xff, 0xf8,
+    0xcf, 0xe7, 0xff, 0xff, 0xf8,
+    0xcf, 0xcf, 0xff, 0xff, 0xf8,
+    0xe7, 0x8f, 0xff, 0xff, 0xf8,
+    0xe7, 0x1f, 0xff, 0xff, 0xf8,
+    0xe2, 0x3f, 0xff, 0xff, 0xf8,
+    0xf0, 0x7f, 0xff, 0xff, 0xf8,
+    0xff, 0xff, 0xff, 0xff, 0xf8,
+    0xff, 0xff, 0xff, 0xff, 0xf8,
+    0xff, 0xff, 0xff, 0xff, 0xf8,
+};
+
+const Sharp96x96_RotatedImage LPRocket_96x37_ROT90 =
+{
+    96,
+    37,
+    g_pucRotatedLPRocket_96x37Data
+};
+
+static const uint8_t g_pucRotatedTI_Logo_69x64Data[] =
+{
+    0xff, 0xff, 0xff, 0xc7, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xc3, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xc1, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xc1, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xc0, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xc0, 0x7f, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xc0, 0x3f, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xc0, 0x1f, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xc0, 0x07, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xc0, 0x00, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xc0, 0x00, 0x3f, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xc0, 0x00, 0x1f, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xc0, 0x00, 0x0f, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xc0, 0x00, 0x07, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xc0, 0x00, 0x07, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xc0, 0x00, 0x07, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xc0, 0x00, 0x07, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xc0, 0x00, 0x07, 0xff, 0xff,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x0f, 0xff, 0xff,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x0f, 0xff, 0xff,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x1f, 0xff, 0xff,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x3f, 0xff, 0xff,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x3f, 0xff, 0xff,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x3f, 0xff, 0xff,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x3f, 0xff, 0xff,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x3f, 0xff, 0xff,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x1f, 0xff, 0xff,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x0f, 0xff, 0xff,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x07, 0xff, 0xff,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0xff, 0xff,
+    0x00, 0x00, 0x01, 0xe0, 0x00, 0x00, 0xff, 0xff,
+    0x00, 0x00, 0x0f, 0xe0, 0x00, 0x00, 0x3f, 0xff,
+    0x00, 0x00, 0x0f, 0xe0, 0x00, 0x00, 0x0f, 0xff,
+    0x80, 0x00, 0x0f, 0xe0, 0x0f, 0xf0, 0x03, 0xff,
+    0xff, 0xf8, 0x0f, 0xe0, 0xff, 0xfc, 0x00, 0xff,
+    0xff, 0xfc, 0x0f, 0xff, 0xff, 0xfc, 0x00, 0x3f,
+    0xff, 0xfc, 0x0f, 0xff, 0xfc, 0xfe, 0x00, 0x1f,
+    0xff, 0xfc, 0x3f, 0xff, 0x80, 0xfe, 0x00, 0x0f,
+    0xff, 0xff, 0xff, 0xf0, 0x00, 0xff, 0x00, 0x07,
+    0xff, 0xff, 0xff, 0x00, 0x00, 0xff, 0x00, 0x03,
+    0xff, 0xff, 0xe0, 0x00, 0x00, 0xff, 0x00, 0x03,
+    0xff, 0xff, 0x00, 0x00, 0x00, 0xff, 0x00, 0x01,
+    0xff, 0x87, 0x00, 0x00, 0x00, 0xff, 0x00, 0x01,
+    0xff, 0x03, 0x00, 0x00, 0x01, 0xff, 0x00, 0x00,
+    0xff, 0x03, 0x00, 0x00, 0x1f, 0xff, 0x00, 0x00,
+    0xff, 0x03, 0x00, 0x03, 0xff, 0xff, 0x00, 0x00,
+    0xff, 0x03, 0x00, 0x7f, 0xfe, 0x3e, 0x00, 0x00,
+    0xff, 0x87, 0x07, 0xff, 0xe0, 0x3e, 0x00, 0x00,
+    0xff, 0xcf, 0xff, 0xfc, 0x00, 0x3e, 0x00, 0x00,
+    0xff, 0xff, 0xff, 0xe0, 0x00, 0x60, 0x01, 0xc0,
+    0xff, 0xff, 0xff, 0xe0, 0x00, 0x00, 0x0f, 0xf9,
+    0xff, 0xff, 0x0f, 0xe0, 0x00, 0x00, 0x3f, 0xff,
+    0xff, 0xfc, 0x0f, 0xe0, 0x00, 0x00, 0x7f, 0xff,
+    0xff, 0xfc, 0x0f, 0xe0, 0x00, 0x00, 0xff, 0xff,
+    0xff, 0xfc, 0x0f, 0xe0, 0x00, 0x01, 0xff, 0xff,
+    0xff, 0xfc, 0x0f, 0x80, 0x00, 0x03, 0xff, 0xff,
+    0xff, 0xfc, 0x00, 0x00, 0x00, 0x07, 0xff, 0xff,
+    0xff, 0xfc, 0x00, 0x00, 0x00, 0x07, 0xff, 0xff,
+    0xff, 0xfc, 0x00, 0x00, 0x00, 0x0f, 0xff, 0xff,
+    0xff, 0xfc, 0x00, 0x00, 0x00, 0x1f, 0xff, 0xff,
+    0xff, 0xfc, 0x00, 0x00, 0x00, 0x1f, 0xff, 0xff,
+    0xff, 0xfc, 0x00, 0x00, 0x00, 0x3f, 0xff, 0xff,
+    0xff, 0xfc, 0x00, 0x00, 0x00, 0x3f, 0xff, 0xff,
+    0xff, 0xfc, 0x00, 0x00, 0x00, 0x7f, 0xff, 0xff,
+    0xff, 0xfe, 0x00, 0x00, 0x00, 0x7f, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0x80, 0x00, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xe0, 0x00, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xf0, 0x01, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xf8, 0x07, 0xff, 0xff, 0xff,
+};
+
+const Sharp96x96_RotatedImage TI_Logo_69x64_ROT90 =
+{
+    69,
+    64,
+    g_pucRotatedTI_Logo_69x64Data
+};
+
@@ -4,15 +4,18 @@
 #include <stdlib.h>
 #include <math.h>
 #include <main.h>
-
-// Settings (delays are in CPU cycles)
-#define PLAYBACK_ON_DELAY 100000
-#define PLAYBACK_OFF_DELAY 10000
-#define LOSE_DELAY 1000000
-#define COUNTDOWN_DELAY 1000000
-#define MAX_BUTTON_CHECKS 50000
-#define NUM_DISPLAY_CHECKS 10000
-#define KEY_DEBOUNCE_DELAY 10000
+#include "screens/screens.h"
+
+// Settings (delays are in CPU cycles, computed from milliseconds)
+#define PLAYBACK_ON_DELAY CLOCK_MS_CYCLES(100)
+#define PLAYBACK_OFF_DELAY CLOCK_MS_CYCLES(10)
+#define LOSE_DELAY_MS 1000     // Slept in LPM3 with sleepMillis()
+#define COUNTDOWN_DELAY_MS 1000
+// Poll counts were tuned on the 1.048576MHz default clock, so scale with MCLK
+#define CHECKS_CLOCK_SCALE (CLOCK_MCLK_HZ / 1048576UL)
+#define MAX_BUTTON_CHECKS (50000UL * CHECKS_CLOCK_SCALE)
+#define NUM_DISPLAY_CHECKS (10000UL * CHECKS_CLOCK_SCALE)
+#define KEY_DEBOUNCE_DELAY CLOCK_MS_CYCLES(10)
 #define NUM_DISPLAY_X_OFFSET 0
 #define NUM_DISPLAY_X_MOVE 25
 #define SPEEDUP_FACTOR 10 // Factor of reduction in time
@@ -31,6 +34,12 @@ enum State currState = WELCOME;
 int main(void) {
   WDTCTL = WDTPW | WDTHOLD;  // stop watchdog timer
 
+  // 25MHz MCLK/SMCLK and 32768Hz ACLK, before anything that uses them
+  Clock_Init();
+
+  // Enable global interrupts, the display DMA ISR sends frames in the background
+  _BIS_SR(GIE);
+
   // Init peripherals
   initLeds();
   initButtons();
@@ -43,29 +52,29 @@ int main(void) {
     switch (currState) {
       case WELCOME: {
         // Display SIMON on screen
-        displayCenteredText("SIMON");
+        displayScreen(&g_sScreenSimon);
 
-        // Wait for the * key to be pressed
-        while (!(getKey() == '*'))
-          ;
+        // Sleep until the * key is pressed
+        while (getKeyPress() != '*')
+          waitForEvent(EVENT_KEY);
 
         // Reset the seq length
         seqLen = 0;
 
         // Do a count down
         displayCenteredText("3");
-        __delay_cycles(COUNTDOWN_DELAY);
+        sleepMillis(COUNTDOWN_DELAY_MS);
         displayCenteredText("2");
-        __delay_cycles(COUNTDOWN_DELAY);
+        sleepMillis(COUNTDOWN_DELAY_MS);
         displayCenteredText("1");
-        __delay_cycles(COUNTDOWN_DELAY);
+        sleepMillis(COUNTDOWN_DELAY_MS);
 
         // Move to the playback state
         currState = PLAYBACK;
         break;
       }
       case PLAYBACK: {
-        displayCenteredTexts("Memorize", "the", "pattern");
+        displayScreen(&g_sScreenMemorize);
 
         // Generate a random number to add to the sequence
         numList[seqLen] = rand() % 4;
@@ -84,7 +93,7 @@ int main(void) {
         break;
       }
       case INPUT: {
-        displayCenteredTexts("Repeat", "the", "pattern");
+        displayScreen(&g_sScreenRepeat);
 
         // Watch for input
         uint8_t currIndex = 0;
@@ -94,7 +103,7 @@ int main(void) {
         for (currIndex = 0; currIndex < seqLen; currIndex++) {
           while (currState == INPUT) {
               // Check if the game needs restarted
-              if (getKey() == '#') {
+              if (getKeyPress() == '#') {
                  currState = WELCOME;
                  break;
               }
@@ -109,23 +118,23 @@ int main(void) {
                 Graphics_clearDisplay(&g_sContext);
                 switch(buttonToNum(pressed)) {
                     case 1: {
-                        Graphics_drawStringCentered(&g_sContext, "1", AUTO_STRING_LENGTH,
-                                                    NUM_DISPLAY_X_OFFSET, 15, TRANSPARENT_TEXT);
+                        Sharp96x96_DrawStringCentered(&g_sContext, "1", AUTO_STRING_LENGTH,
+                                                      NUM_DISPLAY_X_OFFSET, 15, TRANSPARENT_TEXT);
                         break;
                     }
                     case 2: {
-                        Graphics_drawStringCentered(&g_sContext, "2", AUTO_STRING_LENGTH,
-                                                    NUM_DISPLAY_X_OFFSET + NUM_DISPLAY_X_MOVE, 15, TRANSPARENT_TEXT);
+                        Sharp96x96_DrawStringCentered(&g_sContext, "2", AUTO_STRING_LENGTH,
+                                                      NUM_DISPLAY_X_OFFSET + NUM_DISPLAY_X_MOVE, 15, TRANSPARENT_TEXT);
                         break;
                     }
                     case 3: {
-                        Graphics_drawStringCentered(&g_sContext, "3", AUTO_STRING_LENGTH,
-                                                    NUM_DISPLAY_X_OFFSET + NUM_DISPLAY_X_MOVE*2, 15, TRANSPARENT_TEXT);
+                        Sharp96x96_DrawStringCentered(&g_sContext, "3", AUTO_STRING_LENGTH,
+                                                      NUM_DISPLAY_X_OFFSET + NUM_DISPLAY_X_MOVE*2, 15, TRANSPARENT_TEXT);
                         break;
                     }
                     case 4: {
-                        Graphics_drawStringCentered(&g_sContext, "4", AUTO_STRING_LENGTH,
-                                                    NUM_DISPLAY_X_OFFSET + NUM_DISPLAY_X_MOVE*3, 15, TRANSPARENT_TEXT);
+                        Sharp96x96_DrawStringCentered(&g_sContext, "4", AUTO_STRING_LENGTH,
+                                                      NUM_DISPLAY_X_OFFSET + NUM_DISPLAY_X_MOVE*3, 15, TRANSPARENT_TEXT);
                         break;
                     }
                 }
@@ -289,6 +298,16 @@ void clearDisplay() {
     Graphics_flushBuffer(&g_sContext);
 }
 
+/**
+ * @brief Displays a screen pre-rasterized by tools/prerender_screens.c
+ *
+ * @param screen The screen to display
+ */
+void displayScreen(const Sharp96x96_Screen* screen) {
+  Sharp96x96_DrawScreen(screen);
+  Graphics_flushBuffer(&g_sContext);
+}
+
 /**
  * @brief Displays the given string in the center of the screen
  *
@@ -296,8 +315,8 @@ void clearDisplay() {
  */
 void displayCenteredText(uint8_t* string) {
   Graphics_clearDisplay(&g_sContext);
-  Graphics_drawStringCentered(&g_sContext, string, AUTO_STRING_LENGTH, 48, 15,
-                              TRANSPARENT_TEXT);
+  Sharp96x96_DrawStringCentered(&g_sContext, string, AUTO_STRING_LENGTH, 48, 15,
+                                TRANSPARENT_TEXT);
   Graphics_flushBuffer(&g_sContext);
 }
 
@@ -310,12 +329,12 @@ void displayCenteredText(uint8_t* string) {
  */
 void displayCenteredTexts(uint8_t* string1, uint8_t* string2, uint8_t* string3) {
   Graphics_clearDisplay(&g_sContext);
-  Graphics_drawStringCentered(&g_sContext, string1, AUTO_STRING_LENGTH, 48, 15,
-                              TRANSPARENT_TEXT);
-  Graphics_drawStringCentered(&g_sContext, string2, AUTO_STRING_LENGTH, 48, 30,
-                              TRANSPARENT_TEXT);
-  Graphics_drawStringCentered(&g_sContext, string3, AUTO_STRING_LENGTH, 48, 45,
-                              TRANSPARENT_TEXT);
+  Sharp96x96_DrawStringCentered(&g_sContext, string1, AUTO_STRING_LENGTH, 48, 15,
+                                TRANSPARENT_TEXT);
+  Sharp96x96_DrawStringCentered(&g_sContext, string2, AUTO_STRING_LENGTH, 48, 30,
+                                TRANSPARENT_TEXT);
+  Sharp96x96_DrawStringCentered(&g_sContext, string3, AUTO_STRING_LENGTH, 48, 45,
+                                TRANSPARENT_TEXT);
   Graphics_flushBuffer(&g_sContext);
 }
 
@@ -325,9 +344,9 @@ void displayCenteredTexts(uint8_t* string1, uint8_t* string2, uint8_t* string3)
  */
 void lose() {
   // Display the losing message
-  displayCenteredText("You lose!");
+  displayScreen(&g_sScreenYouLose);
   buzzerSound(0);
-  __delay_cycles(LOSE_DELAY);
+  sleepMillis(LOSE_DELAY_MS);
   BuzzerOff();
 
   // Move to the welcome screen
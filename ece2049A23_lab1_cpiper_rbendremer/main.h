@@ -8,6 +8,7 @@ void buzzerSound(uint8_t num);
 uint8_t getPressedButtons();
 void waitForRestart();
 void clearDisplay();
+void displayScreen(const Sharp96x96_Screen* screen);
 void displayCenteredText(uint8_t* string);
 void displayCenteredTexts(uint8_t* string1, uint8_t* string2, uint8_t* string3);
 void lose();
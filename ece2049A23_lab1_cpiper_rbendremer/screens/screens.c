@@ -0,0 +1,133 @@
+//*****************************************************************************
+//
+// Generated by tools/prerender_screens.c, do not edit.
+//
+//*****************************************************************************
+
+#include <stdint.h>
+#include "grlib.h"
+#include "LcdDriver/Sharp96x96.h"
+
+#include "screens/screens.h"
+
+static const uint8_t g_pucScreenSimonData[] =
+{
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x98, 0xff, 0x01, 0xf0, 0x1f, 0x8a,
+    0xff, 0x00, 0x7f, 0x89, 0xff, 0x00, 0xfe, 0x8a, 0xff, 0x00, 0xfd, 0x8a,
+    0xff, 0x01, 0xf0, 0x1f, 0x95, 0xff, 0x01, 0xf8, 0x3f, 0x89, 0xff, 0x01,
+    0xf7, 0xdf, 0x89, 0xff, 0x01, 0xf7, 0xdf, 0x89, 0xff, 0x01, 0xf7, 0xdf,
+    0x89, 0xff, 0x01, 0xf8, 0x3f, 0x95, 0xff, 0x01, 0xf0, 0x1f, 0x89, 0xff,
+    0x00, 0xfb, 0x8a, 0xff, 0x00, 0xfc, 0x8a, 0xff, 0x00, 0xfb, 0x8a, 0xff,
+    0x01, 0xf0, 0x1f, 0xa1, 0xff, 0x01, 0xf7, 0xdf, 0x89, 0xff, 0x01, 0xf0,
+    0x1f, 0x89, 0xff, 0x01, 0xf7, 0xdf, 0xa1, 0xff, 0x01, 0xf7, 0x3f, 0x89,
+    0xff, 0x01, 0xf6, 0xdf, 0x89, 0xff, 0x01, 0xf6, 0xdf, 0x89, 0xff, 0x01,
+    0xf6, 0xdf, 0x89, 0xff, 0x01, 0xf9, 0xdf, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0x94, 0xff,
+};
+
+const Sharp96x96_Screen g_sScreenSimon =
+{
+    123,
+    g_pucScreenSimonData
+};
+
+static const uint8_t g_pucScreenMemorizeData[] =
+{
+    0xff, 0xff, 0xff, 0xff, 0xac, 0xff, 0x01, 0xfe, 0x7f, 0x89, 0xff, 0x01,
+    0xfd, 0x5f, 0x89, 0xff, 0x01, 0xfd, 0x5f, 0x89, 0xff, 0x01, 0xfd, 0x5f,
+    0x81, 0xff, 0x01, 0xf8, 0x7f, 0x85, 0xff, 0x01, 0xfe, 0x3f, 0x81, 0xff,
+    0x00, 0xf7, 0x8a, 0xff, 0x00, 0xf7, 0x86, 0xff, 0x01, 0xfd, 0xdf, 0x81,
+    0xff, 0x00, 0xfb, 0x86, 0xff, 0x01, 0xfc, 0xdf, 0x81, 0xff, 0x01, 0xf0,
+    0x7f, 0x85, 0xff, 0x01, 0xfd, 0x5f, 0x89, 0xff, 0x01, 0xfd, 0x9f, 0x81,
+    0xff, 0x00, 0xfb, 0x86, 0xff, 0x01, 0xfd, 0xdf, 0x81, 0xff, 0x00, 0xf7,
+    0x8a, 0xff, 0x00, 0xf7, 0x8a, 0xff, 0x00, 0xfb, 0x87, 0xff, 0x00, 0xdf,
+    0x81, 0xff, 0x01, 0xf0, 0x7f, 0x85, 0xff, 0x01, 0xf4, 0x1f, 0x89, 0xff,
+    0x04, 0xfd, 0xdf, 0xfc, 0xff, 0xf9, 0x88, 0xff, 0x03, 0xfa, 0xbf, 0xf5,
+    0x7f, 0x87, 0xff, 0x03, 0xfa, 0xbf, 0xf5, 0x7f, 0x85, 0xff, 0x05, 0xfe,
+    0xff, 0xfa, 0xbf, 0xf5, 0x7f, 0x85, 0xff, 0x04, 0xfd, 0xff, 0xfc, 0x7f,
+    0xf8, 0x86, 0xff, 0x00, 0xfd, 0x8a, 0xff, 0x04, 0xfe, 0xff, 0xfc, 0x3f,
+    0xfe, 0x86, 0xff, 0x02, 0xfc, 0x1f, 0xfb, 0x81, 0xff, 0x00, 0x7f, 0x87,
+    0xff, 0x03, 0xfb, 0xff, 0xf7, 0x7f, 0x85, 0xff, 0x04, 0xfe, 0x3f, 0xfd,
+    0xff, 0xc0, 0x86, 0xff, 0x04, 0xfd, 0xdf, 0xe0, 0x3f, 0xf7, 0x86, 0xff,
+    0x01, 0xfd, 0xdf, 0x89, 0xff, 0x04, 0xfd, 0xdf, 0xff, 0x7f, 0xfe, 0x86,
+    0xff, 0x05, 0xfe, 0x3f, 0xff, 0xbf, 0xff, 0x7f, 0x87, 0xff, 0x03, 0xfb,
+    0xbf, 0xf7, 0x7f, 0x85, 0xff, 0x04, 0xfe, 0x1f, 0xe0, 0x7f, 0xc0, 0x86,
+    0xff, 0x04, 0xfd, 0xff, 0xfb, 0xff, 0xf7, 0x86, 0xff, 0x01, 0xfe, 0x7f,
+    0x89, 0xff, 0x00, 0xfd, 0x82, 0xff, 0x01, 0xf8, 0x7f, 0x85, 0xff, 0x01,
+    0xfc, 0x1f, 0x81, 0xff, 0x01, 0xf5, 0x7f, 0x89, 0xff, 0x01, 0xf5, 0x7f,
+    0x85, 0xff, 0x01, 0xfe, 0x7f, 0x81, 0xff, 0x01, 0xf5, 0x7f, 0x85, 0xff,
+    0x01, 0xfd, 0x5f, 0x81, 0xff, 0x00, 0xfe, 0x86, 0xff, 0x01, 0xfd, 0x5f,
+    0x89, 0xff, 0x01, 0xfd, 0x5f, 0x81, 0xff, 0x00, 0xfb, 0x86, 0xff, 0x01,
+    0xfe, 0x3f, 0x81, 0xff, 0x00, 0xf5, 0x8a, 0xff, 0x00, 0xf5, 0x86, 0xff,
+    0x01, 0xf0, 0x1f, 0x81, 0xff, 0x00, 0xf5, 0x86, 0xff, 0x00, 0xfb, 0x82,
+    0xff, 0x01, 0xf0, 0x7f, 0x85, 0xff, 0x00, 0xfc, 0x8a, 0xff, 0x00, 0xfb,
+    0x8a, 0xff, 0x01, 0xf0, 0x1f, 0xff, 0xff, 0xff, 0xff, 0xa8, 0xff,
+};
+
+const Sharp96x96_Screen g_sScreenMemorize =
+{
+    347,
+    g_pucScreenMemorizeData
+};
+
+static const uint8_t g_pucScreenRepeatData[] =
+{
+    0xff, 0xff, 0xff, 0xff, 0xd4, 0xff, 0x01, 0xf8, 0x7f, 0x89, 0xff, 0x00,
+    0xf7, 0x8a, 0xff, 0x00, 0xf7, 0x87, 0xff, 0x00, 0xbf, 0x81, 0xff, 0x00,
+    0xfb, 0x87, 0xff, 0x00, 0xdf, 0x81, 0xff, 0x01, 0xf0, 0x7f, 0x85, 0xff,
+    0x01, 0xfd, 0xdf, 0x89, 0xff, 0x01, 0xf0, 0x3f, 0x81, 0xff, 0x00, 0xfb,
+    0x86, 0xff, 0x00, 0xfd, 0x82, 0xff, 0x00, 0xf7, 0x8a, 0xff, 0x00, 0xf7,
+    0x86, 0xff, 0x01, 0xfe, 0x1f, 0x81, 0xff, 0x00, 0xfb, 0x86, 0xff, 0x01,
+    0xfd, 0x5f, 0x81, 0xff, 0x01, 0xf0, 0x7f, 0x85, 0xff, 0x01, 0xfd, 0x5f,
+    0x89, 0xff, 0x04, 0xfd, 0x5f, 0xfc, 0xff, 0xf9, 0x87, 0xff, 0x04, 0xbf,
+    0xfa, 0xbf, 0xf5, 0x7f, 0x87, 0xff, 0x03, 0xfa, 0xbf, 0xf5, 0x7f, 0x85,
+    0xff, 0x05, 0xfe, 0x7f, 0xfa, 0xbf, 0xf5, 0x7f, 0x85, 0xff, 0x04, 0xfd,
+    0x5f, 0xfc, 0x7f, 0xf8, 0x86, 0xff, 0x01, 0xfd, 0x5f, 0x89, 0xff, 0x04,
+    0xfd, 0x5f, 0xfc, 0x3f, 0xfe, 0x86, 0xff, 0x02, 0xfe, 0x3f, 0xfb, 0x81,
+    0xff, 0x00, 0x7f, 0x87, 0xff, 0x03, 0xfb, 0xff, 0xf7, 0x7f, 0x85, 0xff,
+    0x04, 0xfe, 0xff, 0xfd, 0xff, 0xc0, 0x86, 0xff, 0x04, 0xfd, 0x7f, 0xe0,
+    0x3f, 0xf7, 0x86, 0xff, 0x01, 0xfd, 0x7f, 0x89, 0xff, 0x04, 0xfd, 0x7f,
+    0xff, 0x7f, 0xfe, 0x86, 0xff, 0x05, 0xfc, 0x1f, 0xff, 0xbf, 0xff, 0x7f,
+    0x87, 0xff, 0x03, 0xfb, 0xbf, 0xf7, 0x7f, 0x85, 0xff, 0x04, 0xfe, 0x7f,
+    0xe0, 0x7f, 0xc0, 0x86, 0xff, 0x04, 0xfd, 0x5f, 0xfb, 0xff, 0xf7, 0x86,
+    0xff, 0x01, 0xfd, 0x5f, 0x89, 0xff, 0x01, 0xfd, 0x5f, 0x81, 0xff, 0x01,
+    0xf8, 0x7f, 0x85, 0xff, 0x01, 0xfe, 0x3f, 0x81, 0xff, 0x01, 0xf5, 0x7f,
+    0x89, 0xff, 0x01, 0xf5, 0x7f, 0x85, 0xff, 0x01, 0xf9, 0xdf, 0x81, 0xff,
+    0x01, 0xf5, 0x7f, 0x85, 0xff, 0x01, 0xf6, 0xbf, 0x81, 0xff, 0x00, 0xfe,
+    0x86, 0xff, 0x01, 0xf6, 0x7f, 0x89, 0xff, 0x00, 0xf6, 0x82, 0xff, 0x00,
+    0xfb, 0x86, 0xff, 0x01, 0xf0, 0x1f, 0x81, 0xff, 0x00, 0xf5, 0x8a, 0xff,
+    0x00, 0xf5, 0x8a, 0xff, 0x00, 0xf5, 0x8a, 0xff, 0x01, 0xf0, 0x7f, 0xff,
+    0xff, 0xff, 0xff, 0xc8, 0xff,
+};
+
+const Sharp96x96_Screen g_sScreenRepeat =
+{
+    305,
+    g_pucScreenRepeatData
+};
+
+static const uint8_t g_pucScreenYouLoseData[] =
+{
+    0xff, 0xff, 0xff, 0xff, 0xa0, 0xff, 0x01, 0xf0, 0xdf, 0xad, 0xff, 0x01,
+    0xfe, 0x7f, 0x89, 0xff, 0x01, 0xfd, 0x5f, 0x89, 0xff, 0x01, 0xfd, 0x5f,
+    0x89, 0xff, 0x01, 0xfd, 0x5f, 0x89, 0xff, 0x01, 0xfe, 0x3f, 0x96, 0xff,
+    0x00, 0xbf, 0x89, 0xff, 0x01, 0xfd, 0x5f, 0x89, 0xff, 0x01, 0xfd, 0x5f,
+    0x89, 0xff, 0x01, 0xfd, 0x5f, 0x89, 0xff, 0x01, 0xfe, 0xdf, 0x95, 0xff,
+    0x01, 0xfe, 0x3f, 0x89, 0xff, 0x01, 0xfd, 0xdf, 0x89, 0xff, 0x01, 0xfd,
+    0xdf, 0x89, 0xff, 0x01, 0xfd, 0xdf, 0x89, 0xff, 0x01, 0xfe, 0x3f, 0xa2,
+    0xff, 0x00, 0xdf, 0x89, 0xff, 0x01, 0xf0, 0x1f, 0x89, 0xff, 0x01, 0xf7,
+    0xdf, 0xe9, 0xff, 0x01, 0xfc, 0x1f, 0x8a, 0xff, 0x00, 0xbf, 0x8a, 0xff,
+    0x00, 0xdf, 0x8a, 0xff, 0x00, 0xdf, 0x89, 0xff, 0x01, 0xfc, 0x3f, 0x95,
+    0xff, 0x01, 0xfe, 0x3f, 0x89, 0xff, 0x01, 0xfd, 0xdf, 0x89, 0xff, 0x01,
+    0xfd, 0xdf, 0x89, 0xff, 0x01, 0xfd, 0xdf, 0x89, 0xff, 0x01, 0xfe, 0x3f,
+    0x95, 0xff, 0x00, 0xf1, 0x8a, 0xff, 0x00, 0xfe, 0x8b, 0xff, 0x00, 0x1f,
+    0x89, 0xff, 0x00, 0xfe, 0x8a, 0xff, 0x00, 0xf1, 0xff, 0xff, 0xff, 0xff,
+    0x85, 0xff,
+};
+
+const Sharp96x96_Screen g_sScreenYouLose =
+{
+    170,
+    g_pucScreenYouLoseData
+};
+
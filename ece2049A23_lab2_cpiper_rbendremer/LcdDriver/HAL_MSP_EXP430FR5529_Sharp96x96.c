@@ -49,6 +49,67 @@
 #endif
 
 #include "HAL_MSP_EXP430FR5529_Sharp96x96.h"
+#include "Sharp96x96.h"
+
+#ifdef SHARED_SPI_BUS
+#ifdef USE_DRIVERLIB
+#error "SHARED_SPI_BUS drives the UCB0 registers directly and cannot be used with USE_DRIVERLIB"
+#endif
+
+// The LCD on the shared bus: chip select high, data captured on the first
+// edge, MSB first. AssertCS(), DeassertCS() and the DMA flush engine drive its
+// chip select, the bus only ever configures the USCI for it.
+const tSpiBusDevice g_sLcdSpiDevice =
+{
+	0, PIN_CS, true, UCCKPH|UCMSB, SPI_CLK_TICKS
+};
+#endif
+
+#ifdef USE_DMA_FLUSH
+//*****************************************************************************
+//
+// States of the DMA flush engine. A frame is sent as a chain of DMA blocks:
+// the command byte and first line address, then for every line its data bytes
+// followed by its trailer and the address of the next line, and finally the
+// last line trailer and the frame trailer.
+//
+// A wire format block is sent whole, or with SHARED_SPI_BUS one line at a
+// time. With SHARED_SPI_BUS a frame pauses after a line when a transaction is
+// waiting for the bus: the frame trailer closes the transaction and the bus is
+// released. The frame waits for the bus to be granted back once the queue has
+// been sent, and resumes with its command byte. A frame also waits for the bus
+// before it starts.
+//
+// Neither ISR waits for the USCI. Once the last block of a transaction has
+// been moved, the TAIL and PAUSE states wait for the LCD_TIMER_CCR compare,
+// which releases CS.
+//
+//*****************************************************************************
+#define DMA_STATE_IDLE		0	// No frame in flight, CS is deasserted
+#define DMA_STATE_ADDRESS	1	// A command or trailer plus line address is going out
+#define DMA_STATE_DATA		2	// The data bytes of DmaLine are going out
+#define DMA_STATE_TAIL		3	// The last trailer bytes are going out, or CS is due to be released
+#define DMA_STATE_BLOCK		4	// A line of a wire format block is going out
+#define DMA_STATE_PAUSE		5	// The trailer closing a paused frame is going out, or CS is due to be released
+#define DMA_STATE_RESUME	6	// The command byte starting or resuming a block is going out
+#define DMA_STATE_WAIT		7	// Waiting for the bus to start or resume the frame
+
+// DMA0TSEL value of the UCB0TXIFG trigger on the MSP430F5529
+#define DMA_TRIGGER_UCB0TX	DMA0TSEL_19
+
+static volatile uint8_t DmaState = DMA_STATE_IDLE;
+static const uint8_t *DmaBuffer;
+static uint8_t DmaFirstLine;
+static uint16_t *DmaLines;
+static uint8_t DmaLine;
+static uint8_t DmaPrefix[2];
+static void (*DmaDone)(void);
+#ifdef SHARED_SPI_BUS
+static uint8_t DmaCommand;
+static const uint8_t *DmaBlock;
+static uint16_t DmaBlockLeft;
+#endif
+#endif
 
 //*****************************************************************************
 //
@@ -97,8 +158,8 @@ void Sharp96x96_Init(void)
 	// Configure the SPI interface on USCI B0
     USCI_B_SPI_masterInit(USCI_B0_BASE,
                     USCI_B_SPI_CLOCKSOURCE_SMCLK,
-					8000000,
-                    1000000,
+					CLOCK_SMCLK_HZ,
+                    LCD_SPI_CLK_HZ,
                     USCI_B_SPI_MSB_FIRST,
                     USCI_B_SPI_PHASE_DATA_CAPTURED_ONFIRST_CHANGED_ON_NEXT,
                     USCI_B_SPI_CLOCKPOLARITY_INACTIVITY_LOW);
@@ -138,7 +199,7 @@ void Sharp96x96_Init(void)
 
 	SPI_REG_CTL1 |= SPI_CLK_SRC; // Select SMCLK for our clock source
 
-	// Set SPI clock frequency (which is the same frequency as SMCLK so this can apparently be 0)
+	// Set SPI clock frequency, SMCLK divided down to LCD_SPI_CLK_HZ
 	SPI_REG_BRL  =  ((uint16_t)SPI_CLK_TICKS) & 0xFF;         // Load the low byte
 	SPI_REG_BRH  = (((uint16_t)SPI_CLK_TICKS) >> 8) & 0xFF;	  // Load the high byte
 
@@ -150,7 +211,447 @@ void Sharp96x96_Init(void)
 	SPI_REG_CTL1 &= ~UCSWRST;
 	SPI_REG_IFG  &= ~UCRXIFG;
 #endif
+
+#ifdef USE_DMA_FLUSH
+	// Move one byte into the SPI TX buffer on every UCB0TXIFG rising edge
+	DMACTL0 = (DMACTL0 & 0xFF00) | DMA_TRIGGER_UCB0TX;
+	__data16_write_addr((unsigned short)&DMA0DA, (unsigned long)&SPI_REG_TXBUF);
+	DMA0CTL = DMADT_0 | DMASRCINCR_3 | DMADSTINCR_0 | DMASBDB | DMAIE;
+
+	// Free running, for the compare that releases CS
+	LCD_TIMER_CCTL = 0;
+	LCD_TIMER_CTL = TASSEL__SMCLK | MC__CONTINUOUS | TACLR;
+#endif
+}
+
+#ifdef USE_DMA_FLUSH
+//*****************************************************************************
+//
+//! Starts a DMA block towards the SPI TX buffer.
+//!
+//! \param pucSrc is a pointer to the first byte of the block.
+//! \param uiSize is the number of bytes in the block.
+//!
+//! The DMA is triggered by the rising edge of UCTXIFG. When the block is
+//! chained from the DMA ISR, the last byte of the previous block is usually
+//! still waiting in TXBUF, and the edge made when the USCI takes it starts the
+//! block. Otherwise, with the bus idle or the ISR late, the edge has already
+//! happened and the flag is cleared and set again to recreate it.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void Sharp96x96_DmaStartBlock(const uint8_t *pucSrc, uint16_t uiSize)
+{
+	__data16_write_addr((unsigned short)&DMA0SA, (unsigned long)pucSrc);
+	DMA0SZ = uiSize;
+	DMA0CTL |= DMAEN;
+
+	// UCTXIFG set with no byte moved yet: there is no edge left to come. Only
+	// a write to TXBUF clears the flag, so it cannot rise in between.
+	if((SPI_REG_IFG & UCTXIFG) && (DMA0CTL & DMAEN) && (DMA0SZ == uiSize))
+	{
+		SPI_REG_IFG &= ~UCTXIFG;
+		SPI_REG_IFG |= UCTXIFG;
+	}
+}
+
+//*****************************************************************************
+//
+//! Sets the timer compare that releases CS at the end of a transaction.
+//!
+//! Called from the DMA ISR once the last byte has been moved to TXBUF, when
+//! that byte and at most one before it are still to be clocked out.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void Sharp96x96_DmaCloseLater(void)
+{
+	LCD_TIMER_CCR = LCD_TIMER_R + 2*LCD_BYTE_TICKS + LCD_THSCS_TICKS;
+	LCD_TIMER_CCTL = CCIE;
+}
+
+//*****************************************************************************
+//
+//! Takes the next line to send from the line bitmap.
+//!
+//! \return Returns the lowest line still set in the bitmap, which is cleared,
+//! or -1 once every line has been sent.
+//
+//*****************************************************************************
+static int16_t Sharp96x96_DmaNextLine(void)
+{
+	uint16_t wi;
+	uint16_t bits;
+	uint8_t line;
+
+	for(wi=0; wi<SHARP_LINE_BITMAP_WORDS; wi++)
+	{
+		bits = DmaLines[wi];
+
+		if(bits)
+		{
+			for(line = wi << 4; !(bits & 0x1); line++)
+			{
+				bits >>= 1;
+			}
+
+			DmaLines[wi] &= ~(1u << (line & 0xF));
+			return line;
+		}
+	}
+
+	return -1;
+}
+
+#ifdef SHARED_SPI_BUS
+//*****************************************************************************
+//
+//! Starts the next piece of the wire format block being sent.
+//!
+//! \param uiSize is the largest number of bytes to send.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void Sharp96x96_DmaNextChunk(uint16_t uiSize)
+{
+	const uint8_t *pucChunk = DmaBlock;
+
+	if(uiSize > DmaBlockLeft)
+	{
+		uiSize = DmaBlockLeft;
+	}
+
+	DmaBlock += uiSize;
+	DmaBlockLeft -= uiSize;
+	DmaState = DmaBlockLeft ? DMA_STATE_BLOCK : DMA_STATE_TAIL;
+
+	Sharp96x96_DmaStartBlock(pucChunk, uiSize);
+}
+
+//*****************************************************************************
+//
+//! Closes the frame being sent after a whole line, so that the transactions
+//! waiting for the bus go out before the rest of it.
+//!
+//! \param uiSize is the number of trailer bytes still to send, 1 when the
+//! line trailer has been sent and 2 when it has not.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void Sharp96x96_DmaPause(uint16_t uiSize)
+{
+	DmaPrefix[0] = SHARP_LCD_TRAILER_BYTE;
+	DmaPrefix[1] = SHARP_LCD_TRAILER_BYTE;
+	DmaState = DMA_STATE_PAUSE;
+
+	Sharp96x96_DmaStartBlock(DmaPrefix, uiSize);
+}
+
+//*****************************************************************************
+//
+//! Starts or resumes the frame once the bus has been granted.
+//!
+//! Called by the bus manager, from SpiBus_Request() or USCI_B0_ISR, with the
+//! USCI set up for the LCD. The frame goes on with its command byte, followed
+//! by the address of DmaLine or the rest of the block.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void Sharp96x96_DmaGranted(void)
+{
+	// The bus is already held, so not AssertCS()
+	PORT_CS_OUT |= PIN_CS;
+
+	DmaPrefix[0] = DmaCommand;
+
+	if(DmaBlock)
+	{
+		DmaState = DMA_STATE_RESUME;
+
+		Sharp96x96_DmaStartBlock(DmaPrefix, 1);
+	}
+	else
+	{
+		DmaPrefix[1] = reverse(DmaLine + 1);
+		DmaState = DMA_STATE_ADDRESS;
+
+		Sharp96x96_DmaStartBlock(DmaPrefix, 2);
+	}
+}
+#endif
+
+//*****************************************************************************
+//
+//! Sends a multiple line write to the LCD with DMA.
+//!
+//! \param ucCommand is the write line command byte, including the VCOM bit.
+//! \param pucBuffer is a pointer to line 0 of the buffer to send.
+//! \param ucFirstLine is the line of the buffer holding LCD line 0. The buffer
+//! is a ring, LCD line y being held by buffer line ucFirstLine + y modulo
+//! LCD_VERTICAL_MAX.
+//! \param puiLines is a bitmap of the lines to send, with at least one line
+//! set. The engine clears the bits as it goes, so the bitmap and the buffer
+//! must not be touched until Sharp96x96_DmaBusy() returns false.
+//! \param pfnDone is called from the DMA ISR once CS has been released, or is
+//! NULL.
+//!
+//! This function asserts CS, starts the first DMA block and returns. The DMA
+//! ISR chains the remaining blocks and releases CS at the end of the frame.
+//! With SHARED_SPI_BUS the frame starts once the bus is granted, which may be
+//! after this returns.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void Sharp96x96_DmaSendLines(uint8_t ucCommand, const uint8_t *pucBuffer,
+                             uint8_t ucFirstLine, uint16_t *puiLines,
+                             void (*pfnDone)(void))
+{
+	DmaBuffer = pucBuffer;
+	DmaFirstLine = ucFirstLine;
+	DmaDone = pfnDone;
+	DmaLines = puiLines;
+	DmaLine = Sharp96x96_DmaNextLine();
+
+#ifdef SHARED_SPI_BUS
+	DmaCommand = ucCommand;
+	DmaBlock = 0;
+	DmaState = DMA_STATE_WAIT;
+
+	SpiBus_Request(&g_sLcdSpiDevice, Sharp96x96_DmaGranted);
+#else
+	DmaPrefix[0] = ucCommand;
+	DmaPrefix[1] = reverse(DmaLine + 1);
+	DmaState = DMA_STATE_ADDRESS;
+
+	AssertCS();
+
+	Sharp96x96_DmaStartBlock(DmaPrefix, 2);
+#endif
+}
+
+//*****************************************************************************
+//
+//! Sends a complete transaction, already in wire format, to the LCD with DMA.
+//!
+//! \param pucBlock is a pointer to the first byte of the transaction.
+//! \param uiSize is the number of bytes in the transaction.
+//! \param pfnDone is called from the DMA ISR once CS has been released, or is
+//! NULL.
+//!
+//! The block must not be touched until Sharp96x96_DmaBusy() returns false.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void Sharp96x96_DmaSendBlock(const uint8_t *pucBlock, uint16_t uiSize,
+                             void (*pfnDone)(void))
+{
+	DmaDone = pfnDone;
+
+#ifdef SHARED_SPI_BUS
+	// The command byte, then one line at a time
+	DmaCommand = pucBlock[0];
+	DmaBlock = pucBlock + 1;
+	DmaBlockLeft = uiSize - 1;
+	DmaState = DMA_STATE_WAIT;
+
+	SpiBus_Request(&g_sLcdSpiDevice, Sharp96x96_DmaGranted);
+#else
+	// Nothing to chain, the next DMA interrupt closes the transaction
+	DmaState = DMA_STATE_TAIL;
+
+	AssertCS();
+
+	Sharp96x96_DmaStartBlock(pucBlock, uiSize);
+#endif
+}
+
+//*****************************************************************************
+//
+//! Checks whether a DMA frame is in flight.
+//!
+//! \return Returns true until the DMA ISR has released CS.
+//
+//*****************************************************************************
+bool Sharp96x96_DmaBusy(void)
+{
+	return (DmaState != DMA_STATE_IDLE);
+}
+
+//*****************************************************************************
+//
+//! Waits for the DMA frame in flight, if any, to complete.
+//!
+//! The CPU sleeps in LPM0 until the DMA ISR wakes it up. Interrupts are
+//! enabled while sleeping and the caller's interrupt state is restored.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void Sharp96x96_DmaWaitIdle(void)
+{
+	unsigned short state = __get_interrupt_state();
+
+	__disable_interrupt();
+
+	while(DmaState != DMA_STATE_IDLE)
+	{
+		// Enabling GIE and sleeping is one instruction, so the DMA ISR cannot
+		// complete between the check and LPM0 entry
+		__bis_SR_register(LPM0_bits | GIE);
+		__disable_interrupt();
+	}
+
+	__set_interrupt_state(state);
+}
+
+//------------------------------------------------------------------------------
+// DMA Interrupt Service Routine
+//------------------------------------------------------------------------------
+#pragma vector=DMA_VECTOR
+__interrupt void DMA_ISR(void)
+{
+	int16_t line;
+
+	switch(__even_in_range(DMAIV, 16))
+	{
+	case DMAIV_DMA0IFG:
+		switch(DmaState)
+		{
+		case DMA_STATE_ADDRESS:
+			DmaState = DMA_STATE_DATA;
+
+			line = DmaLine + DmaFirstLine;
+
+			if(line >= LCD_VERTICAL_MAX)
+			{
+				line -= LCD_VERTICAL_MAX;
+			}
+
+			Sharp96x96_DmaStartBlock(DmaBuffer + line * (LCD_HORIZONTAL_MAX>>3),
+			                         LCD_HORIZONTAL_MAX>>3);
+			break;
+
+		case DMA_STATE_DATA:
+			line = Sharp96x96_DmaNextLine();
+
+#ifdef SHARED_SPI_BUS
+			if((line >= 0) && SpiBus_Pending())
+			{
+				DmaLine = line;
+				Sharp96x96_DmaPause(2);
+				break;
+			}
+#endif
+
+			DmaPrefix[0] = SHARP_LCD_TRAILER_BYTE;
+
+			if(line >= 0)
+			{
+				DmaLine = line;
+				DmaPrefix[1] = reverse(DmaLine + 1);
+				DmaState = DMA_STATE_ADDRESS;
+			}
+			else
+			{
+				DmaPrefix[1] = SHARP_LCD_TRAILER_BYTE;
+				DmaState = DMA_STATE_TAIL;
+			}
+
+			Sharp96x96_DmaStartBlock(DmaPrefix, 2);
+			break;
+
+		case DMA_STATE_TAIL:
+#ifdef SHARED_SPI_BUS
+		case DMA_STATE_PAUSE:
+#endif
+			// The timer ISR releases CS once the last bytes are out
+			Sharp96x96_DmaCloseLater();
+			break;
+
+#ifdef SHARED_SPI_BUS
+		case DMA_STATE_BLOCK:
+			// The last byte left is the frame trailer
+			if((DmaBlockLeft > 1) && SpiBus_Pending())
+			{
+				Sharp96x96_DmaPause(1);
+			}
+			else
+			{
+				Sharp96x96_DmaNextChunk(SHARP_WIRE_LINE_BYTES);
+			}
+			break;
+
+		case DMA_STATE_RESUME:
+			// At least one line goes out before the next pause
+			Sharp96x96_DmaNextChunk(SHARP_WIRE_LINE_BYTES);
+			break;
+#endif
+
+		default:
+			break;
+		}
+		break;
+
+	default:
+		break;
+	}
+}
+
+//------------------------------------------------------------------------------
+// Timer A0 CCR0 Interrupt Service Routine, releases CS at the end of a DMA
+// transaction
+//------------------------------------------------------------------------------
+#pragma vector=TIMER0_A0_VECTOR
+__interrupt void TIMER0_A0_ISR(void)
+{
+	// Only if the USCI runs slower than SPI_CLK_TICKS
+	if(SPI_REG_STAT & UCBUSY)
+	{
+		LCD_TIMER_CCR += LCD_BYTE_TICKS + LCD_THSCS_TICKS;
+		return;
+	}
+
+	LCD_TIMER_CCTL = 0;
+
+	switch(DmaState)
+	{
+	case DMA_STATE_TAIL:
+		DeassertCS();
+
+		DmaState = DMA_STATE_IDLE;
+
+		if(DmaDone)
+		{
+			DmaDone();
+		}
+
+		__bic_SR_register_on_exit(LPM0_bits);
+		break;
+
+#ifdef SHARED_SPI_BUS
+	case DMA_STATE_PAUSE:
+		// Lets the waiting transactions go out, the frame resumes when the bus
+		// is granted back
+		DeassertCS();
+
+		DmaState = DMA_STATE_WAIT;
+
+		SpiBus_Request(&g_sLcdSpiDevice, Sharp96x96_DmaGranted);
+		break;
+#endif
+
+	default:
+		break;
+	}
 }
+#endif //USE_DMA_FLUSH
 
 //*****************************************************************************
 //
@@ -54,6 +54,8 @@
 #define __HAL_MSP_EXP430F5529_SHARPLCD_H__
 
 #include<msp430.h>
+#include "HAL_MSP_EXP430FR5529_Clock.h"
+#include "HAL_MSP_EXP430FR5529_SpiBus.h"
 
 #ifdef USE_DRIVERLIB
 #include "inc/hw_memmap.h"
@@ -76,6 +78,45 @@
 // Use TI's driver library for all GPIO, SPI, and Timer operations
 //#define USE_DRIVERLIB
 
+// Stream flushes to the LCD with DMA channel 0, triggered by UCB0TXIFG, instead
+// of polling UCTXIFG for every byte. The CPU sleeps in LPM0 while a frame is
+// being sent.
+#define USE_DMA_FLUSH
+
+// Keep a second copy of the DisplayBuffer for the DMA engine. A flush copies the
+// changed lines into it, starts the DMA frame and returns, so drawing into the
+// next frame goes on while the previous one is sent. Requires USE_DMA_FLUSH.
+#define DOUBLE_BUFFER
+
+// Store the DisplayBuffer in the LCD's multiple line write format, each line
+// holding its bit reversed address, its data bytes and its trailer. A flush is
+// then a single linear transfer of the changed range of lines.
+#define WIRE_FORMAT_BUFFER
+
+// Replace the DisplayBuffer with a display list of the drawing calls. A flush
+// rasterizes every changed line from the list just before sending it, so the
+// driver needs DISPLAY_LIST_BYTES of RAM instead of 1152 bytes. Drawing that
+// does not fit is dropped and counted by Sharp96x96_DisplayListDropped(). Needs
+// USE_DMA_FLUSH, DOUBLE_BUFFER and WIRE_FORMAT_BUFFER to be off.
+//#define DISPLAY_LIST
+#define DISPLAY_LIST_BYTES		128
+
+// Address the DisplayBuffer lines through a ring offset, so that
+// Sharp96x96_ScrollLines() scrolls the screen by moving the offset and
+// clearing the lines uncovered instead of moving every line. Flushes send the
+// lines to their remapped addresses. Cannot be used with DISPLAY_LIST.
+//#define SCROLL_BUFFER
+
+// Most flushes a second that Sharp96x96_ServiceFlush() issues. Flushes requested
+// with Sharp96x96_RequestFlush() in between are merged into the next one.
+#define FLUSH_MAX_RATE			30
+
+// Share UCB0 with the other SPI devices of the board through the bus manager of
+// HAL_MSP_EXP430FR5529_SpiBus.c. The LCD holds the bus between AssertCS() and
+// DeassertCS(), and a USE_DMA_FLUSH frame lets queued transactions, such as
+// DAC writes, through between two lines.
+#define SHARED_SPI_BUS
+
 
 //*****************************************************************************
 //
@@ -118,6 +159,8 @@
 #define SPI_REG_BRL		UCB0BR0
 #define SPI_REG_BRH		UCB0BR1
 #define SPI_REG_IFG		UCB0IFG
+#define SPI_REG_IE		UCB0IE
+#define SPI_REG_IV		UCB0IV
 #define SPI_REG_STAT	UCB0STAT
 #define SPI_REG_TXBUF	UCB0TXBUF
 #define SPI_REG_RXBUF	UCB0RXBUF
@@ -127,13 +170,35 @@
  * The actual clock frequency is given in number of
  * ticks of the specified clock source.
  *
- * For our configuration, we use the same frequency
- * as SMCLK, which is 1.25MHz.
+ * For our configuration, we use SMCLK divided down
+ * to the fastest clock the LCD takes, 1MHz.
  */
 #define SPI_CLK_SRC		(UCSSEL__SMCLK)
-#define SPI_CLK_TICKS	0
+#define LCD_SPI_CLK_HZ	1000000UL
+#define SPI_CLK_TICKS	CLOCK_SPI_DIV(LCD_SPI_CLK_HZ)
+
+/*
+ * Timer closing the DMA transactions
+ * Timer A0 runs from SMCLK in continuous mode. Once the DMA has moved the
+ * last byte of a transaction, its CCR0 interrupt is set for when that byte
+ * and the one before it have been clocked out and the LCD's 2us thSCS has
+ * passed, and releases CS there.
+ */
+#define LCD_TIMER_CTL		TA0CTL
+#define LCD_TIMER_R			TA0R
+#define LCD_TIMER_CCR		TA0CCR0
+#define LCD_TIMER_CCTL		TA0CCTL0
+#define LCD_BYTE_TICKS		(8 * SPI_CLK_TICKS)
+#define LCD_THSCS_TICKS		CLOCK_TICKS(CLOCK_SMCLK_HZ, 500000UL)
 
 // LCD Screen Dimensions
+//
+// The driver is sized by these two alone. Other Sharp memory LCDs on the same
+// interface:
+//   LS013B4DN04   96 x 96   (this board)
+//   LS013B7DH03  128 x 128
+//   LS027B7DH01  400 x 240  (about 12.5 KB of DisplayBuffer in wire format,
+//                            more RAM than the F5529 has without DISPLAY_LIST)
 #define LCD_VERTICAL_MAX                   96
 #define LCD_HORIZONTAL_MAX                 96
 
@@ -166,6 +231,13 @@
 //*****************************************************************************
 #ifdef USE_DRIVERLIB
 #define DeassertCS()  	GPIO_setOutputLowOnPin(LCD_SCS_PORT, LCD_SCS_PIN)
+#elif defined(SHARED_SPI_BUS)
+#define DeassertCS()								\
+	do												\
+	{												\
+		PORT_CS_OUT &= ~PIN_CS;						\
+		SpiBus_Release();							\
+	} while(0)
 #else
 #define DeassertCS()   PORT_CS_OUT &= ~PIN_CS
 #endif
@@ -183,6 +255,13 @@
 //*****************************************************************************
 #ifdef USE_DRIVERLIB
 #define AssertCS()    GPIO_setOutputHighOnPin(LCD_SCS_PORT, LCD_SCS_PIN)
+#elif defined(SHARED_SPI_BUS)
+#define AssertCS()									\
+	do												\
+	{												\
+		SpiBus_Acquire(&g_sLcdSpiDevice);			\
+		PORT_CS_OUT |= PIN_CS;						\
+	} while(0)
 #else
 #define AssertCS()    PORT_CS_OUT |= PIN_CS
 #endif
@@ -270,4 +349,16 @@
 //
 //*****************************************************************************
 extern void Sharp96x96_Init(void);
+#ifdef SHARED_SPI_BUS
+extern const tSpiBusDevice g_sLcdSpiDevice;
+#endif
+#ifdef USE_DMA_FLUSH
+extern void Sharp96x96_DmaSendLines(uint8_t ucCommand, const uint8_t *pucBuffer,
+                                    uint8_t ucFirstLine, uint16_t *puiLines,
+                                    void (*pfnDone)(void));
+extern void Sharp96x96_DmaSendBlock(const uint8_t *pucBlock, uint16_t uiSize,
+                                    void (*pfnDone)(void));
+extern bool Sharp96x96_DmaBusy(void);
+extern void Sharp96x96_DmaWaitIdle(void);
+#endif
 #endif // __HAL_MSP-EXP430F5529_SHARPLCD_H__
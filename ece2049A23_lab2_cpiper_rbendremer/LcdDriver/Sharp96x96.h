@@ -40,14 +40,17 @@
 #ifndef __SHARPLCD_H__
 #define __SHARPLCD_H__
 
+#include "HAL_MSP_EXP430FR5529_Clock.h"
+
 //*****************************************************************************
 //
 // User Configuration for the LCD Driver
 //
 //*****************************************************************************
 
-// SYSTEM_CLOCK_SPEED (in Hz) allows to properly closeout SPI communication
-#define SYSTEM_CLOCK_SPEED      8000000
+// SYSTEM_CLOCK_SPEED (in Hz) allows to properly closeout SPI communication.
+// It is the MCLK set up by Clock_Init().
+#define SYSTEM_CLOCK_SPEED      CLOCK_MCLK_HZ
 
 // Define LCD Screen Orientation Here
 #define LANDSCAPE
@@ -59,9 +62,6 @@
 #define SHARP_BLACK							0x00
 #define SHARP_WHITE							0xFF
 
-#define SHARP_SEND_TOGGLE_VCOM_COMMAND		0x01
-#define SHARP_SKIP_TOGGLE_VCOM_COMMAND 		0x00
-
 #define SHARP_LCD_TRAILER_BYTE				0x00
 
 #define SHARP_VCOM_TOGGLE_BIT 		   		0x40
@@ -70,6 +70,24 @@
 #define SHARP_LCD_CMD_CLEAR_SCREEN			0x20
 #define SHARP_LCD_CMD_WRITE_LINE			0x80
 
+// Number of 16 bit words in a bitmap holding one bit per LCD line
+#define SHARP_LINE_BITMAP_WORDS				((LCD_VERTICAL_MAX + 15) >> 4)
+
+// Wire format of a multiple line write: the command byte, then for every line
+// its address, data bytes and trailer, then the frame trailer. Line y starts at
+// byte 1 + y*SHARP_WIRE_LINE_BYTES, so its data bytes are 16 bit aligned.
+#define SHARP_WIRE_LINE_BYTES				((LCD_HORIZONTAL_MAX>>3) + 2)
+#define SHARP_WIRE_FRAME_BYTES				(LCD_VERTICAL_MAX*SHARP_WIRE_LINE_BYTES + 2)
+
+// Size of the screen as grlib sees it. With ROTATE_90 screen X runs down the
+// LCD lines and screen Y along each line.
+#ifdef ROTATE_90
+#define SHARP_SCREEN_WIDTH					LCD_VERTICAL_MAX
+#define SHARP_SCREEN_HEIGHT					LCD_HORIZONTAL_MAX
+#else
+#define SHARP_SCREEN_WIDTH					LCD_HORIZONTAL_MAX
+#define SHARP_SCREEN_HEIGHT					LCD_VERTICAL_MAX
+#endif
 
 
 //*****************************************************************************
@@ -99,6 +117,86 @@
 #define DPYCOLORTRANSLATE(c)	((c != 0) ? c = 1 : c)
 
 
+//*****************************************************************************
+//
+// Fonts and images pre-rotated for ROTATE_90 by tools/rotate_assets.c. Each
+// screen column is stored as (height + 7) >> 3 bytes, top pixel in bit 7 of
+// the first byte, so that it can be merged straight into a DisplayBuffer line.
+//
+//*****************************************************************************
+typedef struct Sharp96x96_RotatedFont
+{
+	const Graphics_Font *font;	//!< The font this one was rotated from.
+	uint8_t width;				//!< The width of every glyph.
+	uint8_t height;				//!< The height of every glyph.
+	uint8_t baseline;			//!< The baseline of the font.
+	const uint8_t *data;		//!< The columns of the glyphs from ' ' to 0x7F.
+} Sharp96x96_RotatedFont;
+
+typedef struct Sharp96x96_RotatedImage
+{
+	uint16_t width;				//!< The width of the image.
+	uint16_t height;			//!< The height of the image.
+	const uint8_t *data;		//!< The columns of the image, set bits are white.
+} Sharp96x96_RotatedImage;
+
+//*****************************************************************************
+//
+// Images run length coded by tools/pack_image.c, decoded a column at a time
+// for ROTATE_90. Columns are at most SHARP_PACKED_COLUMN_BYTES long.
+//
+//*****************************************************************************
+#define SHARP_PACKED_COLUMN_BYTES			8
+
+typedef struct Sharp96x96_PackedImage
+{
+	uint16_t width;				//!< The width of the image.
+	uint16_t height;			//!< The height of the image.
+	uint16_t size;				//!< The number of bytes of data.
+	const uint8_t *data;		//!< The run lengths, column by column.
+} Sharp96x96_PackedImage;
+
+
+//*****************************************************************************
+//
+// A whole screen rasterized at build time by tools/prerender_screens.c, run
+// length coded in DisplayBuffer order.
+//
+//*****************************************************************************
+typedef struct Sharp96x96_Screen
+{
+	uint16_t size;				//!< The number of bytes of data.
+	const uint8_t *data;		//!< The run length coded DisplayBuffer contents.
+} Sharp96x96_Screen;
+
+//*****************************************************************************
+//
+// An offscreen 1 bpp surface. Its display draws into a caller provided buffer
+// of SHARP_SURFACE_BYTES(width, height) bytes, laid out like the DisplayBuffer
+// so that Sharp96x96_BlitSurface() composites it a byte or word at a time:
+// with ROTATE_90 every screen column is a line, top pixel in bit 7 of its
+// first byte, like the data of a Sharp96x96_RotatedImage.
+//
+//*****************************************************************************
+#ifdef ROTATE_90
+#define SHARP_SURFACE_BYTES(w, h)			((w) * (((h) + 7) >> 3))
+#else
+#define SHARP_SURFACE_BYTES(w, h)			((h) * (((w) + 7) >> 3))
+#endif
+
+// Raster operations of Sharp96x96_BlitSurface(), white being a set bit
+#define SHARP_BLIT_COPY						0x00
+#define SHARP_BLIT_OR						0x01
+#define SHARP_BLIT_AND						0x02
+#define SHARP_BLIT_XOR						0x03
+
+typedef struct Sharp96x96_Surface
+{
+	Graphics_Display display;	//!< The display to initialize contexts with.
+	uint8_t *buffer;			//!< The pixels of the surface, set bits are white.
+	uint16_t stride;			//!< The number of bytes of a line.
+} Sharp96x96_Surface;
+
 //*****************************************************************************
 //
 // Prototypes for the globals exported by this driver.
@@ -106,4 +204,58 @@
 //*****************************************************************************
 extern const tDisplay g_sharp96x96LCD;
 extern void Sharp96x96_SendToggleVCOMCommand();
+extern uint8_t reverse(uint8_t x);
+
+#ifdef ROTATE_90
+extern const Sharp96x96_RotatedFont g_sRotatedFontFixed6x8;
+extern const Sharp96x96_RotatedFont *const g_ppsSharp96x96RotatedFonts[];
+extern void Sharp96x96_DrawString(const Graphics_Context *context,
+                                  const uint8_t *string, int32_t lLength,
+                                  int32_t x, int32_t y, bool opaque);
+extern void Sharp96x96_DrawStringCentered(const Graphics_Context *context,
+                                          const uint8_t *string, int32_t lLength,
+                                          int32_t x, int32_t y, bool opaque);
+extern void Sharp96x96_DrawRotatedImage(const Graphics_Context *context,
+                                        const Sharp96x96_RotatedImage *image,
+                                        int16_t x, int16_t y);
+// Not available with DISPLAY_LIST
+extern void Sharp96x96_DrawPackedImage(const Graphics_Context *context,
+                                       const Sharp96x96_PackedImage *image,
+                                       int16_t x, int16_t y);
+#endif
+
+extern void Sharp96x96_DrawLine(const Graphics_Context *context, int16_t x1,
+                                int16_t y1, int16_t x2, int16_t y2);
+extern void Sharp96x96_DrawCircle(const Graphics_Context *context, int16_t x,
+                                  int16_t y, int16_t lRadius);
+extern void Sharp96x96_FillCircle(const Graphics_Context *context, int16_t x,
+                                  int16_t y, int16_t lRadius);
+extern int32_t Sharp96x96_GetStringWidth(const Graphics_Context *context,
+                                         const uint8_t *string, int32_t lLength);
+
+// Not available with DISPLAY_LIST
+extern void Sharp96x96_DrawScreen(const Sharp96x96_Screen *screen);
+extern void Sharp96x96_SurfaceInit(Sharp96x96_Surface *surface, uint8_t *buffer,
+                                   uint16_t width, uint16_t height);
+extern void Sharp96x96_BlitSurface(const Graphics_Context *context,
+                                   const Sharp96x96_Surface *surface,
+                                   int16_t x, int16_t y, uint8_t ucOp);
+
+// Available with SCROLL_BUFFER
+extern void Sharp96x96_ScrollLines(const Graphics_Context *context,
+                                   int16_t lLines);
+
+extern void Sharp96x96_RequestFlush(void);
+extern bool Sharp96x96_ServiceFlush(const Graphics_Context *context,
+                                    uint32_t ulMillis);
+extern bool Sharp96x96_FlushPending(void);
+extern uint16_t Sharp96x96_FlushesAvoided(void);
+
+// Available with USE_DMA_FLUSH
+extern void Sharp96x96_SetFlushCallback(void (*pfnCallback)(void));
+extern bool Sharp96x96_FlushBusy(void);
+
+// Available with DISPLAY_LIST
+extern uint16_t Sharp96x96_DisplayListPeak(void);
+extern uint16_t Sharp96x96_DisplayListDropped(void);
 #endif // __SHARPLCD_H__
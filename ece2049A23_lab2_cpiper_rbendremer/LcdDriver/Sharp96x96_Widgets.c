@@ -0,0 +1,248 @@
+//*****************************************************************************
+//
+// Sharp96x96_Widgets.c - Retained text labels and strip charts drawn with the
+// Sharp96x96 LCD driver.
+//
+//*****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "grlib.h"
+
+#include "Sharp96x96.h"
+#include "Sharp96x96_Widgets.h"
+#include "HAL_MSP_EXP430FR5529_Sharp96x96.h"
+
+//*****************************************************************************
+//
+//! Clears a band of a label to the context background color.
+//!
+//! \param context is a pointer to the drawing context to use.
+//! \param lX1 is the first screen column of the band.
+//! \param lX2 is the last screen column of the band (inclusive).
+//! \param lY is the Y coordinate of the top of the label text.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void Sharp96x96_LabelClear(const Graphics_Context *context,
+                                  int16_t lX1, int16_t lX2, int16_t lY)
+{
+	const Graphics_Rectangle *pClip = &context->clipRegion;
+	Graphics_Rectangle sRect;
+
+	sRect.xMin = (lX1 < pClip->xMin) ? pClip->xMin : lX1;
+	sRect.xMax = (lX2 > pClip->xMax) ? pClip->xMax : lX2;
+	sRect.yMin = (lY < pClip->yMin) ? pClip->yMin : lY;
+	sRect.yMax = lY + context->font->height - 1;
+
+	if(sRect.yMax > pClip->yMax)
+	{
+		sRect.yMax = pClip->yMax;
+	}
+
+	if((sRect.xMin <= sRect.xMax) && (sRect.yMin <= sRect.yMax))
+	{
+		Graphics_fillRectangleOnDisplay(context->display, &sRect,
+		                                context->background);
+	}
+}
+
+//*****************************************************************************
+//
+//! Initializes a retained text label.
+//!
+//! \param label is a pointer to the label.
+//! \param x is the X coordinate of the center of the label.
+//! \param y is the Y coordinate of the center of the label.
+//!
+//! The label starts out empty, so its first Sharp96x96_LabelSetText() draws
+//! every character.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void Sharp96x96_LabelInit(Sharp96x96_Label *label, int16_t x, int16_t y)
+{
+	label->x = x;
+	label->y = y;
+	Sharp96x96_LabelInvalidate(label);
+}
+
+//*****************************************************************************
+//
+//! Forgets what a retained text label has drawn.
+//!
+//! \param label is a pointer to the label.
+//!
+//! Call this after the screen has been cleared or drawn over, so that the
+//! next Sharp96x96_LabelSetText() draws every character again.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void Sharp96x96_LabelInvalidate(Sharp96x96_Label *label)
+{
+	label->left = label->x;
+	label->width = 0;
+	label->length = 0;
+}
+
+//*****************************************************************************
+//
+//! Changes the text of a retained text label.
+//!
+//! \param context is a pointer to the drawing context to use.
+//! \param label is a pointer to the label.
+//! \param string is a pointer to the new text, of at most
+//! SHARP_LABEL_MAX_LENGTH characters.
+//!
+//! The new text is centered like Sharp96x96_DrawStringCentered() and compared
+//! with the text on screen a character at a time. Only the glyph cells whose
+//! character or position changed are redrawn, opaque, and the part of the old
+//! text left uncovered is cleared to the background color. The driver marks
+//! the lines of those cells dirty, so the next flush sends nothing else.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void Sharp96x96_LabelSetText(const Graphics_Context *context,
+                             Sharp96x96_Label *label, const uint8_t *string)
+{
+	int16_t lTop = label->y - (context->font->baseline / 2);
+	int16_t lOldX = label->left;
+	int16_t lNewX;
+	int16_t lWidth;
+	uint8_t ucLength;
+	uint8_t i;
+
+	for(ucLength = 0; (ucLength < SHARP_LABEL_MAX_LENGTH) && string[ucLength]; ucLength++)
+	{
+	}
+
+	lWidth = Sharp96x96_GetStringWidth(context, string, ucLength);
+	lNewX = label->x - (lWidth / 2);
+
+	// Clear whatever the new text does not cover of the old one
+	if(label->left < lNewX)
+	{
+		Sharp96x96_LabelClear(context, label->left, lNewX - 1, lTop);
+	}
+
+	if(label->left + label->width > lNewX + lWidth)
+	{
+		Sharp96x96_LabelClear(context, lNewX + lWidth,
+		                      label->left + label->width - 1, lTop);
+	}
+
+	label->left = lNewX;
+	label->width = lWidth;
+
+	for(i = 0; i < ucLength; i++)
+	{
+		if((i >= label->length) || (lOldX != lNewX) ||
+		   (string[i] != label->text[i]))
+		{
+#ifdef ROTATE_90
+			Sharp96x96_DrawString(context, &string[i], 1, lNewX, lTop, true);
+#else
+			Graphics_drawString(context, (uint8_t *)&string[i], 1, lNewX, lTop,
+			                    true);
+#endif
+		}
+
+		if(i < label->length)
+		{
+			lOldX += Sharp96x96_GetStringWidth(context, &label->text[i], 1);
+		}
+
+		lNewX += Sharp96x96_GetStringWidth(context, &string[i], 1);
+		label->text[i] = string[i];
+	}
+
+	label->length = ucLength;
+}
+
+#if defined(SCROLL_BUFFER) && defined(ROTATE_90)
+//*****************************************************************************
+//
+//! Initializes a strip chart.
+//!
+//! \param chart is a pointer to the chart.
+//! \param top is the screen Y coordinate of the highest value.
+//! \param bottom is the screen Y coordinate of the lowest value.
+//! \param min is the value plotted at the bottom.
+//! \param max is the value plotted at the top.
+//! \param step is the number of screen columns of every sample.
+//!
+//! Nothing is drawn. The first sample appended has no step from a previous
+//! one. Available with SCROLL_BUFFER and ROTATE_90.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void Sharp96x96_StripChartInit(Sharp96x96_StripChart *chart, int16_t top,
+                               int16_t bottom, int16_t min, int16_t max,
+                               uint8_t step)
+{
+	chart->top = top;
+	chart->bottom = bottom;
+	chart->min = min;
+	chart->max = max;
+	chart->step = step;
+	chart->last = -1;
+}
+
+//*****************************************************************************
+//
+//! Appends a sample to a strip chart.
+//!
+//! \param context is a pointer to the drawing context to use.
+//! \param chart is a pointer to the chart.
+//! \param value is the sample, clamped to the range of the chart.
+//!
+//! The screen is scrolled left by the step of the chart with
+//! Sharp96x96_ScrollLines() and the sample drawn in the columns uncovered at
+//! the right edge, a vertical step from the previous sample followed by a
+//! level line. The cost is the same whatever the length of the history on
+//! screen. The chart spans the whole width of the screen, so anything else on
+//! screen scrolls with it and fixed text has to be redrawn.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void Sharp96x96_StripChartAppend(const Graphics_Context *context,
+                                 Sharp96x96_StripChart *chart, int16_t value)
+{
+	int16_t lX = SHARP_SCREEN_WIDTH - chart->step;
+	int16_t lY = chart->bottom;
+
+	if(value < chart->min)
+	{
+		value = chart->min;
+	}
+
+	if(value > chart->max)
+	{
+		value = chart->max;
+	}
+
+	if(chart->max > chart->min)
+	{
+		lY -= (int16_t)(((int32_t)(value - chart->min) * (chart->bottom - chart->top)) /
+		                (chart->max - chart->min));
+	}
+
+	Sharp96x96_ScrollLines(context, chart->step);
+
+	if(chart->last >= 0)
+	{
+		Graphics_drawLineV(context, lX, (chart->last < lY) ? chart->last : lY,
+		                   (chart->last < lY) ? lY : chart->last);
+	}
+
+	Graphics_drawLineH(context, lX, SHARP_SCREEN_WIDTH - 1, lY);
+
+	chart->last = lY;
+}
+#endif //SCROLL_BUFFER && ROTATE_90
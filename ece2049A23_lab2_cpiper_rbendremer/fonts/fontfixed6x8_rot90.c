@@ -0,0 +1,412 @@
+//*****************************************************************************
+//
+// Generated by tools/rotate_assets.c, do not edit.
+//
+//*****************************************************************************
+
+#include <stdint.h>
+#include "grlib.h"
+#include "LcdDriver/Sharp96x96.h"
+
+static const uint8_t g_pucRotatedFontFixed6x8Data[] =
+{
+    //
+    // ' '
+    //
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    //
+    // '!'
+    //
+    0x00, 0x00, 0xf2, 0x00, 0x00, 0x00,
+    //
+    // '"'
+    //
+    0x00, 0xe0, 0x00, 0xe0, 0x00, 0x00,
+    //
+    // '#'
+    //
+    0x28, 0xfe, 0x28, 0xfe, 0x28, 0x00,
+    //
+    // '$'
+    //
+    0x24, 0x54, 0xfe, 0x54, 0x48, 0x00,
+    //
+    // '%'
+    //
+    0xc4, 0xc8, 0x10, 0x26, 0x46, 0x00,
+    //
+    // '&'
+    //
+    0x6c, 0x92, 0xaa, 0x44, 0x0a, 0x00,
+    //
+    // '''
+    //
+    0x00, 0xa0, 0xc0, 0x00, 0x00, 0x00,
+    //
+    // '('
+    //
+    0x00, 0x38, 0x44, 0x82, 0x00, 0x00,
+    //
+    // ')'
+    //
+    0x00, 0x82, 0x44, 0x38, 0x00, 0x00,
+    //
+    // '*'
+    //
+    0x28, 0x10, 0x7c, 0x10, 0x28, 0x00,
+    //
+    // '+'
+    //
+    0x10, 0x10, 0x7c, 0x10, 0x10, 0x00,
+    //
+    // ','
+    //
+    0x00, 0x0a, 0x0c, 0x00, 0x00, 0x00,
+    //
+    // '-'
+    //
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x00,
+    //
+    // '.'
+    //
+    0x00, 0x06, 0x06, 0x00, 0x00, 0x00,
+    //
+    // '/'
+    //
+    0x04, 0x08, 0x10, 0x20, 0x40, 0x00,
+    //
+    // '0'
+    //
+    0x7c, 0x8a, 0x92, 0xa2, 0x7c, 0x00,
+    //
+    // '1'
+    //
+    0x00, 0x42, 0xfe, 0x02, 0x00, 0x00,
+    //
+    // '2'
+    //
+    0x42, 0x86, 0x8a, 0x92, 0x62, 0x00,
+    //
+    // '3'
+    //
+    0x84, 0x82, 0xa2, 0xd2, 0x8c, 0x00,
+    //
+    // '4'
+    //
+    0x18, 0x28, 0x48, 0xfe, 0x08, 0x00,
+    //
+    // '5'
+    //
+    0xe4, 0xa2, 0xa2, 0xa2, 0x9c, 0x00,
+    //
+    // '6'
+    //
+    0x3c, 0x52, 0x92, 0x92, 0x0c, 0x00,
+    //
+    // '7'
+    //
+    0x80, 0x8e, 0x90, 0xa0, 0xc0, 0x00,
+    //
+    // '8'
+    //
+    0x6c, 0x92, 0x92, 0x92, 0x6c, 0x00,
+    //
+    // '9'
+    //
+    0x60, 0x92, 0x92, 0x94, 0x78, 0x00,
+    //
+    // ':'
+    //
+    0x00, 0x6c, 0x6c, 0x00, 0x00, 0x00,
+    //
+    // ';'
+    //
+    0x00, 0x6a, 0x6c, 0x00, 0x00, 0x00,
+    //
+    // '<'
+    //
+    0x10, 0x28, 0x44, 0x82, 0x00, 0x00,
+    //
+    // '='
+    //
+    0x28, 0x28, 0x28, 0x28, 0x28, 0x00,
+    //
+    // '>'
+    //
+    0x00, 0x82, 0x44, 0x28, 0x10, 0x00,
+    //
+    // '?'
+    //
+    0x40, 0x80, 0x8a, 0x90, 0x60, 0x00,
+    //
+    // '@'
+    //
+    0x4c, 0x92, 0x9e, 0x82, 0x7c, 0x00,
+    //
+    // 'A'
+    //
+    0x7e, 0x88, 0x88, 0x88, 0x7e, 0x00,
+    //
+    // 'B'
+    //
+    0xfe, 0x92, 0x92, 0x92, 0x6c, 0x00,
+    //
+    // 'C'
+    //
+    0x7c, 0x82, 0x82, 0x82, 0x44, 0x00,
+    //
+    // 'D'
+    //
+    0xfe, 0x82, 0x82, 0x44, 0x38, 0x00,
+    //
+    // 'E'
+    //
+    0xfe, 0x92, 0x92, 0x92, 0x82, 0x00,
+    //
+    // 'F'
+    //
+    0xfe, 0x90, 0x90, 0x90, 0x80, 0x00,
+    //
+    // 'G'
+    //
+    0x7c, 0x82, 0x92, 0x92, 0x5e, 0x00,
+    //
+    // 'H'
+    //
+    0xfe, 0x10, 0x10, 0x10, 0xfe, 0x00,
+    //
+    // 'I'
+    //
+    0x00, 0x82, 0xfe, 0x82, 0x00, 0x00,
+    //
+    // 'J'
+    //
+    0x04, 0x02, 0x82, 0xfc, 0x80, 0x00,
+    //
+    // 'K'
+    //
+    0xfe, 0x10, 0x28, 0x44, 0x82, 0x00,
+    //
+    // 'L'
+    //
+    0xfe, 0x02, 0x02, 0x02, 0x02, 0x00,
+    //
+    // 'M'
+    //
+    0xfe, 0x40, 0x30, 0x40, 0xfe, 0x00,
+    //
+    // 'N'
+    //
+    0xfe, 0x20, 0x10, 0x08, 0xfe, 0x00,
+    //
+    // 'O'
+    //
+    0x7c, 0x82, 0x82, 0x82, 0x7c, 0x00,
+    //
+    // 'P'
+    //
+    0xfe, 0x90, 0x90, 0x90, 0x60, 0x00,
+    //
+    // 'Q'
+    //
+    0x7c, 0x82, 0x8a, 0x84, 0x7a, 0x00,
+    //
+    // 'R'
+    //
+    0xfe, 0x90, 0x98, 0x94, 0x62, 0x00,
+    //
+    // 'S'
+    //
+    0x62, 0x92, 0x92, 0x92, 0x8c, 0x00,
+    //
+    // 'T'
+    //
+    0x80, 0x80, 0xfe, 0x80, 0x80, 0x00,
+    //
+    // 'U'
+    //
+    0xfc, 0x02, 0x02, 0x02, 0xfc, 0x00,
+    //
+    // 'V'
+    //
+    0xf8, 0x04, 0x02, 0x04, 0xf8, 0x00,
+    //
+    // 'W'
+    //
+    0xfc, 0x02, 0x1c, 0x02, 0xfc, 0x00,
+    //
+    // 'X'
+    //
+    0xc6, 0x28, 0x10, 0x28, 0xc6, 0x00,
+    //
+    // 'Y'
+    //
+    0xe0, 0x10, 0x0e, 0x10, 0xe0, 0x00,
+    //
+    // 'Z'
+    //
+    0x86, 0x8a, 0x92, 0xa2, 0xc2, 0x00,
+    //
+    // '['
+    //
+    0x00, 0xfe, 0x82, 0x82, 0x00, 0x00,
+    //
+    // '\'
+    //
+    0x40, 0x20, 0x10, 0x08, 0x04, 0x00,
+    //
+    // ']'
+    //
+    0x00, 0x82, 0x82, 0xfe, 0x00, 0x00,
+    //
+    // '^'
+    //
+    0x20, 0x40, 0x80, 0x40, 0x20, 0x00,
+    //
+    // '_'
+    //
+    0x02, 0x02, 0x02, 0x02, 0x02, 0x00,
+    //
+    // '`'
+    //
+    0x00, 0x80, 0x40, 0x20, 0x00, 0x00,
+    //
+    // 'a'
+    //
+    0x04, 0x2a, 0x2a, 0x2a, 0x1e, 0x00,
+    //
+    // 'b'
+    //
+    0xfe, 0x12, 0x22, 0x22, 0x1c, 0x00,
+    //
+    // 'c'
+    //
+    0x1c, 0x22, 0x22, 0x22, 0x04, 0x00,
+    //
+    // 'd'
+    //
+    0x1c, 0x22, 0x22, 0x12, 0xfe, 0x00,
+    //
+    // 'e'
+    //
+    0x1c, 0x2a, 0x2a, 0x2a, 0x18, 0x00,
+    //
+    // 'f'
+    //
+    0x10, 0x7e, 0x90, 0x80, 0x40, 0x00,
+    //
+    // 'g'
+    //
+    0x30, 0x4a, 0x4a, 0x4a, 0x7c, 0x00,
+    //
+    // 'h'
+    //
+    0xfe, 0x10, 0x20, 0x20, 0x1e, 0x00,
+    //
+    // 'i'
+    //
+    0x00, 0x22, 0xbe, 0x02, 0x00, 0x00,
+    //
+    // 'j'
+    //
+    0x04, 0x02, 0x22, 0xbc, 0x00, 0x00,
+    //
+    // 'k'
+    //
+    0xfe, 0x08, 0x14, 0x22, 0x00, 0x00,
+    //
+    // 'l'
+    //
+    0x00, 0x82, 0xfe, 0x02, 0x00, 0x00,
+    //
+    // 'm'
+    //
+    0x3e, 0x20, 0x18, 0x20, 0x1e, 0x00,
+    //
+    // 'n'
+    //
+    0x3e, 0x10, 0x20, 0x20, 0x1e, 0x00,
+    //
+    // 'o'
+    //
+    0x1c, 0x22, 0x22, 0x22, 0x1c, 0x00,
+    //
+    // 'p'
+    //
+    0x3e, 0x28, 0x28, 0x28, 0x10, 0x00,
+    //
+    // 'q'
+    //
+    0x10, 0x28, 0x28, 0x18, 0x3e, 0x00,
+    //
+    // 'r'
+    //
+    0x3e, 0x10, 0x20, 0x20, 0x10, 0x00,
+    //
+    // 's'
+    //
+    0x12, 0x2a, 0x2a, 0x2a, 0x04, 0x00,
+    //
+    // 't'
+    //
+    0x20, 0xfc, 0x22, 0x02, 0x04, 0x00,
+    //
+    // 'u'
+    //
+    0x3c, 0x02, 0x02, 0x04, 0x3e, 0x00,
+    //
+    // 'v'
+    //
+    0x38, 0x04, 0x02, 0x04, 0x38, 0x00,
+    //
+    // 'w'
+    //
+    0x3c, 0x02, 0x0c, 0x02, 0x3c, 0x00,
+    //
+    // 'x'
+    //
+    0x22, 0x14, 0x08, 0x14, 0x22, 0x00,
+    //
+    // 'y'
+    //
+    0x30, 0x0a, 0x0a, 0x0a, 0x3c, 0x00,
+    //
+    // 'z'
+    //
+    0x22, 0x26, 0x2a, 0x32, 0x22, 0x00,
+    //
+    // '{'
+    //
+    0x00, 0x10, 0x6c, 0x82, 0x00, 0x00,
+    //
+    // '|'
+    //
+    0x00, 0x00, 0xfe, 0x00, 0x00, 0x00,
+    //
+    // '}'
+    //
+    0x00, 0x82, 0x6c, 0x10, 0x00, 0x00,
+    //
+    // '~'
+    //
+    0x40, 0x80, 0x40, 0x20, 0x40, 0x00,
+    //
+    // ' '
+    //
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+const Sharp96x96_RotatedFont g_sRotatedFontFixed6x8 =
+{
+    &g_sFontFixed6x8,
+    6,
+    8,
+    7,
+    g_pucRotatedFontFixed6x8Data
+};
+
+const Sharp96x96_RotatedFont *const g_ppsSharp96x96RotatedFonts[] =
+{
+    &g_sRotatedFontFixed6x8,
+    0
+};
@@ -0,0 +1,190 @@
+//*****************************************************************************
+//
+// checkbox.c - The check box widget declared by checkbox.h.
+//
+// A check box is a square as tall as its font, followed by its text. The
+// square is outlined in the text color and its inside, gap pixels in from the
+// outline, is filled with the selected color when the check box is selected.
+// The text starts gap pixels after the square. Selecting or releasing a check
+// box only redraws the inside of its square.
+//
+//*****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "grlib.h"
+#include "checkbox.h"
+
+//*****************************************************************************
+//
+// Returns the side of the square of a check box.
+//
+//*****************************************************************************
+static uint8_t boxSide(const Graphics_CheckBox *checkBox)
+{
+    return Graphics_getFontHeight(checkBox->font);
+}
+
+//*****************************************************************************
+//
+// Fills the inside of the square of a check box for the given state.
+//
+//*****************************************************************************
+static void drawCheck(const Graphics_Context *context,
+                      const Graphics_CheckBox *checkBox, bool selected)
+{
+    Graphics_Context sContext = *context;
+    Graphics_Rectangle sRect;
+    uint8_t inset = checkBox->gap + 1;
+
+    if(boxSide(checkBox) <= 2 * inset)
+    {
+        return;
+    }
+
+    sRect.xMin = checkBox->xPosition + inset;
+    sRect.yMin = checkBox->yPosition + inset;
+    sRect.xMax = checkBox->xPosition + boxSide(checkBox) - 1 - inset;
+    sRect.yMax = checkBox->yPosition + boxSide(checkBox) - 1 - inset;
+
+    Graphics_setForegroundColor(&sContext, selected ? checkBox->selectedColor :
+                                checkBox->backgroundColor);
+    Graphics_fillRectangle(&sContext, &sRect);
+}
+
+//*****************************************************************************
+//
+//! Gets the rectangle covered by a check box, its text included.
+//!
+//! \param context is a pointer to the drawing context to use.
+//! \param checkBox is a pointer to the check box.
+//! \param rect is a pointer to the rectangle to fill in.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void Graphics_getCheckBoxRectangle(const Graphics_Context *context,
+                                   const Graphics_CheckBox *checkBox,
+                                   Graphics_Rectangle *rect)
+{
+    Graphics_Context sContext = *context;
+    uint8_t side = boxSide(checkBox);
+
+    Graphics_setFont(&sContext, checkBox->font);
+
+    rect->xMin = checkBox->xPosition;
+    rect->yMin = checkBox->yPosition;
+    rect->xMax = checkBox->xPosition + side - 1;
+    rect->yMax = checkBox->yPosition + side - 1;
+
+    if(checkBox->text && checkBox->numbOfChar)
+    {
+        rect->xMax += checkBox->gap +
+                      Graphics_getStringWidth(&sContext, checkBox->text,
+                                              checkBox->numbOfChar);
+    }
+}
+
+//*****************************************************************************
+//
+//! Draws a check box in its current state.
+//!
+//! \param context is a pointer to the drawing context to use.
+//! \param checkBox is a pointer to the check box.
+//!
+//! The whole rectangle of the check box is cleared to its background color
+//! first.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void Graphics_drawCheckBox(const Graphics_Context *context,
+                           const Graphics_CheckBox *checkBox)
+{
+    Graphics_Context sContext = *context;
+    Graphics_Rectangle sRect;
+    uint8_t side = boxSide(checkBox);
+
+    Graphics_getCheckBoxRectangle(context, checkBox, &sRect);
+    Graphics_setForegroundColor(&sContext, checkBox->backgroundColor);
+    Graphics_fillRectangle(&sContext, &sRect);
+
+    sRect.xMax = checkBox->xPosition + side - 1;
+    Graphics_setForegroundColor(&sContext, checkBox->textColor);
+    Graphics_drawRectangle(&sContext, &sRect);
+
+    if(checkBox->selected)
+    {
+        drawCheck(context, checkBox, true);
+    }
+
+    if(checkBox->text && checkBox->numbOfChar)
+    {
+        Graphics_setFont(&sContext, checkBox->font);
+        Graphics_drawString(&sContext, (uint8_t *)checkBox->text,
+                            checkBox->numbOfChar,
+                            checkBox->xPosition + side + checkBox->gap,
+                            checkBox->yPosition, TRANSPARENT_TEXT);
+    }
+}
+
+//*****************************************************************************
+//
+//! Checks whether a point is on the square of a check box.
+//!
+//! \param checkBox is a pointer to the check box.
+//! \param x is the X coordinate of the point.
+//! \param y is the Y coordinate of the point.
+//!
+//! The text is not included, it cannot be measured without a context.
+//!
+//! \return Returns true if the point is within the square of the check box.
+//
+//*****************************************************************************
+bool Graphics_isCheckBoxSelected(const Graphics_CheckBox *checkBox, uint16_t x,
+                                 uint16_t y)
+{
+    uint8_t side = boxSide(checkBox);
+
+    return((x >= checkBox->xPosition) && (x < checkBox->xPosition + side) &&
+           (y >= checkBox->yPosition) && (y < checkBox->yPosition + side));
+}
+
+//*****************************************************************************
+//
+//! Draws the check of a check box.
+//!
+//! \param context is a pointer to the drawing context to use.
+//! \param checkBox is a pointer to the check box, which must have been drawn.
+//!
+//! Only the inside of the square is drawn. The selected field of the check box
+//! is not changed.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void Graphics_drawSelectedCheckBox(const Graphics_Context *context,
+                                   const Graphics_CheckBox *checkBox)
+{
+    drawCheck(context, checkBox, true);
+}
+
+//*****************************************************************************
+//
+//! Clears the check of a check box.
+//!
+//! \param context is a pointer to the drawing context to use.
+//! \param checkBox is a pointer to the check box, which must have been drawn.
+//!
+//! Only the inside of the square is drawn. The selected field of the check box
+//! is not changed.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void Graphics_drawReleasedCheckBox(const Graphics_Context *context,
+                                   const Graphics_CheckBox *checkBox)
+{
+    drawCheck(context, checkBox, false);
+}
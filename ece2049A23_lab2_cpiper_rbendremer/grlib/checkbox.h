@@ -70,5 +70,7 @@ extern void Graphics_drawSelectedCheckBox(const Graphics_Context *context,
 		const Graphics_CheckBox *checkBox);
 extern void Graphics_drawReleasedCheckBox(const Graphics_Context *context,
 		const Graphics_CheckBox *checkBox);
+extern void Graphics_getCheckBoxRectangle(const Graphics_Context *context,
+		const Graphics_CheckBox *checkBox, Graphics_Rectangle *rect);
 
 #endif /* CHECKBOX_H_ */
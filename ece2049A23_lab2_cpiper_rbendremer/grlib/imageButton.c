@@ -0,0 +1,146 @@
+//*****************************************************************************
+//
+// imageButton.c - The image button widget declared by imageButton.h.
+//
+// An image button is an image inside a border of borderWidth pixels. The
+// border is drawn in the border color when the button is released and in the
+// selected color when it is selected, so a button without a border does not
+// show its state. Selecting or releasing an image button only redraws its
+// border, the image is left alone.
+//
+//*****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "grlib.h"
+#include "imageButton.h"
+
+//*****************************************************************************
+//
+// Draws the border of an image button for the given state.
+//
+//*****************************************************************************
+static void drawBorder(const Graphics_Context *context,
+                       const Graphics_ImageButton *imageButton, bool selected)
+{
+    Graphics_Context sContext = *context;
+    Graphics_Rectangle sRect;
+    uint8_t i;
+
+    Graphics_getImageButtonRectangle(imageButton, &sRect);
+    Graphics_setForegroundColor(&sContext, selected ? imageButton->selectedColor :
+                                imageButton->borderColor);
+
+    // Inwards, a rectangle per pixel of width
+    for(i = 0; i < imageButton->borderWidth; i++)
+    {
+        Graphics_drawRectangle(&sContext, &sRect);
+        sRect.xMin++;
+        sRect.yMin++;
+        sRect.xMax--;
+        sRect.yMax--;
+    }
+}
+
+//*****************************************************************************
+//
+//! Gets the rectangle covered by an image button, its border included.
+//!
+//! \param imageButton is a pointer to the image button.
+//! \param rect is a pointer to the rectangle to fill in.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void Graphics_getImageButtonRectangle(const Graphics_ImageButton *imageButton,
+                                      Graphics_Rectangle *rect)
+{
+    rect->xMin = imageButton->xPosition;
+    rect->yMin = imageButton->yPosition;
+    rect->xMax = imageButton->xPosition + imageButton->imageWidth +
+                 2 * imageButton->borderWidth - 1;
+    rect->yMax = imageButton->yPosition + imageButton->imageHeight +
+                 2 * imageButton->borderWidth - 1;
+}
+
+//*****************************************************************************
+//
+//! Draws an image button in its current state.
+//!
+//! \param context is a pointer to the drawing context to use.
+//! \param imageButton is a pointer to the image button.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void Graphics_drawImageButton(const Graphics_Context *context,
+                              const Graphics_ImageButton *imageButton)
+{
+    drawBorder(context, imageButton, imageButton->selected);
+
+    Graphics_drawImage(context, imageButton->image,
+                       imageButton->xPosition + imageButton->borderWidth,
+                       imageButton->yPosition + imageButton->borderWidth);
+}
+
+//*****************************************************************************
+//
+//! Checks whether a point is on an image button.
+//!
+//! \param imageButton is a pointer to the image button.
+//! \param x is the X coordinate of the point.
+//! \param y is the Y coordinate of the point.
+//!
+//! \return Returns true if the point is within the image button or its
+//! border.
+//
+//*****************************************************************************
+bool Graphics_isImageButtonSelected(const Graphics_ImageButton *imageButton,
+                                    uint16_t x, uint16_t y)
+{
+    Graphics_Rectangle sRect;
+
+    Graphics_getImageButtonRectangle(imageButton, &sRect);
+
+    return((x >= sRect.xMin) && (x <= sRect.xMax) &&
+           (y >= sRect.yMin) && (y <= sRect.yMax));
+}
+
+//*****************************************************************************
+//
+//! Draws the border of an image button in its selected color.
+//!
+//! \param context is a pointer to the drawing context to use.
+//! \param imageButton is a pointer to the image button, which must have been
+//! drawn.
+//!
+//! The selected field of the image button is not changed.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void Graphics_drawSelectedImageButton(const Graphics_Context *context,
+                                      const Graphics_ImageButton *imageButton)
+{
+    drawBorder(context, imageButton, true);
+}
+
+//*****************************************************************************
+//
+//! Draws the border of an image button in its border color.
+//!
+//! \param context is a pointer to the drawing context to use.
+//! \param imageButton is a pointer to the image button, which must have been
+//! drawn.
+//!
+//! The selected field of the image button is not changed.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void Graphics_drawReleasedImageButton(const Graphics_Context *context,
+                                      const Graphics_ImageButton *imageButton)
+{
+    drawBorder(context, imageButton, false);
+}
@@ -67,5 +67,7 @@ extern void Graphics_drawSelectedImageButton(const Graphics_Context *context,
 		const Graphics_ImageButton *imageButton);
 extern void Graphics_drawReleasedImageButton(const Graphics_Context *context,
 		const Graphics_ImageButton *imageButton);
+extern void Graphics_getImageButtonRectangle(
+        const Graphics_ImageButton *imageButton, Graphics_Rectangle *rect);
 
 #endif /* IMAGEBUTTON_H_ */
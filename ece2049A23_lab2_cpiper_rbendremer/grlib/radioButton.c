@@ -0,0 +1,189 @@
+//*****************************************************************************
+//
+// radioButton.c - The radio button widget declared by radioButton.h.
+//
+// A radio button is a circle as tall as its font, followed by its text. The
+// circle is outlined in the text color and its inside, gap pixels in from the
+// outline, is filled with the selected or the not selected color. The text
+// starts gap pixels after the circle. Selecting or releasing a radio button
+// only redraws the inside of its circle.
+//
+//*****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "grlib.h"
+#include "radioButton.h"
+
+//*****************************************************************************
+//
+// Returns the radius of the circle of a radio button. The circle is 2 *
+// radius + 1 pixels across, so it is centered on a pixel.
+//
+//*****************************************************************************
+static uint8_t circleRadius(const Graphics_RadioButton *radioButton)
+{
+    return (Graphics_getFontHeight(radioButton->font) - 1) >> 1;
+}
+
+//*****************************************************************************
+//
+// Fills the inside of the circle of a radio button for the given state.
+//
+//*****************************************************************************
+static void drawDot(const Graphics_Context *context,
+                    const Graphics_RadioButton *radioButton, bool selected)
+{
+    Graphics_Context sContext = *context;
+    int16_t radius = circleRadius(radioButton);
+
+    if(radius < radioButton->gap + 1)
+    {
+        return;
+    }
+
+    Graphics_setForegroundColor(&sContext, selected ? radioButton->selectedColor :
+                                radioButton->notSelectedColor);
+    Graphics_fillCircle(&sContext, radioButton->xPosition + radius,
+                        radioButton->yPosition + radius,
+                        radius - 1 - radioButton->gap);
+}
+
+//*****************************************************************************
+//
+//! Gets the rectangle covered by a radio button, its text included.
+//!
+//! \param context is a pointer to the drawing context to use.
+//! \param radioButton is a pointer to the radio button.
+//! \param rect is a pointer to the rectangle to fill in.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void Graphics_getRadioButtonRectangle(const Graphics_Context *context,
+                                      const Graphics_RadioButton *radioButton,
+                                      Graphics_Rectangle *rect)
+{
+    Graphics_Context sContext = *context;
+    uint8_t radius = circleRadius(radioButton);
+
+    Graphics_setFont(&sContext, radioButton->font);
+
+    rect->xMin = radioButton->xPosition;
+    rect->yMin = radioButton->yPosition;
+    rect->xMax = radioButton->xPosition + 2 * radius;
+    rect->yMax = radioButton->yPosition + 2 * radius;
+
+    if(radioButton->text && radioButton->numbOfChar)
+    {
+        rect->xMax += radioButton->gap +
+                      Graphics_getStringWidth(&sContext, radioButton->text,
+                                              radioButton->numbOfChar);
+    }
+}
+
+//*****************************************************************************
+//
+//! Draws a radio button in its current state.
+//!
+//! \param context is a pointer to the drawing context to use.
+//! \param radioButton is a pointer to the radio button.
+//!
+//! The whole rectangle of the radio button is cleared to the background color
+//! of the context first.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void Graphics_drawRadioButton(const Graphics_Context *context,
+                              const Graphics_RadioButton *radioButton)
+{
+    Graphics_Context sContext = *context;
+    Graphics_Rectangle sRect;
+    uint8_t radius = circleRadius(radioButton);
+
+    Graphics_getRadioButtonRectangle(context, radioButton, &sRect);
+    Graphics_setForegroundColorTranslated(&sContext, context->background);
+    Graphics_fillRectangle(&sContext, &sRect);
+
+    Graphics_setForegroundColor(&sContext, radioButton->textColor);
+    Graphics_drawCircle(&sContext, radioButton->xPosition + radius,
+                        radioButton->yPosition + radius, radius);
+
+    drawDot(context, radioButton, radioButton->selected);
+
+    if(radioButton->text && radioButton->numbOfChar)
+    {
+        Graphics_setFont(&sContext, radioButton->font);
+        Graphics_drawString(&sContext, (uint8_t *)radioButton->text,
+                            radioButton->numbOfChar,
+                            radioButton->xPosition + 2 * radius + 1 +
+                            radioButton->gap,
+                            radioButton->yPosition, TRANSPARENT_TEXT);
+    }
+}
+
+//*****************************************************************************
+//
+//! Checks whether a point is on the circle of a radio button.
+//!
+//! \param radioButton is a pointer to the radio button.
+//! \param x is the X coordinate of the point.
+//! \param y is the Y coordinate of the point.
+//!
+//! The text is not included, it cannot be measured without a context.
+//!
+//! \return Returns true if the point is within the square around the circle.
+//
+//*****************************************************************************
+bool Graphics_isRadioButtonSelected(const Graphics_RadioButton *radioButton,
+                                    uint16_t x, uint16_t y)
+{
+    uint8_t radius = circleRadius(radioButton);
+
+    return((x >= radioButton->xPosition) &&
+           (x <= radioButton->xPosition + 2 * radius) &&
+           (y >= radioButton->yPosition) &&
+           (y <= radioButton->yPosition + 2 * radius));
+}
+
+//*****************************************************************************
+//
+//! Draws the dot of a selected radio button.
+//!
+//! \param context is a pointer to the drawing context to use.
+//! \param radioButton is a pointer to the radio button, which must have been
+//! drawn.
+//!
+//! Only the inside of the circle is drawn. The selected field of the radio
+//! button is not changed.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void Graphics_drawSelectedRadioButton(const Graphics_Context *context,
+                                      const Graphics_RadioButton *radioButton)
+{
+    drawDot(context, radioButton, true);
+}
+
+//*****************************************************************************
+//
+//! Draws the inside of a radio button that is not selected.
+//!
+//! \param context is a pointer to the drawing context to use.
+//! \param radioButton is a pointer to the radio button, which must have been
+//! drawn.
+//!
+//! Only the inside of the circle is drawn. The selected field of the radio
+//! button is not changed.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void Graphics_drawReleasedRadioButton(const Graphics_Context *context,
+                                      const Graphics_RadioButton *radioButton)
+{
+    drawDot(context, radioButton, false);
+}
@@ -28,6 +28,12 @@
 // No need for a group 3 minimum threshold
 // Any note above Fs will be in group 3
 
+// Timer B0 clock, SMCLK divided by 8 in initBuzzer()
+#define BUZZER_CLK_HZ (CLOCK_SMCLK_HZ / 8)
+
+// Timer A2 count rate, from ACLK so that it keeps counting in LPM3
+#define A2_HZ 1024
+
 // Note/LED deadtime
 // Allows the user to see the difference between notes
 #define NOTE_DEADTIME 100          // ms
@@ -36,6 +42,9 @@
 #define LAST_STRIKE_NOTE2 Bb       // Hz
 #define LAST_STRIKE_NOTE3 A        // Hz
 
+// How long the selected song stays highlighted
+#define SONG_SELECT_TIME 500  // ms
+
 // Declare globals here
 #define NUM_NOTES 28
 #define SONGS 3
@@ -63,16 +72,35 @@ uint16_t durations[SONGS][NUM_NOTES] = {
     {500, 500, 500, 500, 500, 500, 500, 500, 500, 500, 500, 500, 500, 500,
      500, 500, 500, 500, 500, 500, 500, 500, 500, 500, 500, 500, 500, 500}};
 
-// Counter ticks every 0.5 ms
-// Overflow every (0.5 ms * (2^32 - 1)) = 2,147,483.6475 seconds
+// Counter ticks every 1/1024 s
+// Overflow every ((2^32 - 1) / 1024 s) = 4,194,303.999 seconds
 uint32_t A2Count = 0;
 
+// Counter ticks every 1/1024 s and is never reset, paces the display flushes
+uint32_t uptimeCount = 0;
+
 // Game status info
 uint8_t selectedSong = 0;
 uint8_t strikes = 0;
 uint8_t prevPressedButtons = 0;
 bool doublePressed = false;
 
+// Centered text of the countdown and strikes screens
+// Only the characters that change are redrawn while it is on screen
+Sharp96x96_Label centerLabel;
+bool centerLabelShown = false;
+
+// Buttons over the song names of the song selection screen
+// Only the button of the song picked is redrawn, highlighted
+char* songNames[SONGS] = {"1: Twinkle", "2: Song 2", "3: Song 3"};
+Graphics_Button songButtons[SONGS];
+Graphics_Widget songWidgets[SONGS];
+
+// Display flushes merged into another while playing the last song. Nothing
+// in the program reads it, it is there to be watched from the debugger, and
+// volatile so that the store is not optimized away
+volatile uint16_t songFlushesAvoided = 0;
+
 // State
 enum State { WELCOME, PLAYING, LOSER, WINNER };
 enum State currState = WELCOME;
@@ -82,6 +110,9 @@ void main(void) {
   WDTCTL = WDTPW | WDTHOLD;  // Stop watchdog timer. Always need to stop this!!
                              // You can then configure it properly, if desired
 
+  // 25MHz MCLK/SMCLK and 32768Hz ACLK, before anything that uses them
+  Clock_Init();
+
   // Enable global interrupts
   _BIS_SR(GIE);
 
@@ -93,25 +124,27 @@ void main(void) {
   initBuzzer();
   configDisplay();
   configKeypad();
+  Sharp96x96_LabelInit(&centerLabel, 48, 15);
+  initSongButtons();
 
   // Main loop
   while (1) {
     switch (currState) {
       case WELCOME: {
         // Display MSP430 Hero on screen
-        displayCenteredTexts("MSP430", "Hero", "", "Press *");
+        displayScreen(&g_sScreenWelcome);
 
-        // Wait for a button press to start the game
-        while (getKey() != '*')
-          ;
+        // Sleep until a button press starts the game
+        while (getKeyPress() != '*')
+          sleepDisplay(EVENT_KEY);
 
         // Ask the user to select a song
-        displayCenteredTexts("Select a song", "1: Twinkle",
-                             "2: Song 2", "3: Song 3");
+        displayScreen(&g_sScreenSelectSong);
 
         // Wait for the user to select a song
         while (1) {
-          uint8_t key = getKey();
+          sleepDisplay(EVENT_KEY);
+          uint8_t key = getKeyPress();
           if (key == '1') {
             selectedSong = 0;
             break;
@@ -124,6 +157,15 @@ void main(void) {
           }
         }
 
+        // Highlight the song picked for a moment
+        Graphics_selectWidget(&g_sContext, &songWidgets[selectedSong], true);
+        Sharp96x96_RequestFlush();
+        resetTimerA2Count();
+        waitTimerA2Millis(SONG_SELECT_TIME);
+        // The count down clears the screen, so the button is only unselected
+        // for the next time it is drawn
+        songButtons[selectedSong].selected = false;
+
         // Reset the timer
         resetTimerA2Count();
 
@@ -131,26 +173,22 @@ void main(void) {
         // 3
         displayCenteredText("3");
         displayUserLeds(0b01);
-        while (getTimerA2Millis() < 1000)
-          ;
+        waitTimerA2Millis(1000);
 
         // 2
         displayCenteredText("2");
         displayUserLeds(0b10);
-        while (getTimerA2Millis() < 2000)
-          ;
+        waitTimerA2Millis(2000);
 
         // 1
         displayCenteredText("1");
         displayUserLeds(0b01);
-        while (getTimerA2Millis() < 3000)
-          ;
+        waitTimerA2Millis(3000);
 
         // Go!
         displayCenteredText("Go!");
         displayUserLeds(0b11);
-        while (getTimerA2Millis() < 4000)
-          ;
+        waitTimerA2Millis(4000);
 
         // Clean up outputs
         turnOffAllOutputs();
@@ -175,6 +213,9 @@ void main(void) {
         // Initialize the sequence
         uint8_t currentNote = 0;
 
+        // Count the flushes merged while playing this song
+        uint16_t flushesAvoided = Sharp96x96_FlushesAvoided();
+
         // Show the user the first note
         showNote(notes[selectedSong][currentNote]);
 
@@ -191,8 +232,7 @@ void main(void) {
             // Delay for a bit
             // Allows the user to see the difference between notes
             resetTimerA2Count();
-            while (getTimerA2Millis() < NOTE_DEADTIME)
-              ;
+            waitTimerA2Millis(NOTE_DEADTIME);
 
             // Check if the user needs to be given a strike
             if (!correctButtonPressed) {
@@ -263,15 +303,19 @@ void main(void) {
           prevPressedButtons = pressed;
 
           // Check if the user wants to restart
-          if (getKey() == '#') {
+          if (getKeyPress() == '#') {
             turnOffAllOutputs();
             currState = WELCOME;
             break;
           }
+
+          // Send what this pass has drawn
+          serviceDisplay();
         }
 
         // Turn off outputs
         turnOffAllOutputs();
+        songFlushesAvoided = Sharp96x96_FlushesAvoided() - flushesAvoided;
 
         // Check if the current state is still playing, the user won
         if (currState == PLAYING) {
@@ -281,12 +325,11 @@ void main(void) {
       }
       case LOSER: {
         // Tell the user that they lost :(
-        displayCenteredTexts("You lost :(", "Rock on and", "try again!",
-                             "Press #");
+        displayScreen(&g_sScreenLost);
 
-        // Wait for a button press to restart the game
-        while (getKey() != '#')
-          ;
+        // Sleep until a button press restarts the game
+        while (getKeyPress() != '#')
+          sleepDisplay(EVENT_KEY);
 
         // Move back to the welcome screen
         currState = WELCOME;
@@ -294,11 +337,11 @@ void main(void) {
       }
       case WINNER: {
         // Tell the user that they won :)
-        displayCenteredTexts("You won!", "Radical!", "", "Press #");
+        displayScreen(&g_sScreenWon);
 
-        // Wait for a button press to restart the game
-        while (getKey() != '#')
-          ;
+        // Sleep until a button press restarts the game
+        while (getKeyPress() != '#')
+          sleepDisplay(EVENT_KEY);
 
         currState = WELCOME;
         break;
@@ -401,14 +444,14 @@ void initTimerA() {
   P5SEL |= (BIT2 | BIT3);  // Select XT1
   P5SEL |= (BIT4 | BIT5);  // Select XT2
 
-  // Configure Timer A2 to use SMCLK, divide by 1, up mode
-  TA2CTL = (TASSEL__SMCLK | ID__1 | MC__UP);
+  // Configure Timer A2 to use ACLK, divide by 1, up mode
+  // ACLK keeps running while the CPU sleeps in LPM3
+  TA2CTL = (TASSEL__ACLK | ID__1 | MC__UP);
 
   // Timer period in ticks
-  // SMCLK is 1.048576 million ticks per second
-  // Divide by 2000 to get 524.288 ticks per second
-  // Error will be mitigated by leap counting
-  TA2CCR0 = 1048576 / (1000 * 2);
+  // ACLK ticks in 1/1024 s, exactly 32 from the 32768Hz crystal
+  // Subtract 1 because the timer counts from 0
+  TA2CCR0 = CLOCK_TICKS(CLOCK_ACLK_HZ, A2_HZ) - 1;
 
   // Enable interrupts for Timer A2
   TA2CCTL0 |= CCIE;
@@ -416,13 +459,11 @@ void initTimerA() {
 
 #pragma vector = TIMER2_A0_VECTOR
 __interrupt void TimerA2_ISR() {
-  // Timer ticks at 524
-  // Should be 524.288 ticks per count (0.5ms)
-  // 524.288 / 524 = 1.0005496
-  // Error is only 0.05%... not worth leap counting for
+  // Timer period is 32 ACLK ticks, 1/1024 s exactly
 
-  // Increment the counter
+  // Increment the counters
   A2Count++;
+  uptimeCount++;
 }
 
 /**
@@ -432,9 +473,9 @@ __interrupt void TimerA2_ISR() {
  */
 uint32_t getTimerA2Millis() {
   __disable_interrupt();
-  uint32_t count = A2Count / 2;
+  uint32_t count = A2Count;
   __enable_interrupt();
-  return count;
+  return (count / A2_HZ) * 1000 + ((count % A2_HZ) * 1000) / A2_HZ;
 }
 
 /**
@@ -447,6 +488,18 @@ void resetTimerA2Count() {
   __enable_interrupt();
 }
 
+/**
+ * @brief Get the time since startup. MUST BE USED TO PREVENT READING ISSUES
+ *
+ * @return uint32_t The time since startup (in ms)
+ */
+uint32_t getUptimeMillis() {
+  __disable_interrupt();
+  uint32_t count = uptimeCount;
+  __enable_interrupt();
+  return (count / A2_HZ) * 1000 + ((count % A2_HZ) * 1000) / A2_HZ;
+}
+
 /**
  * @brief Initializes the buzzer
  *
@@ -456,8 +509,9 @@ void initBuzzer() {
   P3SEL |= BIT5;  // Select peripheral output mode for P3.5
   P3DIR |= BIT5;
 
-  // Configure Timer B0 to use SMCLK, divide by 1, up mode
-  TB0CTL = (TBSSEL__SMCLK | ID__1 | MC__UP);
+  // Configure Timer B0 to use SMCLK, divide by 8, up mode
+  // Divided so the period of the lowest note fits in 16 bits
+  TB0CTL = (TBSSEL__SMCLK | ID__8 | MC__UP);
   TB0CTL &= ~TBIE;  // Explicitly disable timer interrupts for safety
 
   // Disable both capture/compare periods (buzzer shouldn't be on yet)
@@ -512,9 +566,9 @@ void turnOffAllOutputs() {
  */
 void playNote(uint16_t freq) {
   // Configure the PWM period (controls frequency)
-  // SMCLK has 1048576 ticks per second
+  // Timer B0 ticks at SMCLK / 8
   // Divide by the frequency to get the period
-  TB0CCR0 = 1048576 / freq;
+  TB0CCR0 = CLOCK_TICKS(BUZZER_CLK_HZ, (uint32_t)freq);
   TB0CCTL0 &= ~CCIE;  // Disable timer interrupts
 
   // Configure CC register 5, which is connected to our PWM pin TB0.5
@@ -528,19 +582,117 @@ void playNote(uint16_t freq) {
  */
 void clearDisplay() {
   Graphics_clearDisplay(&g_sContext);
-  Graphics_flushBuffer(&g_sContext);
+  centerLabelShown = false;
+  Sharp96x96_RequestFlush();
+}
+
+/**
+ * @brief Sends the changes drawn to the display, if a flush has been requested
+ * and the last flush was long enough ago. Called wherever the main loop waits
+ *
+ * Drawing only requests a flush, so changes drawn one after another, like a
+ * strike and the screen after it, are sent to the display together
+ */
+void serviceDisplay() {
+  Sharp96x96_ServiceFlush(&g_sContext, getUptimeMillis());
+}
+
+/**
+ * @brief Services the display, then sleeps until one of the given events
+ *
+ * A flush that was held back to pace the display also wakes the CPU on the
+ * next keypad scan, so that it is sent as soon as it is due
+ *
+ * @param events The EVENT_ bits to wake up on
+ * @return uint8_t The events that happened
+ */
+uint8_t sleepDisplay(uint8_t events) {
+  serviceDisplay();
+  if (Sharp96x96_FlushPending()) {
+    events |= EVENT_TICK;
+  }
+  return waitForEvent(events);
+}
+
+/**
+ * @brief Sleeps, servicing the display, until Timer A2 reaches the given time
+ *
+ * @param ms The count of timer A2 to wait for (in ms)
+ */
+void waitTimerA2Millis(uint32_t ms) {
+  uint32_t now;
+  while ((now = getTimerA2Millis()) < ms) {
+    setEventTimer(ms - now);
+    sleepDisplay(EVENT_TIMER);
+  }
+}
+
+/**
+ * @brief Sets up the buttons of the song selection screen
+ *
+ * The buttons have no border and are drawn released exactly as the song names
+ * of g_sScreenSelectSong, centered on x = 48 at y = 30, 45 and 60, so they do
+ * not need drawing until one is selected
+ */
+void initSongButtons() {
+  uint8_t i;
+  for (i = 0; i < SONGS; i++) {
+    int16_t width = Graphics_getStringWidth(&g_sContext, (int8_t*)songNames[i],
+                                            AUTO_STRING_LENGTH);
+    Graphics_Button* button = &songButtons[i];
+
+    // As Graphics_drawStringCentered() places the text
+    button->textXPos = 48 - width / 2;
+    button->textYPos = 15 * (i + 2) - g_sFontFixed6x8.baseline / 2;
+
+    // One pixel around the text
+    button->xMin = button->textXPos - 1;
+    button->xMax = button->textXPos + width;
+    button->yMin = button->textYPos - 1;
+    button->yMax = button->textYPos + g_sFontFixed6x8.height;
+
+    button->borderWidth = 0;
+    button->selected = false;
+    button->fillColor = ClrWhite;
+    button->borderColor = ClrWhite;
+    button->selectedColor = ClrBlack;
+    button->textColor = ClrBlack;
+    button->selectedTextColor = ClrWhite;
+    button->text = (int8_t*)songNames[i];
+    button->font = &g_sFontFixed6x8;
+
+    Graphics_initWidget(&g_sContext, &songWidgets[i], GRAPHICS_WIDGET_BUTTON,
+                        button);
+  }
+}
+
+/**
+ * @brief Displays a screen pre-rasterized by tools/prerender_screens.c
+ *
+ * @param screen The screen to display
+ */
+void displayScreen(const Sharp96x96_Screen* screen) {
+  Sharp96x96_DrawScreen(screen);
+  centerLabelShown = false;
+  Sharp96x96_RequestFlush();
 }
 
 /**
  * @brief Displays the given string in the center of the screen
  *
+ * Only the characters that differ from the last string are redrawn, unless
+ * something else has been drawn since
+ *
  * @param string The string to display
  */
 void displayCenteredText(uint8_t* string) {
-  Graphics_clearDisplay(&g_sContext);
-  Graphics_drawStringCentered(&g_sContext, string, AUTO_STRING_LENGTH, 48, 15,
-                              TRANSPARENT_TEXT);
-  Graphics_flushBuffer(&g_sContext);
+  if (!centerLabelShown) {
+    Graphics_clearDisplay(&g_sContext);
+    Sharp96x96_LabelInvalidate(&centerLabel);
+    centerLabelShown = true;
+  }
+  Sharp96x96_LabelSetText(&g_sContext, &centerLabel, string);
+  Sharp96x96_RequestFlush();
 }
 
 /**
@@ -554,15 +706,16 @@ void displayCenteredText(uint8_t* string) {
 void displayCenteredTexts(uint8_t* string1, uint8_t* string2, uint8_t* string3,
                           uint8_t* string4) {
   Graphics_clearDisplay(&g_sContext);
-  Graphics_drawStringCentered(&g_sContext, string1, AUTO_STRING_LENGTH, 48, 15,
-                              TRANSPARENT_TEXT);
-  Graphics_drawStringCentered(&g_sContext, string2, AUTO_STRING_LENGTH, 48, 30,
-                              TRANSPARENT_TEXT);
-  Graphics_drawStringCentered(&g_sContext, string3, AUTO_STRING_LENGTH, 48, 45,
-                              TRANSPARENT_TEXT);
-  Graphics_drawStringCentered(&g_sContext, string4, AUTO_STRING_LENGTH, 48, 60,
-                              TRANSPARENT_TEXT);
-  Graphics_flushBuffer(&g_sContext);
+  centerLabelShown = false;
+  Sharp96x96_DrawStringCentered(&g_sContext, string1, AUTO_STRING_LENGTH, 48, 15,
+                                TRANSPARENT_TEXT);
+  Sharp96x96_DrawStringCentered(&g_sContext, string2, AUTO_STRING_LENGTH, 48, 30,
+                                TRANSPARENT_TEXT);
+  Sharp96x96_DrawStringCentered(&g_sContext, string3, AUTO_STRING_LENGTH, 48, 45,
+                                TRANSPARENT_TEXT);
+  Sharp96x96_DrawStringCentered(&g_sContext, string4, AUTO_STRING_LENGTH, 48, 60,
+                                TRANSPARENT_TEXT);
+  Sharp96x96_RequestFlush();
 }
 
 /**
@@ -584,14 +737,11 @@ bool giveStrike() {
   if (strikes == 3) {
     resetTimerA2Count();
     playNote(LAST_STRIKE_NOTE1);
-    while (getTimerA2Millis() < LAST_STRIKE_DURATION)
-      ;
+    waitTimerA2Millis(LAST_STRIKE_DURATION);
     playNote(LAST_STRIKE_NOTE2);
-    while (getTimerA2Millis() < LAST_STRIKE_DURATION * 2)
-      ;
+    waitTimerA2Millis(LAST_STRIKE_DURATION * 2);
     playNote(LAST_STRIKE_NOTE3);
-    while (getTimerA2Millis() < LAST_STRIKE_DURATION * 3)
-      ;
+    waitTimerA2Millis(LAST_STRIKE_DURATION * 3);
     currState = LOSER;
     return true;
   }
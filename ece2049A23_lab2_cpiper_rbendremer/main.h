@@ -3,6 +3,10 @@
 #include <msp430.h>
 #include <peripherals.h>
 #include <stdlib.h>
+#include "screens/screens.h"
+#include "button.h"
+#include "widget.h"
+#include "LcdDriver/Sharp96x96_Widgets.h"
 
 
 // Function declarations
@@ -11,6 +15,7 @@ void initUserLeds();
 void initTimerA();
 uint32_t getTimerA2Millis();
 void resetTimerA2Count();
+uint32_t getUptimeMillis();
 void initButtons();
 uint8_t getPressedButtons();
 void initBuzzer();
@@ -21,6 +26,11 @@ void showNote(uint16_t freq);
 void playNote(uint16_t freq);
 void waitForRestart();
 void clearDisplay();
+void serviceDisplay();
+uint8_t sleepDisplay(uint8_t events);
+void waitTimerA2Millis(uint32_t ms);
+void initSongButtons();
+void displayScreen(const Sharp96x96_Screen* screen);
 void displayCenteredText(uint8_t* string);
 void displayCenteredTexts(uint8_t* string1, uint8_t* string2, uint8_t* string3,
                           uint8_t* string4);
@@ -54,18 +54,73 @@
  * The actual clock frequency is given in number of
  * ticks of the specified clock source.
  *
- * For our configuration, we use SMCLK */
+ * For our configuration, we use SMCLK divided down
+ * to the fastest clock the MCP4921 takes, 20MHz */
 #define DAC_SPI_CLK_SRC		(UCSSEL__SMCLK)
-#define DAC_SPI_CLK_TICKS	0
+#define DAC_SPI_CLK_HZ		20000000UL
+#define DAC_SPI_CLK_TICKS	CLOCK_SPI_DIV(DAC_SPI_CLK_HZ)
+
+/*
+ * Display VCOM
+ * Timer A1 CCR0 interrupts at VCOM_TOGGLE_HZ from ACLK to flip the
+ * VCOM bit of the display, which must not be held for long to keep
+ * a DC bias off the panel.
+ */
+#define VCOM_TOGGLE_HZ			1
+#define VCOM_TOGGLE_TICKS		CLOCK_TICKS(CLOCK_ACLK_HZ, VCOM_TOGGLE_HZ)
+
+/*
+ * Keypad scanner parameters
+ * Timer A1 CCR1 interrupts at KEYPAD_SCAN_HZ from ACLK. Every
+ * interrupt reads the rows of the column driven by the previous
+ * one, so each key is sampled once every KEYPAD_COLS interrupts.
+ */
+#define KEYPAD_SCAN_HZ			1000
+#define KEYPAD_SCAN_TICKS		CLOCK_TICKS(CLOCK_ACLK_HZ, KEYPAD_SCAN_HZ)
+#define KEYPAD_COLS				3
+#define KEYPAD_ROWS				4
+#define KEYPAD_KEYS				(KEYPAD_COLS * KEYPAD_ROWS)
+#define KEYPAD_SAMPLE_MS		(KEYPAD_COLS * 1000 / KEYPAD_SCAN_HZ)
+
+// Samples a key must agree on before it changes state, about 12ms
+#define KEYPAD_DEBOUNCE_SAMPLES	4
+// A key held this long reports a KEY_EVENT_LONG_PRESS
+#define KEYPAD_LONG_PRESS_MS	1000
+#define KEYPAD_LONG_PRESS_SAMPLES	(KEYPAD_LONG_PRESS_MS / KEYPAD_SAMPLE_MS)
+
+// Events waiting to be read, newer events are dropped when it is full
+#define KEY_QUEUE_LENGTH		8
+
+// Keypad event types
+#define KEY_EVENT_PRESS			1
+#define KEY_EVENT_RELEASE		2
+#define KEY_EVENT_LONG_PRESS	3
+
+typedef struct
+{
+    unsigned char type;		// KEY_EVENT_*
+    unsigned char key;		// ASCII value of the key
+} KeyEvent;
+
+/*
+ * Wakeup events of waitForEvent()
+ * The keypad scanner and the event timer run from ACLK on Timer A1,
+ * so they wake the CPU from LPM3.
+ */
+#define EVENT_KEY				BIT0	// A keypad event is queued
+#define EVENT_TIMER				BIT1	// The setEventTimer() deadline passed
+#define EVENT_TICK				BIT2	// A keypad scan completed, every KEYPAD_SAMPLE_MS
+
+// Count the share of time spent out of waitForEvent(), see getActivePercent()
+//#define MEASURE_ACTIVE_TIME
 
 // Globals
 extern tContext g_sContext;	// user defined type used by graphics library
 
 // Prototypes for functions defined implemented in peripherals.c
 
-//void DACInit(void);
-//void DACSetValue(unsigned int dac_code);
-//void setupSPI_DAC(void);
+void DACInit(void);
+void DACSetValue(unsigned int dac_code);
 void initLeds(void);
 void setLeds(unsigned char state);
 
@@ -75,5 +130,14 @@ void BuzzerOff(void);
 
 void configKeypad(void);
 unsigned char getKey(void);
+unsigned char getKeyEvent(KeyEvent *event);
+unsigned char getKeyPress(void);
+
+void setEventTimer(unsigned long ms);
+unsigned char waitForEvent(unsigned char events);
+void sleepMillis(unsigned long ms);
+#ifdef MEASURE_ACTIVE_TIME
+unsigned char getActivePercent(void);
+#endif
 
 #endif /* PERIPHERALS_H_ */
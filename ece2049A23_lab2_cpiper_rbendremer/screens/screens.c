@@ -0,0 +1,192 @@
+//*****************************************************************************
+//
+// Generated by tools/prerender_screens.c, do not edit.
+//
+//*****************************************************************************
+
+#include <stdint.h>
+#include "grlib.h"
+#include "LcdDriver/Sharp96x96.h"
+
+#include "screens/screens.h"
+
+static const uint8_t g_pucScreenWelcomeData[] =
+{
+    0xff, 0xff, 0xff, 0xff, 0xd6, 0xff, 0x00, 0xeb, 0x8a, 0xff, 0x00, 0xf7,
+    0x8a, 0xff, 0x00, 0xc1, 0x84, 0xff, 0x01, 0xf8, 0x3f, 0x83, 0xff, 0x00,
+    0xf7, 0x84, 0xff, 0x01, 0xf5, 0xdf, 0x83, 0xff, 0x00, 0xeb, 0x84, 0xff,
+    0x01, 0xf6, 0xdf, 0x89, 0xff, 0x01, 0xf7, 0x5f, 0x89, 0xff, 0x01, 0xf8,
+    0x3f, 0x95, 0xff, 0x03, 0xf7, 0x3f, 0xfc, 0x7f, 0x87, 0xff, 0x03, 0xf2,
+    0xdf, 0xfb, 0xbf, 0x87, 0xff, 0x03, 0xf5, 0xdf, 0xfb, 0xbf, 0x87, 0xff,
+    0x03, 0xf7, 0xdf, 0xfb, 0xbf, 0x81, 0xff, 0x00, 0xfd, 0x84, 0xff, 0x03,
+    0xf7, 0xbf, 0xfc, 0x7f, 0x81, 0xff, 0x00, 0xea, 0x8a, 0xff, 0x00, 0xea,
+    0x85, 0xff, 0x01, 0x7f, 0xfd, 0x82, 0xff, 0x00, 0xea, 0x84, 0xff, 0x02,
+    0xf0, 0x1f, 0xfb, 0x82, 0xff, 0x00, 0xf6, 0x84, 0xff, 0x02, 0xfb, 0x7f,
+    0xfb, 0x88, 0xff, 0x02, 0xfd, 0x7f, 0xfd, 0x82, 0xff, 0x00, 0xfd, 0x84,
+    0xff, 0x03, 0xfe, 0x7f, 0xf8, 0x3f, 0x81, 0xff, 0x00, 0xea, 0x8a, 0xff,
+    0x00, 0xea, 0x84, 0xff, 0x02, 0xf9, 0xff, 0xfc, 0x82, 0xff, 0x00, 0xea,
+    0x84, 0xff, 0x03, 0xf6, 0xff, 0xfa, 0xbf, 0x81, 0xff, 0x00, 0xf6, 0x84,
+    0xff, 0x03, 0xf6, 0xff, 0xfa, 0xbf, 0x87, 0xff, 0x03, 0xf6, 0xff, 0xfa,
+    0xbf, 0x81, 0xff, 0x00, 0xf3, 0x84, 0xff, 0x03, 0xf0, 0x1f, 0xfc, 0x7f,
+    0x81, 0xff, 0x00, 0xea, 0x8a, 0xff, 0x00, 0xea, 0x84, 0xff, 0x03, 0xf7,
+    0x3f, 0xe0, 0x3f, 0x81, 0xff, 0x00, 0xea, 0x84, 0xff, 0x02, 0xf6, 0xdf,
+    0xfd, 0x82, 0xff, 0x00, 0xf1, 0x84, 0xff, 0x02, 0xf6, 0xdf, 0xfd, 0x88,
+    0xff, 0x02, 0xf6, 0xdf, 0xfd, 0x82, 0xff, 0x00, 0xf7, 0x84, 0xff, 0x03,
+    0xf9, 0xdf, 0xe0, 0x3f, 0x81, 0xff, 0x00, 0xef, 0x8a, 0xff, 0x00, 0xef,
+    0x84, 0xff, 0x01, 0xf0, 0x1f, 0x83, 0xff, 0x00, 0xf7, 0x84, 0xff, 0x00,
+    0xfb, 0x84, 0xff, 0x00, 0xe0, 0x84, 0xff, 0x00, 0xfc, 0x8a, 0xff, 0x00,
+    0xfb, 0x84, 0xff, 0x00, 0xcf, 0x84, 0xff, 0x01, 0xf0, 0x1f, 0x83, 0xff,
+    0x00, 0xb7, 0x8a, 0xff, 0x00, 0xb7, 0x8a, 0xff, 0x00, 0xb7, 0x8a, 0xff,
+    0x00, 0x80, 0xff, 0xff, 0xff, 0xff, 0xc7, 0xff,
+};
+
+const Sharp96x96_Screen g_sScreenWelcome =
+{
+    308,
+    g_pucScreenWelcomeData
+};
+
+static const uint8_t g_pucScreenSelectSongData[] =
+{
+    0xf8, 0xff, 0x01, 0xf8, 0x3f, 0x89, 0xff, 0x01, 0xfb, 0x5f, 0x89, 0xff,
+    0x01, 0xfb, 0x5f, 0x89, 0xff, 0x01, 0xfb, 0x5f, 0x89, 0xff, 0x00, 0xfc,
+    0x96, 0xff, 0x01, 0xfe, 0x1f, 0x89, 0xff, 0x00, 0xfd, 0x8a, 0xff, 0x00,
+    0xfd, 0x8a, 0xff, 0x02, 0xfe, 0xff, 0xfc, 0x88, 0xff, 0x03, 0xfc, 0x1f,
+    0xfa, 0xbf, 0x89, 0xff, 0x01, 0xfa, 0xbf, 0x87, 0xff, 0x06, 0xfe, 0x3f,
+    0xfa, 0xbf, 0xe7, 0x7f, 0xb9, 0x84, 0xff, 0x06, 0xfd, 0xdf, 0xfc, 0x7f,
+    0xdb, 0x7f, 0x96, 0x84, 0xff, 0x01, 0xfd, 0xdf, 0x81, 0xff, 0x02, 0xdd,
+    0x7f, 0xae, 0x84, 0xff, 0x01, 0xfd, 0xdf, 0x81, 0xff, 0x02, 0xde, 0x7f,
+    0xbe, 0x84, 0xff, 0x06, 0xfe, 0x3f, 0xff, 0xbf, 0xef, 0x7f, 0xbd, 0x86,
+    0xff, 0x01, 0xe0, 0x3f, 0x88, 0xff, 0x02, 0xbf, 0xef, 0xbf, 0x87, 0xff,
+    0x01, 0xfd, 0x5f, 0x89, 0xff, 0x01, 0xfd, 0x5f, 0x89, 0xff, 0x01, 0xfd,
+    0x5f, 0x89, 0xff, 0x03, 0xfe, 0xdf, 0xfb, 0xbf, 0x89, 0xff, 0x01, 0xfd,
+    0x7f, 0x89, 0xff, 0x04, 0xfe, 0xff, 0xe0, 0xff, 0xc1, 0x86, 0xff, 0x04,
+    0xe0, 0x3f, 0xed, 0x7f, 0xda, 0x88, 0xff, 0x02, 0xed, 0x7f, 0xda, 0x86,
+    0xff, 0x04, 0xfc, 0x3f, 0xed, 0x7f, 0xda, 0x86, 0xff, 0x04, 0xfb, 0xff,
+    0xf3, 0xff, 0xe7, 0x86, 0xff, 0x00, 0xfb, 0x88, 0xff, 0x06, 0xfe, 0x1f,
+    0xfd, 0xff, 0xf8, 0x7f, 0xf0, 0x84, 0xff, 0x06, 0xfd, 0x5f, 0xf8, 0x3f,
+    0xf7, 0xff, 0xef, 0x84, 0xff, 0x01, 0xfd, 0x5f, 0x81, 0xff, 0x02, 0xf7,
+    0xff, 0xef, 0x84, 0xff, 0x01, 0xfd, 0x5f, 0x81, 0xff, 0x02, 0xfb, 0xff,
+    0xf7, 0x85, 0xff, 0x05, 0xbf, 0xff, 0xbf, 0xf0, 0x7f, 0xe0, 0x86, 0xff,
+    0x01, 0xe8, 0x3f, 0x89, 0xff, 0x04, 0xfb, 0xbf, 0xf8, 0xff, 0xf1, 0x88,
+    0xff, 0x02, 0xf7, 0x7f, 0xee, 0x88, 0xff, 0x02, 0xf7, 0x7f, 0xee, 0x86,
+    0xff, 0x04, 0xf8, 0x7f, 0xf7, 0x7f, 0xee, 0x87, 0xff, 0x03, 0xbf, 0xf8,
+    0xff, 0xf1, 0x86, 0xff, 0x01, 0xfe, 0x7f, 0x88, 0xff, 0x05, 0xbf, 0xff,
+    0xbf, 0xdc, 0xff, 0xb9, 0x85, 0xff, 0x05, 0xdf, 0xf8, 0x7f, 0xdb, 0x7f,
+    0xb6, 0x84, 0xff, 0x01, 0xfd, 0xdf, 0x81, 0xff, 0x02, 0xdb, 0x7f, 0xb6,
+    0x84, 0xff, 0x06, 0xf0, 0x3f, 0xef, 0xff, 0xdb, 0x7f, 0xb6, 0x84, 0xff,
+    0x06, 0xfd, 0xff, 0xef, 0xff, 0xe7, 0x7f, 0xce, 0x86, 0xff, 0x01, 0xe0,
+    0x3f, 0x88, 0xff, 0x01, 0xbf, 0xef, 0x88, 0xff, 0x02, 0xfd, 0xdf, 0xef,
+    0x88, 0xff, 0x01, 0xfd, 0xdf, 0x89, 0xff, 0x01, 0xfd, 0xdf, 0x89, 0xff,
+    0x01, 0xfe, 0x3f, 0x95, 0xff, 0x01, 0xfe, 0x7f, 0x89, 0xff, 0x01, 0xfd,
+    0x5f, 0x89, 0xff, 0x01, 0xfd, 0x5f, 0x81, 0xff, 0x02, 0xe4, 0xff, 0xc9,
+    0x84, 0xff, 0x01, 0xfd, 0x5f, 0x81, 0xff, 0x02, 0xe4, 0xff, 0xc9, 0x84,
+    0xff, 0x01, 0xfe, 0x3f, 0x8b, 0xff, 0x01, 0xf2, 0x7f, 0x89, 0xff, 0x04,
+    0xf2, 0x7f, 0xe7, 0x7f, 0xb9, 0x85, 0xff, 0x00, 0xdf, 0x81, 0xff, 0x02,
+    0xdb, 0x7f, 0x96, 0x84, 0xff, 0x01, 0xf0, 0x1f, 0x81, 0xff, 0x02, 0xdd,
+    0x7f, 0xae, 0x84, 0xff, 0x01, 0xf7, 0xdf, 0x81, 0xff, 0x02, 0xde, 0x7f,
+    0xbe, 0x87, 0xff, 0x03, 0xbf, 0xef, 0x7f, 0xbd, 0x86, 0xff, 0x01, 0xe0,
+    0x3f, 0x87, 0xff, 0x03, 0xfe, 0x7f, 0xf7, 0xbf, 0x87, 0xff, 0x01, 0xfd,
+    0x5f, 0x89, 0xff, 0x01, 0xfd, 0x5f, 0x89, 0xff, 0x01, 0xfd, 0x5f, 0x89,
+    0xff, 0x01, 0xfe, 0x3f, 0x95, 0xff, 0x01, 0xf7, 0x3f, 0x89, 0xff, 0x01,
+    0xf6, 0xdf, 0x89, 0xff, 0x01, 0xf6, 0xdf, 0x89, 0xff, 0x01, 0xf6, 0xdf,
+    0x89, 0xff, 0x01, 0xf9, 0xdf, 0xf4, 0xff,
+};
+
+const Sharp96x96_Screen g_sScreenSelectSong =
+{
+    511,
+    g_pucScreenSelectSongData
+};
+
+static const uint8_t g_pucScreenLostData[] =
+{
+    0xff, 0xff, 0xc2, 0xff, 0x01, 0xe0, 0x3f, 0x87, 0xff, 0x03, 0xf7, 0xdf,
+    0xfd, 0xbf, 0x87, 0xff, 0x03, 0xfb, 0xbf, 0xfb, 0xbf, 0x87, 0xff, 0x03,
+    0xfc, 0x7f, 0xfb, 0xbf, 0x89, 0xff, 0x01, 0xfc, 0x7f, 0x8b, 0xff, 0x01,
+    0xc3, 0x7f, 0x87, 0xff, 0x01, 0xfc, 0x3f, 0x89, 0xff, 0x00, 0xfb, 0x88,
+    0xff, 0x02, 0xf9, 0x3f, 0xfb, 0x88, 0xff, 0x05, 0xf9, 0x3f, 0xfd, 0xff,
+    0xf8, 0x7f, 0x87, 0xff, 0x02, 0xf8, 0x3f, 0xf7, 0x8a, 0xff, 0x00, 0xf7,
+    0x88, 0xff, 0x04, 0xfc, 0x3f, 0xfb, 0xff, 0xeb, 0x86, 0xff, 0x04, 0xfa,
+    0xbf, 0xf0, 0x7f, 0x80, 0x86, 0xff, 0x01, 0xfa, 0xbf, 0x81, 0xff, 0x00,
+    0xeb, 0x86, 0xff, 0x01, 0xfa, 0xbf, 0x81, 0xff, 0x00, 0x80, 0x87, 0xff,
+    0x03, 0x7f, 0xff, 0x7f, 0xeb, 0x88, 0xff, 0x01, 0xd0, 0x7f, 0x86, 0xff,
+    0x00, 0xbf, 0x81, 0xff, 0x01, 0xf7, 0x7f, 0x86, 0xff, 0x00, 0xdf, 0x89,
+    0xff, 0x01, 0xfd, 0xdf, 0x89, 0xff, 0x01, 0xf0, 0x3f, 0x81, 0xff, 0x01,
+    0xf8, 0x7f, 0x85, 0xff, 0x00, 0xfd, 0x82, 0xff, 0x01, 0xf5, 0x7f, 0x89,
+    0xff, 0x01, 0xf5, 0x7f, 0x86, 0xff, 0x05, 0xbf, 0xfc, 0x3f, 0xf5, 0x7f,
+    0xfd, 0x84, 0xff, 0x06, 0xfd, 0x5f, 0xfb, 0xff, 0xfe, 0xff, 0xea, 0x84,
+    0xff, 0x02, 0xfd, 0x5f, 0xfb, 0x82, 0xff, 0x00, 0xea, 0x84, 0xff, 0x06,
+    0xfd, 0x5f, 0xfd, 0xff, 0xe0, 0xff, 0xea, 0x84, 0xff, 0x06, 0xfe, 0xdf,
+    0xf8, 0x3f, 0xed, 0x7f, 0xf6, 0x88, 0xff, 0x01, 0xed, 0x7f, 0x85, 0xff,
+    0x06, 0xfe, 0x3f, 0xfc, 0x7f, 0xed, 0x7f, 0xfd, 0x84, 0xff, 0x06, 0xfd,
+    0xdf, 0xfb, 0xbf, 0xf3, 0xff, 0xea, 0x84, 0xff, 0x03, 0xfd, 0xdf, 0xfb,
+    0xbf, 0x81, 0xff, 0x00, 0xea, 0x84, 0xff, 0x06, 0xfd, 0xdf, 0xfb, 0xbf,
+    0xf8, 0x7f, 0xea, 0x84, 0xff, 0x06, 0xfe, 0x3f, 0xfc, 0x7f, 0xf5, 0x7f,
+    0xf6, 0x88, 0xff, 0x01, 0xf5, 0x7f, 0x89, 0xff, 0x02, 0xf5, 0x7f, 0xf3,
+    0x85, 0xff, 0x00, 0xdf, 0x81, 0xff, 0x02, 0xfe, 0xff, 0xea, 0x84, 0xff,
+    0x01, 0xf0, 0x1f, 0x83, 0xff, 0x00, 0xea, 0x84, 0xff, 0x01, 0xf7, 0xdf,
+    0x83, 0xff, 0x00, 0xea, 0x8a, 0xff, 0x00, 0xf1, 0x96, 0xff, 0x00, 0xf7,
+    0x86, 0xff, 0x01, 0xfb, 0xbf, 0x81, 0xff, 0x00, 0xef, 0x86, 0xff, 0x01,
+    0xfd, 0x7f, 0x81, 0xff, 0x00, 0xef, 0x86, 0xff, 0x04, 0xfe, 0xff, 0xf0,
+    0xff, 0xf7, 0x86, 0xff, 0x04, 0xe0, 0x3f, 0xfd, 0x7f, 0xe0, 0x88, 0xff,
+    0x01, 0xfd, 0x7f, 0x85, 0xff, 0x06, 0xfc, 0x1f, 0xff, 0x7f, 0xfd, 0x7f,
+    0xcf, 0x85, 0xff, 0x05, 0xbf, 0xfb, 0xbf, 0xf3, 0xff, 0xb7, 0x85, 0xff,
+    0x02, 0xdf, 0xfb, 0xbf, 0x81, 0xff, 0x00, 0xb7, 0x85, 0xff, 0x05, 0xdf,
+    0xfb, 0xbf, 0xfb, 0xff, 0xb7, 0x84, 0xff, 0x06, 0xfc, 0x3f, 0xfc, 0x7f,
+    0xf7, 0xff, 0x80, 0x88, 0xff, 0x00, 0xf7, 0x86, 0xff, 0x04, 0xfe, 0x3f,
+    0xfc, 0x7f, 0xfb, 0x86, 0xff, 0x05, 0xfd, 0xdf, 0xfb, 0xbf, 0xf0, 0x7f,
+    0x85, 0xff, 0x03, 0xfd, 0xdf, 0xfb, 0xbf, 0x87, 0xff, 0x04, 0xfd, 0xdf,
+    0xfb, 0xbf, 0xfe, 0x86, 0xff, 0x05, 0xfe, 0x3f, 0xfc, 0x7f, 0xff, 0x7f,
+    0x89, 0xff, 0x01, 0xf7, 0x7f, 0x85, 0xff, 0x04, 0xf1, 0xff, 0xf3, 0xbf,
+    0xc0, 0x86, 0xff, 0x04, 0xfe, 0xff, 0xed, 0x7f, 0xf7, 0x87, 0xff, 0x01,
+    0x1f, 0xec, 0x88, 0xff, 0x02, 0xfe, 0xff, 0xed, 0x88, 0xff, 0x03, 0xf1,
+    0xff, 0xe0, 0x3f, 0xff, 0xff, 0xba, 0xff,
+};
+
+const Sharp96x96_Screen g_sScreenLost =
+{
+    487,
+    g_pucScreenLostData
+};
+
+static const uint8_t g_pucScreenWonData[] =
+{
+    0xff, 0xff, 0xff, 0xff, 0xc4, 0xff, 0x03, 0xf0, 0xdf, 0xe1, 0xbf, 0x8d,
+    0xff, 0x00, 0xeb, 0x8a, 0xff, 0x00, 0x80, 0x8a, 0xff, 0x00, 0xeb, 0x84,
+    0xff, 0x01, 0xfe, 0x1f, 0x83, 0xff, 0x00, 0x80, 0x84, 0xff, 0x00, 0xfd,
+    0x81, 0xff, 0x00, 0xbf, 0x81, 0xff, 0x00, 0xeb, 0x84, 0xff, 0x03, 0xfd,
+    0xff, 0xe0, 0x3f, 0x87, 0xff, 0x03, 0xfe, 0xff, 0xef, 0xbf, 0x87, 0xff,
+    0x01, 0xfc, 0x1f, 0x95, 0xff, 0x03, 0xfe, 0x3f, 0xfc, 0x3f, 0x87, 0xff,
+    0x03, 0xfd, 0xdf, 0xfa, 0xbf, 0x87, 0xff, 0x03, 0xfd, 0xdf, 0xfa, 0xbf,
+    0x87, 0xff, 0x03, 0xfd, 0xdf, 0xfa, 0xbf, 0x81, 0xff, 0x00, 0xfd, 0x84,
+    0xff, 0x03, 0xfe, 0x3f, 0xff, 0x7f, 0x81, 0xff, 0x00, 0xea, 0x8a, 0xff,
+    0x00, 0xea, 0x84, 0xff, 0x03, 0xfc, 0x3f, 0xff, 0x7f, 0x81, 0xff, 0x00,
+    0xea, 0x85, 0xff, 0x02, 0xdf, 0xfb, 0xbf, 0x81, 0xff, 0x00, 0xf6, 0x85,
+    0xff, 0x02, 0x3f, 0xfb, 0xbf, 0x88, 0xff, 0x02, 0xdf, 0xfb, 0xbf, 0x81,
+    0xff, 0x00, 0xfd, 0x84, 0xff, 0x03, 0xfc, 0x3f, 0xfc, 0x7f, 0x81, 0xff,
+    0x00, 0xea, 0x8a, 0xff, 0x00, 0xea, 0x8a, 0xff, 0x00, 0xea, 0x87, 0xff,
+    0x00, 0xbf, 0x81, 0xff, 0x00, 0xf6, 0x86, 0xff, 0x01, 0xe8, 0x3f, 0x89,
+    0xff, 0x01, 0xfb, 0xbf, 0x81, 0xff, 0x00, 0xf3, 0x8a, 0xff, 0x00, 0xea,
+    0x8a, 0xff, 0x00, 0xea, 0x84, 0xff, 0x03, 0xfc, 0x1f, 0xe0, 0x3f, 0x81,
+    0xff, 0x00, 0xea, 0x85, 0xff, 0x02, 0xbf, 0xfd, 0xbf, 0x81, 0xff, 0x00,
+    0xf1, 0x85, 0xff, 0x02, 0xdf, 0xfb, 0xbf, 0x88, 0xff, 0x02, 0xdf, 0xfb,
+    0xbf, 0x81, 0xff, 0x00, 0xf7, 0x84, 0xff, 0x03, 0xfc, 0x3f, 0xfc, 0x7f,
+    0x81, 0xff, 0x00, 0xef, 0x8a, 0xff, 0x00, 0xef, 0x84, 0xff, 0x03, 0xfe,
+    0x3f, 0xfc, 0x3f, 0x81, 0xff, 0x00, 0xf7, 0x84, 0xff, 0x03, 0xfd, 0xdf,
+    0xfa, 0xbf, 0x81, 0xff, 0x00, 0xe0, 0x84, 0xff, 0x03, 0xfd, 0xdf, 0xfa,
+    0xbf, 0x87, 0xff, 0x03, 0xfd, 0xdf, 0xfa, 0xbf, 0x81, 0xff, 0x00, 0xcf,
+    0x84, 0xff, 0x03, 0xfe, 0x3f, 0xff, 0x7f, 0x81, 0xff, 0x00, 0xb7, 0x8a,
+    0xff, 0x00, 0xb7, 0x84, 0xff, 0x03, 0xf1, 0xff, 0xf3, 0xbf, 0x81, 0xff,
+    0x00, 0xb7, 0x84, 0xff, 0x03, 0xfe, 0xff, 0xed, 0x7f, 0x81, 0xff, 0x00,
+    0x80, 0x85, 0xff, 0x01, 0x1f, 0xec, 0x88, 0xff, 0x02, 0xfe, 0xff, 0xed,
+    0x88, 0xff, 0x03, 0xf1, 0xff, 0xe0, 0x3f, 0xff, 0xff, 0xff, 0xff, 0xa6,
+    0xff,
+};
+
+const Sharp96x96_Screen g_sScreenWon =
+{
+    349,
+    g_pucScreenWonData
+};
+
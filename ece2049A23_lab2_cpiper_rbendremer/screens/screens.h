@@ -0,0 +1,18 @@
+//*****************************************************************************
+//
+// Generated by tools/prerender_screens.c, do not edit.
+//
+//*****************************************************************************
+
+#ifndef __SCREENS_H__
+#define __SCREENS_H__
+
+#include "grlib.h"
+#include "LcdDriver/Sharp96x96.h"
+
+extern const Sharp96x96_Screen g_sScreenWelcome;
+extern const Sharp96x96_Screen g_sScreenSelectSong;
+extern const Sharp96x96_Screen g_sScreenLost;
+extern const Sharp96x96_Screen g_sScreenWon;
+
+#endif // __SCREENS_H__
@@ -0,0 +1,119 @@
+//*****************************************************************************
+//
+// HAL_MSP_EXP430FR5529_Clock.c - Clock system of the board.
+//
+//*****************************************************************************
+
+#include <msp430.h>
+#include <stdint.h>
+
+#include "HAL_MSP_EXP430FR5529_Clock.h"
+
+// The FLL needs n x 32 x 32 reference cycles to settle, n being the FLLD
+// divider. This is that time in MCLK cycles.
+#define CLOCK_FLL_SETTLE_CYCLES	(32UL * 32UL * (CLOCK_MCLK_HZ / CLOCK_XT1_HZ))
+
+// DCO range holding CLOCK_MCLK_HZ near the middle of its taps
+#define CLOCK_DCORSEL			((CLOCK_MCLK_HZ > 16000000UL) ? DCORSEL_7 :	\
+								 (CLOCK_MCLK_HZ >  8000000UL) ? DCORSEL_6 : DCORSEL_5)
+
+//*****************************************************************************
+//
+//! Raises the core voltage by one level.
+//!
+//! \param ucLevel is the new level, one above the current one.
+//!
+//! The high side supervisor is moved up first, then the core voltage, and the
+//! low side supervisor last, as in the MSP430x5xx family user's guide.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void Clock_SetVCoreUp(uint8_t ucLevel)
+{
+	// Open the PMM registers
+	PMMCTL0_H = PMMPW_H;
+
+	// High side supervisor and monitor to the new level
+	SVSMHCTL = SVSHE | (SVSHRVL0 * ucLevel) | SVMHE | (SVSMHRRL0 * ucLevel);
+
+	// Low side monitor to the new level, supervisor kept at the old one
+	SVSMLCTL = SVSLE | SVMLE | (SVSMLRRL0 * ucLevel);
+	while(!(PMMIFG & SVSMLDLYIFG));
+
+	PMMIFG &= ~(SVMLVLRIFG | SVMLIFG);
+
+	PMMCTL0_L = PMMCOREV0 * ucLevel;
+
+	// Wait for the core voltage to get there
+	if(PMMIFG & SVMLIFG)
+	{
+		while(!(PMMIFG & SVMLVLRIFG));
+	}
+
+	// Low side supervisor to the new level
+	SVSMLCTL = SVSLE | (SVSLRVL0 * ucLevel) | SVMLE | (SVSMLRRL0 * ucLevel);
+
+	// Lock the PMM registers
+	PMMCTL0_H = 0x00;
+}
+
+//*****************************************************************************
+//
+//! Waits for every oscillator fault flag to stay clear.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void Clock_WaitStable(void)
+{
+	do
+	{
+		UCSCTL7 &= ~(XT2OFFG | XT1LFOFFG | DCOFFG);
+		SFRIFG1 &= ~OFIFG;
+	} while(SFRIFG1 & OFIFG);
+}
+
+//*****************************************************************************
+//
+//! Sets up the clock system.
+//!
+//! MCLK and SMCLK run at CLOCK_MCLK_HZ from the DCO, locked by the FLL to
+//! XT1, and ACLK runs from XT1. Must be called first in main(), before any
+//! peripheral clocked from them is set up.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void Clock_Init(void)
+{
+	uint8_t ucLevel;
+
+	// The core voltage only goes up one level at a time
+	for(ucLevel = (PMMCTL0 & PMMCOREV_3) + 1; ucLevel <= CLOCK_VCORE_LEVEL; ucLevel++)
+	{
+		Clock_SetVCoreUp(ucLevel);
+	}
+
+	// Start XT1 on P5.4 and P5.5 with the LaunchPad load capacitance
+	P5SEL |= (BIT5|BIT4);
+	UCSCTL6 &= ~(XT1OFF|XT1DRIVE_3);
+	UCSCTL6 |= XCAP_3 | XT1DRIVE_3;
+	Clock_WaitStable();
+
+	// Full drive was only needed for the startup
+	UCSCTL6 &= ~XT1DRIVE_3;
+
+	// Lock the DCO to XT1, with the FLL loop off while it is reprogrammed
+	__bis_SR_register(SCG0);
+	UCSCTL0 = 0x0000;
+	UCSCTL1 = CLOCK_DCORSEL;
+	UCSCTL2 = FLLD_0 | CLOCK_FLL_N;
+	UCSCTL3 = SELREF__XT1CLK | FLLREFDIV__1;
+	__bic_SR_register(SCG0);
+
+	__delay_cycles(CLOCK_FLL_SETTLE_CYCLES);
+
+	UCSCTL4 = SELA__XT1CLK | SELS__DCOCLKDIV | SELM__DCOCLKDIV;
+	Clock_WaitStable();
+}
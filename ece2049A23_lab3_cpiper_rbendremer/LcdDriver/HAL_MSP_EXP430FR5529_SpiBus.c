@@ -0,0 +1,366 @@
+//*****************************************************************************
+//
+// HAL_MSP_EXP430FR5529_SpiBus.c - Sharing of the UCB0 SPI bus between the
+// Sharp LCD and the other SPI devices of the board.
+//
+//*****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "grlib.h"
+
+#include "HAL_MSP_EXP430FR5529_Sharp96x96.h"
+
+#ifdef SHARED_SPI_BUS
+//*****************************************************************************
+//
+// State of the bus. BusConfig is the device the USCI is set up for, BusOwned
+// is true while the LCD holds the bus and BusSleeping while SpiBus_Acquire()
+// waits in LPM0 for the queue to be sent.
+//
+//*****************************************************************************
+static const tSpiBusDevice *BusConfig;
+static volatile bool BusOwned;
+static volatile bool BusSleeping;
+
+// Ring of the transactions waiting for the bus
+static const tSpiBusTransaction *BusQueue[SPI_BUS_QUEUE_LENGTH];
+static volatile uint8_t BusHead;
+static volatile uint8_t BusCount;
+
+// The transaction going out, with its bytes and the next one to send
+static const tSpiBusTransaction * volatile BusSending;
+static uint8_t BusData[SPI_BUS_TRANSACTION_MAX];
+static uint8_t BusIndex;
+
+// The device waiting for the bus with SpiBus_Request()
+static const tSpiBusDevice *BusWaiter;
+static void (*BusGranted)(void);
+
+//*****************************************************************************
+//
+//! Sets the USCI up for a device.
+//!
+//! \param psDevice is a pointer to the device.
+//!
+//! Nothing is done if the USCI is already set up for it. The bus must be
+//! idle.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void SpiBus_Configure(const tSpiBusDevice *psDevice)
+{
+	if(psDevice == BusConfig)
+	{
+		return;
+	}
+
+	BusConfig = psDevice;
+
+	SPI_REG_CTL1 |= UCSWRST;
+
+	SPI_REG_CTL0 = (SPI_REG_CTL0 & ~(UCCKPH|UCCKPL|UCMSB)) | psDevice->ucCtl0;
+	SPI_REG_BRL  =  psDevice->uiClkDiv & 0xFF;
+	SPI_REG_BRH  = (psDevice->uiClkDiv >> 8) & 0xFF;
+
+	SPI_REG_CTL1 &= ~UCSWRST;
+	SPI_REG_IFG  &= ~UCRXIFG;
+}
+
+//*****************************************************************************
+//
+//! Drives the chip select of a device.
+//!
+//! \param psDevice is a pointer to the device.
+//! \param bSelect is true to select the device and false to release it.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void SpiBus_Select(const tSpiBusDevice *psDevice, bool bSelect)
+{
+	if(bSelect == psDevice->bCsActiveHigh)
+	{
+		*psDevice->pucCsOut |= psDevice->ucCsPin;
+	}
+	else
+	{
+		*psDevice->pucCsOut &= ~psDevice->ucCsPin;
+	}
+}
+
+//*****************************************************************************
+//
+//! Moves the queue on once the previous byte has been clocked out.
+//!
+//! Sends the next byte of the transaction going out, or closes it and starts
+//! the next one. Once the queue is empty the bus goes to the device waiting
+//! for it, if any. UCRXIFG tells when a byte is out, so its interrupt is
+//! enabled while the queue is being sent.
+//!
+//! Must be called with interrupts disabled while the bus is not owned and no
+//! byte is in flight.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void SpiBus_Next(void)
+{
+	const tSpiBusTransaction *psTransaction = BusSending;
+	void (*pfnGranted)(void);
+	uint8_t i;
+
+	for(;;)
+	{
+		if(psTransaction)
+		{
+			if(BusIndex < psTransaction->ucSize)
+			{
+				SPI_REG_TXBUF = BusData[BusIndex++];
+				return;
+			}
+
+			SpiBus_Select(psTransaction->psDevice, false);
+
+			// A transaction submitted from pfnDone is queued behind the others
+			if(psTransaction->pfnDone)
+			{
+				psTransaction->pfnDone();
+			}
+
+			BusSending = 0;
+		}
+
+		if(!BusCount)
+		{
+			break;
+		}
+
+		psTransaction = BusQueue[BusHead];
+		BusHead = (BusHead + 1) % SPI_BUS_QUEUE_LENGTH;
+		BusCount--;
+
+		for(i = 0; i < psTransaction->ucSize; i++)
+		{
+			BusData[i] = psTransaction->pucData[i];
+		}
+
+		BusIndex = 0;
+		BusSending = psTransaction;
+
+		SpiBus_Configure(psTransaction->psDevice);
+		SpiBus_Select(psTransaction->psDevice, true);
+
+		SPI_REG_IFG &= ~UCRXIFG;
+		SPI_REG_IE  |=  UCRXIE;
+	}
+
+	SPI_REG_IE &= ~UCRXIE;
+
+	if(BusGranted)
+	{
+		pfnGranted = BusGranted;
+		BusGranted = 0;
+
+		BusOwned = true;
+		SpiBus_Configure(BusWaiter);
+
+		pfnGranted();
+	}
+}
+
+//*****************************************************************************
+//
+//! Takes the bus for the LCD, waiting for the queue to be sent.
+//!
+//! \param psDevice is a pointer to the LCD device.
+//!
+//! Called by AssertCS(). The CPU sleeps in LPM0 until USCI_B0_ISR has sent the
+//! transactions already going out. A caller with interrupts disabled, which
+//! cannot sleep, runs the queue itself. Must not be called while a request
+//! made with SpiBus_Request() is waiting.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void SpiBus_Acquire(const tSpiBusDevice *psDevice)
+{
+	unsigned short state = __get_interrupt_state();
+
+	__disable_interrupt();
+
+	while(BusSending)
+	{
+		if(state & GIE)
+		{
+			// Enabling GIE and sleeping is one instruction, so the USCI ISR
+			// cannot empty the queue between the check and LPM0 entry
+			BusSleeping = true;
+			__bis_SR_register(LPM0_bits | GIE);
+			__disable_interrupt();
+			BusSleeping = false;
+		}
+		else if(SPI_REG_IFG & UCRXIFG)
+		{
+			SPI_REG_IFG &= ~UCRXIFG;
+			SpiBus_Next();
+		}
+	}
+
+	BusOwned = true;
+	SpiBus_Configure(psDevice);
+
+	__set_interrupt_state(state);
+}
+
+//*****************************************************************************
+//
+//! Takes the bus for the LCD without waiting for it.
+//!
+//! \param psDevice is a pointer to the LCD device.
+//! \param pfnGranted is called once the bus is held and the USCI set up for
+//! the device, with interrupts disabled.
+//!
+//! Used by the DMA flush engine, from any context. The bus is granted before
+//! this returns when it is free, and otherwise from USCI_B0_ISR once the
+//! queued transactions have been sent. Only one request may be waiting.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void SpiBus_Request(const tSpiBusDevice *psDevice, void (*pfnGranted)(void))
+{
+	unsigned short state = __get_interrupt_state();
+
+	__disable_interrupt();
+
+	BusWaiter = psDevice;
+	BusGranted = pfnGranted;
+
+	if(!BusOwned && !BusSending)
+	{
+		SpiBus_Next();
+	}
+
+	__set_interrupt_state(state);
+}
+
+//*****************************************************************************
+//
+//! Gives the bus back once the LCD chip select has been released.
+//!
+//! Called by DeassertCS(). The first of the transactions queued while the LCD
+//! held the bus is started, and USCI_B0_ISR sends the rest.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void SpiBus_Release(void)
+{
+	unsigned short state = __get_interrupt_state();
+
+	__disable_interrupt();
+
+	BusOwned = false;
+	SpiBus_Next();
+
+	__set_interrupt_state(state);
+}
+
+//*****************************************************************************
+//
+//! Checks whether transactions are waiting for the LCD to release the bus.
+//!
+//! \return Returns true if a transaction is queued.
+//
+//*****************************************************************************
+bool SpiBus_Pending(void)
+{
+	return (BusCount != 0);
+}
+
+//*****************************************************************************
+//
+//! Sends a transaction on the bus, or queues it until the bus is released.
+//!
+//! \param psTransaction is a pointer to the transaction, which must be left
+//! untouched until its pfnDone is called.
+//!
+//! May be called from any context, ISRs included, and returns straight away.
+//! Submitting a transaction that is still queued does not queue it twice, so
+//! a device whose data is rewritten in place, such as the next DAC sample,
+//! sends the latest data. One submitted again while it is going out is queued
+//! again.
+//!
+//! \return Returns false if the queue is full or the transaction too long, and
+//! the transaction was dropped.
+//
+//*****************************************************************************
+bool SpiBus_Submit(const tSpiBusTransaction *psTransaction)
+{
+	unsigned short state = __get_interrupt_state();
+	bool bQueued = true;
+	uint8_t i;
+
+	if(psTransaction->ucSize > SPI_BUS_TRANSACTION_MAX)
+	{
+		return false;
+	}
+
+	__disable_interrupt();
+
+	for(i = 0; i < BusCount; i++)
+	{
+		if(BusQueue[(BusHead + i) % SPI_BUS_QUEUE_LENGTH] == psTransaction)
+		{
+			break;
+		}
+	}
+
+	if(i == BusCount)
+	{
+		if(BusCount < SPI_BUS_QUEUE_LENGTH)
+		{
+			BusQueue[(BusHead + BusCount) % SPI_BUS_QUEUE_LENGTH] = psTransaction;
+			BusCount++;
+		}
+		else
+		{
+			bQueued = false;
+		}
+	}
+
+	if(!BusOwned && !BusSending)
+	{
+		SpiBus_Next();
+	}
+
+	__set_interrupt_state(state);
+
+	return bQueued;
+}
+
+//------------------------------------------------------------------------------
+// USCI B0 Interrupt Service Routine, sends the queue
+//------------------------------------------------------------------------------
+#pragma vector=USCI_B0_VECTOR
+__interrupt void USCI_B0_ISR(void)
+{
+	switch(__even_in_range(SPI_REG_IV, 4))
+	{
+	case USCI_UCRXIFG:
+		// The last byte sent has been clocked out
+		SpiBus_Next();
+
+		if(BusSleeping && !BusSending)
+		{
+			__bic_SR_register_on_exit(LPM0_bits);
+		}
+		break;
+
+	default:
+		break;
+	}
+}
+#endif //SHARED_SPI_BUS
@@ -56,12 +56,37 @@
 
 #include <msp430.h>
 #include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
 
 #include "grlib.h"
 #include "Sharp96x96.h"
 #include "HAL_MSP_EXP430FR5529_Sharp96x96.h"
 
 static void Sharp96x96_InitializeDisplayBuffer(void *pvDisplayData, uint8_t ucValue);
+static uint32_t Sharp96x96_ColorTranslate(void *pvDisplayData, uint32_t ulValue);
+
+//*****************************************************************************
+//
+// Panel geometry. The driver is sized entirely by LCD_HORIZONTAL_MAX and
+// LCD_VERTICAL_MAX, so the same code drives the 96x96, 128x128 and 400x240
+// memory LCDs. A line is sent and stored as whole 16 bit words, and the line
+// addresses and the line numbers handled by the driver are 8 bit.
+//
+// With ROTATE_90 screen X is the LCD line RotatedLine(x), counted from the
+// bottom of the panel. The mapping is its own inverse.
+//
+//*****************************************************************************
+#if (LCD_HORIZONTAL_MAX & 0xF) != 0
+#error "LCD_HORIZONTAL_MAX must be a multiple of 16 pixels"
+#endif
+#if LCD_VERTICAL_MAX > 255
+#error "LCD_VERTICAL_MAX must fit the 8 bit line address"
+#endif
+
+#ifdef ROTATE_90
+#define RotatedLine(x)		(LCD_VERTICAL_MAX - 1 - (x))
+#endif
 
 //*****************************************************************************
 //
@@ -74,13 +99,44 @@ static void Sharp96x96_InitializeDisplayBuffer(void *pvDisplayData, uint8_t ucVa
 //
 //*****************************************************************************
 
+#ifdef DISPLAY_LIST
+#ifdef USE_DMA_FLUSH
+#error "DISPLAY_LIST rasterizes every line while it is sent and does not support USE_DMA_FLUSH"
+#endif
+#ifdef WIRE_FORMAT_BUFFER
+#error "DISPLAY_LIST has no DisplayBuffer and cannot be used with WIRE_FORMAT_BUFFER"
+#endif
+#ifdef NON_VOLATILE_MEMORY_BUFFER
+#error "DISPLAY_LIST has no DisplayBuffer and cannot be used with NON_VOLATILE_MEMORY_BUFFER"
+#endif
+#ifdef SCROLL_BUFFER
+#error "DISPLAY_LIST has no DisplayBuffer and cannot be used with SCROLL_BUFFER"
+#endif
+#else
 #ifdef NON_VOLATILE_MEMORY_BUFFER
 #pragma location=NON_VOLATILE_MEMORY_ADDRESS
 #endif
 
 
 #ifndef NON_VOLATILE_MEMORY_BUFFER
-uint8_t DisplayBuffer[LCD_VERTICAL_MAX][LCD_HORIZONTAL_MAX/8];
+// The span fill engine writes the DisplayBuffer 16 bits at a time
+#if defined(__TI_COMPILER_VERSION__)
+#pragma DATA_ALIGN(DisplayBuffer, 2)
+#elif defined(__ICC430__)
+#pragma data_alignment=2
+#endif
+
+#ifdef __GNUC__
+#define WORD_ALIGNED	__attribute__((aligned(2)))
+#else
+#define WORD_ALIGNED
+#endif
+
+#ifdef WIRE_FORMAT_BUFFER
+uint8_t DisplayBuffer[SHARP_WIRE_FRAME_BYTES] WORD_ALIGNED;
+#else
+uint8_t DisplayBuffer[LCD_VERTICAL_MAX][LCD_HORIZONTAL_MAX/8] WORD_ALIGNED;
+#endif //WIRE_FORMAT_BUFFER
 #else
 #ifdef __ICC430__
 __no_init uint8_t DisplayBuffer[LCD_VERTICAL_MAX +32][LCD_HORIZONTAL_MAX/8];
@@ -89,8 +145,233 @@ uint8_t DisplayBuffer[LCD_VERTICAL_MAX +32][LCD_HORIZONTAL_MAX/8];
 #endif //__ICC430__
 #endif //NON_VOLATILE_MEMORY_BUFFER
 
-uint8_t VCOMbit= 0x40;
-uint8_t flagSendToggleVCOMCommand = 0;
+//*****************************************************************************
+//
+// Access to the data bytes of a DisplayBuffer line. DISPLAY_STRIDE is the
+// distance in bytes from one line to the next.
+//
+// With SCROLL_BUFFER the DisplayBuffer is a ring: LCD line y is held by
+// DisplayBuffer line DisplayLine(y), ScrollOffset lines further on, and
+// scrolling only moves ScrollOffset. Lines from y up to the end of the ring
+// are contiguous. DisplaySlot(n) is DisplayBuffer line n itself and
+// DisplayRow(y) the one holding LCD line y.
+//
+//*****************************************************************************
+#ifdef SCROLL_BUFFER
+static uint8_t ScrollOffset;
+
+#define DisplayLine(y)		((((y) + ScrollOffset) < LCD_VERTICAL_MAX) ? \
+							 ((y) + ScrollOffset) : ((y) + ScrollOffset - LCD_VERTICAL_MAX))
+#else
+#define DisplayLine(y)		(y)
+#endif //SCROLL_BUFFER
+
+#ifdef WIRE_FORMAT_BUFFER
+#ifdef LANDSCAPE_FLIP
+#error "WIRE_FORMAT_BUFFER stores lines in wire order and cannot mirror them for LANDSCAPE_FLIP"
+#endif
+#ifdef NON_VOLATILE_MEMORY_BUFFER
+#error "WIRE_FORMAT_BUFFER is only supported with a RAM DisplayBuffer"
+#endif
+
+#define DISPLAY_STRIDE		SHARP_WIRE_LINE_BYTES
+#define DisplaySlot(n)		(&DisplayBuffer[2 + (n)*SHARP_WIRE_LINE_BYTES])
+#else
+#define DISPLAY_STRIDE		(LCD_HORIZONTAL_MAX>>3)
+#define DisplaySlot(n)		(DisplayBuffer[n])
+#endif //WIRE_FORMAT_BUFFER
+
+#define DisplayRow(y)		DisplaySlot(DisplayLine(y))
+#endif //DISPLAY_LIST
+
+//*****************************************************************************
+//
+// VCOM scheduling. Every transaction carries VCOMbit in its command byte, so
+// the once a second flip made by Sharp96x96_SendToggleVCOMCommand() reaches
+// the panel with the next frame for free. A standalone change VCOM transaction
+// is only sent when the flip is due, no frame has been requested to carry it
+// and no frame is being built or sent.
+//
+// FrameOpen is set while the main context builds and starts a frame, and keeps
+// the ISRs off the bus. SentVCOMbit is the VCOM bit the panel last received.
+//
+//*****************************************************************************
+volatile uint8_t VCOMbit = SHARP_VCOM_TOGGLE_BIT;
+static volatile uint8_t SentVCOMbit = SHARP_VCOM_TOGGLE_BIT;
+static volatile bool FrameOpen;
+
+// The standalone change VCOM transaction, sent by DMA
+static uint8_t VCOMFrame[2];
+
+//*****************************************************************************
+//
+// Dirty line bitmap. Bit (y & 0xF) of DirtyRows[y >> 4] is set when line y of
+// the DisplayBuffer has been modified since it was last sent to the LCD, so a
+// flush only has to transmit the lines that actually changed.
+//
+//*****************************************************************************
+#define DIRTY_ROW_WORDS		SHARP_LINE_BITMAP_WORDS
+
+uint16_t DirtyRows[DIRTY_ROW_WORDS];
+
+#ifdef USE_DMA_FLUSH
+#ifdef LANDSCAPE_FLIP
+#error "USE_DMA_FLUSH sends the DisplayBuffer as is and cannot mirror it for LANDSCAPE_FLIP"
+#endif
+
+#ifndef WIRE_FORMAT_BUFFER
+// Lines of the frame currently owned by the DMA engine
+static uint16_t FlushRows[DIRTY_ROW_WORDS];
+#endif
+
+// Called from the DMA ISR when a frame has been sent
+static void (*FlushCallback)(void);
+#endif
+
+// Frame coalescing of Sharp96x96_RequestFlush() and Sharp96x96_ServiceFlush()
+static volatile bool FlushRequested;
+static uint32_t LastFlushMillis;
+static uint16_t FlushesAvoided;
+
+//*****************************************************************************
+//
+//! Sends the VCOM flip if it is due and the bus is free.
+//!
+//! With USE_DMA_FLUSH the transaction is handed to the DMA engine, so this
+//! never waits and may be called from any context, ISRs included. Without it
+//! the bytes are polled out and this must only be called from the main
+//! context.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void Sharp96x96_SendDueVCOM(void)
+{
+#ifdef USE_DMA_FLUSH
+	unsigned short state = __get_interrupt_state();
+
+	// Both the Timer and the DMA ISR call in
+	__disable_interrupt();
+
+	if(!FrameOpen && (SentVCOMbit != VCOMbit) && !Sharp96x96_DmaBusy())
+	{
+		SentVCOMbit = VCOMbit;
+		VCOMFrame[0] = SHARP_LCD_CMD_CHANGE_VCOM ^ SentVCOMbit;
+		VCOMFrame[1] = SHARP_LCD_TRAILER_BYTE;
+
+		Sharp96x96_DmaSendBlock(VCOMFrame, 2, 0);
+	}
+
+	__set_interrupt_state(state);
+#else
+	if(FrameOpen || (SentVCOMbit == VCOMbit))
+	{
+		return;
+	}
+
+	SentVCOMbit = VCOMbit;
+
+	AssertCS();
+
+	WriteCmdData(SHARP_LCD_CMD_CHANGE_VCOM ^ SentVCOMbit);
+	WriteCmdData(SHARP_LCD_TRAILER_BYTE);
+
+	// Wait for last byte to be sent, then drop SCS
+	WaitUntilLcdWriteFinished();
+
+	// Ensure a 2us min delay to meet the LCD's thSCS
+	__delay_cycles(SYSTEM_CLOCK_SPEED * 0.000002);
+
+	DeassertCS();
+#endif
+}
+
+//*****************************************************************************
+//
+//! Takes the bus for a frame.
+//!
+//! \param ucCommand is the command byte of the frame.
+//!
+//! A standalone VCOM transaction still going out is waited for. The frame
+//! carries the current VCOM bit, which settles any flip that was due.
+//!
+//! \return Returns the command byte with the VCOM bit applied.
+//
+//*****************************************************************************
+static uint8_t Sharp96x96_OpenFrame(uint8_t ucCommand)
+{
+	FrameOpen = true;
+
+#ifdef USE_DMA_FLUSH
+	Sharp96x96_DmaWaitIdle();
+#endif
+
+	SentVCOMbit = VCOMbit;
+
+	return ucCommand ^ SentVCOMbit;
+}
+
+//*****************************************************************************
+//
+//! Gives the bus back once a frame has been sent or handed to the DMA engine.
+//!
+//! A flip made by the Timer ISR while the frame was open was not carried by
+//! it. Unless another frame has been requested, it is sent now, or once the
+//! frame has gone out.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void Sharp96x96_CloseFrame(void)
+{
+	FrameOpen = false;
+
+	if(!FlushRequested)
+	{
+		Sharp96x96_SendDueVCOM();
+	}
+}
+
+#ifdef USE_DMA_FLUSH
+//*****************************************************************************
+//
+// Called from the DMA ISR when a frame has been sent. A flip that came in
+// while it was going out follows it, unless another frame will carry it.
+//
+//*****************************************************************************
+static void Sharp96x96_FrameDone(void)
+{
+	if(FlushCallback)
+	{
+		FlushCallback();
+	}
+
+	if(!FlushRequested)
+	{
+		Sharp96x96_SendDueVCOM();
+	}
+}
+#endif
+
+#ifdef DOUBLE_BUFFER
+#ifndef USE_DMA_FLUSH
+#error "DOUBLE_BUFFER hands its front buffer to the DMA engine and needs USE_DMA_FLUSH"
+#endif
+
+// Snapshot of the DisplayBuffer lines in the frame owned by the DMA engine
+#ifdef WIRE_FORMAT_BUFFER
+static uint8_t FrontBuffer[SHARP_WIRE_FRAME_BYTES];
+#else
+static uint8_t FrontBuffer[LCD_VERTICAL_MAX][LCD_HORIZONTAL_MAX/8];
+#endif
+#endif
+
+//*****************************************************************************
+//
+// Marks a single line of the DisplayBuffer as modified
+//
+//*****************************************************************************
+#define MarkRowDirty(y)		(DirtyRows[(y) >> 4] |= (1u << ((y) & 0xF)))
 
 //*******************************************************************************
 //
@@ -111,478 +392,3148 @@ uint8_t reverse(uint8_t x)
 
 //*****************************************************************************
 //
-//! Draws a pixel on the screen.
+//! Marks a range of lines as modified.
 //!
-//! \param pvDisplayData is a pointer to the driver-specific data for this
-//! display driver.
-//! \param lX is the X coordinate of the pixel.
-//! \param lY is the Y coordinate of the pixel.
-//! \param ulValue is the color of the pixel.
+//! \param lY1 is the first line of the range.
+//! \param lY2 is the last line of the range (inclusive).
 //!
-//! This function sets the given pixel to a particular color.  The coordinates
-//! of the pixel are assumed to be within the extents of the display.
+//! This function sets the dirty bit of every line from lY1 to lY2 so that the
+//! next flush sends them to the LCD. Whole words of the bitmap are written at
+//! once, so marking a full screen only touches DIRTY_ROW_WORDS words.
 //!
 //! \return None.
 //
 //*****************************************************************************
-void Sharp96x96_PixelDraw(void *pvDisplayData, int16_t lX, int16_t lY,
-                                   uint16_t ulValue)
+static void Sharp96x96_MarkRowsDirty(uint16_t lY1, uint16_t lY2)
 {
-#ifdef ROTATE_90
-	uint16_t temp = lX;
-	lX = lY;
-	lY = LCD_HORIZONTAL_MAX - temp - 1;
-#endif
+	uint16_t wi = lY1 >> 4;
+	uint16_t w_last = lY2 >> 4;
+	uint16_t first_mask = 0xFFFF << (lY1 & 0xF);
+	uint16_t last_mask = 0xFFFF >> (15 - (lY2 & 0xF));
 
+	if(wi == w_last)
+	{
+		DirtyRows[wi] |= first_mask & last_mask;
+		return;
+	}
 
-#ifdef NON_VOLATILE_MEMORY_BUFFER
-	PrepareMemoryWrite();
-#endif
+	DirtyRows[wi++] |= first_mask;
 
-	if(ClrBlack == ulValue){
-		DisplayBuffer[lY][lX>>3] &= ~(0x80 >> (lX & 0x7));
-	}else{
-		DisplayBuffer[lY][lX>>3] |= (0x80 >> (lX & 0x7));
+	while(wi < w_last)
+	{
+		DirtyRows[wi++] = 0xFFFF;
 	}
 
-#ifdef NON_VOLATILE_MEMORY_BUFFER
-	FinishMemoryWrite();
-#endif
+	DirtyRows[wi] |= last_mask;
+}
+
+//*****************************************************************************
+//
+// Edge masks of the span fill engine. A DisplayBuffer word holds 16 pixels,
+// the left-most in bit 7 of its low byte, so the masks are byte swapped.
+// SpanFirstMask[n] covers pixels n to 15 of a word and SpanLastMask[n] covers
+// pixels 0 to n.
+//
+//*****************************************************************************
+#define SWAP_MASK(m)		((uint16_t)((((m) >> 8) & 0x00FF) | (((m) << 8) & 0xFF00)))
+
+static const uint16_t SpanFirstMask[16] =
+{
+	SWAP_MASK(0xFFFF), SWAP_MASK(0x7FFF), SWAP_MASK(0x3FFF), SWAP_MASK(0x1FFF),
+	SWAP_MASK(0x0FFF), SWAP_MASK(0x07FF), SWAP_MASK(0x03FF), SWAP_MASK(0x01FF),
+	SWAP_MASK(0x00FF), SWAP_MASK(0x007F), SWAP_MASK(0x003F), SWAP_MASK(0x001F),
+	SWAP_MASK(0x000F), SWAP_MASK(0x0007), SWAP_MASK(0x0003), SWAP_MASK(0x0001)
+};
+
+static const uint16_t SpanLastMask[16] =
+{
+	SWAP_MASK(0x8000), SWAP_MASK(0xC000), SWAP_MASK(0xE000), SWAP_MASK(0xF000),
+	SWAP_MASK(0xF800), SWAP_MASK(0xFC00), SWAP_MASK(0xFE00), SWAP_MASK(0xFF00),
+	SWAP_MASK(0xFF80), SWAP_MASK(0xFFC0), SWAP_MASK(0xFFE0), SWAP_MASK(0xFFF0),
+	SWAP_MASK(0xFFF8), SWAP_MASK(0xFFFC), SWAP_MASK(0xFFFE), SWAP_MASK(0xFFFF)
+};
+
+//*****************************************************************************
+//
+//! Merges a run of 1 bit per pixel data into a DisplayBuffer line.
+//!
+//! \param pucDst is a pointer to the DisplayBuffer byte holding the first
+//! pixel of the run.
+//! \param uiShift is the bit offset of the first pixel in that byte, counted
+//! from the most significant bit.
+//! \param pucSrc is a pointer to the source data.
+//! \param uiBit is the bit offset of the first pixel in the source data,
+//! counted from the most significant bit.
+//! \param lCount is the number of pixels in the run.
+//! \param ucInk is 0xFF when set source bits are white, 0x00 when black.
+//! \param ucPaper is 0xFF when clear source bits are white, 0x00 when black.
+//! \param bOpaque is false to leave the pixels of clear source bits untouched.
+//!
+//! The source bits are shifted into place and merged a destination byte at a
+//! time, whatever the alignment of the source and the destination. Dirty
+//! lines are left to the caller.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void Sharp96x96_MergeBits(uint8_t *pucDst, uint16_t uiShift,
+                                 const uint8_t *pucSrc, uint16_t uiBit,
+                                 int16_t lCount, uint8_t ucInk, uint8_t ucPaper,
+                                 bool bOpaque)
+{
+	const uint8_t *pucByte;
+	uint8_t ucBits;
+	uint8_t ucMask;
+	uint8_t n;
+
+	while(lCount > 0)
+	{
+		// Number of pixels going into this byte of the DisplayBuffer
+		n = 8 - uiShift;
 
+		if(n > lCount)
+		{
+			n = lCount;
+		}
+
+		ucMask = (uint8_t)(0xFF << (8 - n)) >> uiShift;
+
+		// Take the next n bits of the source, left aligned
+		pucByte = pucSrc + (uiBit >> 3);
+		ucBits = pucByte[0] << (uiBit & 0x7);
+
+		if((uiBit & 0x7) + n > 8)
+		{
+			ucBits |= pucByte[1] >> (8 - (uiBit & 0x7));
+		}
+
+		ucBits >>= uiShift;
+
+		if(bOpaque)
+		{
+			ucBits = (ucBits & ucInk) | (~ucBits & ucPaper);
+		}
+		else
+		{
+			ucMask &= ucBits;
+			ucBits = ucInk;
+		}
+
+		*pucDst = (*pucDst & ~ucMask) | (ucBits & ucMask);
+		pucDst++;
+
+		uiBit += n;
+		lCount -= n;
+		uiShift = 0;
+	}
 }
+
 //*****************************************************************************
 //
-//! Draws a horizontal sequence of pixels on the screen.
+//! Reads the color of one source pixel of Sharp96x96_DrawMultiple.
 //!
-//! \param pvDisplayData is a pointer to the driver-specific data for this
-//! display driver.
-//! \param lX is the X coordinate of the first pixel.
-//! \param lY is the Y coordinate of the first pixel.
-//! \param lX0 is sub-pixel offset within the pixel data, which is valid for 1
-//! or 4 bit per pixel formats.
-//! \param lCount is the number of pixels to draw.
-//! \param lBPP is the number of bits per pixel; must be 1, 4, or 8.
-//! \param pucData is a pointer to the pixel data.  For 1 and 4 bit per pixel
-//! formats, the most significant bit(s) represent the left-most pixel.
-//! \param pucPalette is a pointer to the palette used to draw the pixels.
+//! \param pucData is a pointer to the pixel data.
+//! \param uiBit is the bit offset of the pixel in the pixel data.
+//! \param lBPP is the number of bits per pixel; 1, 2, 4 or 8.
+//! \param uiWhite has bit n set when palette entry n is white, for formats up
+//! to 4 bits per pixel.
+//! \param pucPalette is a pointer to the palette, used for 8 bits per pixel.
 //!
-//! This function draws a horizontal sequence of pixels on the screen, using
-//! the supplied palette.  For 1 bit per pixel format, the palette contains
-//! pre-translated colors; for 4 and 8 bit per pixel formats, the palette
-//! contains 24-bit RGB values that must be translated before being written to
-//! the display.
+//! \return Returns non-zero when the pixel is white.
+//
+//*****************************************************************************
+static uint16_t Sharp96x96_SourcePixel(const uint8_t *pucData, uint16_t uiBit,
+                                       int16_t lBPP, uint16_t uiWhite,
+                                       const uint32_t *pucPalette)
+{
+	uint8_t ucIndex;
+
+	if(8 == lBPP)
+	{
+		return (uint16_t)Sharp96x96_ColorTranslate(0, pucPalette[pucData[uiBit>>3]]);
+	}
+
+	ucIndex = (pucData[uiBit>>3] >> (8 - lBPP - (uiBit & 0x7))) & ((1 << lBPP) - 1);
+
+	return (uiWhite >> ucIndex) & 0x1;
+}
+
+//*****************************************************************************
+//
+//! Finds the palette entries of Sharp96x96_DrawMultiple that are white.
 //!
-//! NOTE:  This function currently does not support 90 degree rotation.
-//! A workaround for now is to rotate images 90 degrees when creating
-//! them.
+//! \param pvDisplayData is a pointer to the driver-specific data for this
+//! display driver.
+//! \param lBPP is the number of bits per pixel; 1, 2, 4 or 8.
+//! \param pucPalette is a pointer to the palette.
 //!
-//! \return None.
+//! \return Returns a bitmap with bit n set when palette entry n is white, or
+//! 0 for 8 bits per pixel, which Sharp96x96_SourcePixel() translates itself.
 //
 //*****************************************************************************
-static void Sharp96x96_DrawMultiple(void *pvDisplayData, int16_t lX,
-                                           int16_t lY, int16_t lX0, int16_t lCount,
-                                           int16_t lBPP,
-                                           const uint8_t *pucData,
-                                           const uint32_t *pucPalette)
-{  
+static uint16_t Sharp96x96_PaletteWhite(void *pvDisplayData, int16_t lBPP,
+                                        const uint32_t *pucPalette)
+{
+	uint16_t uiWhite = 0;
+	uint16_t i;
 
-	uint8_t *pData = &DisplayBuffer[lY][lX>>3];
-	uint16_t xj = 0;
+	if(lBPP < 8)
+	{
+		for(i = 0; i < (1 << lBPP); i++)
+		{
+			if(Sharp96x96_ColorTranslate(pvDisplayData, pucPalette[i]))
+			{
+				uiWhite |= 1 << i;
+			}
+		}
+	}
 
-#ifdef NON_VOLATILE_MEMORY_BUFFER
-	PrepareMemoryWrite();
-#endif
+	return uiWhite;
+}
+
+#ifdef DISPLAY_LIST
+//*****************************************************************************
+//
+// Display list. Instead of a DisplayBuffer the driver keeps the drawing calls
+// that make up the screen, in DisplayBuffer space (after any rotation), and
+// rasterizes a line from them just before it is sent. Every record starts
+// with a tListRecord header giving its type, its size in bytes and the
+// DisplayBuffer lines and columns it covers. Records are drawn in order on
+// top of DisplayListBackground.
+//
+//*****************************************************************************
+#define LIST_FILL			0	// A rectangle of one color
+#define LIST_BITS			1	// A run of 1 bit per pixel data
+#define LIST_TEXT			2	// A string in a pre-rotated font
+#define LIST_IMAGE			3	// A pre-rotated image
+
+// A DisplayBuffer column, wide enough for the 400 pixel lines of the largest
+// panel
+#if LCD_HORIZONTAL_MAX > 256
+typedef uint16_t tListColumn;
+#else
+typedef uint8_t tListColumn;
+#endif
+
+typedef struct
+{
+	uint8_t ucType;
+	uint8_t ucSize;
+	uint8_t ucTop;
+	uint8_t ucBottom;
+	tListColumn ucLeft;
+	tListColumn ucRight;
+} tListRecord;
+
+// A LIST_FILL record
+typedef struct
+{
+	tListRecord sHeader;
+	uint8_t ucFill;
+} tListFill;
+
+#ifdef ROTATE_90
+// A LIST_TEXT record, followed by the glyph index of every character
+typedef struct
+{
+	tListRecord sHeader;
+	const Sharp96x96_RotatedFont *psFont;
+	int16_t lX;
+	int16_t lY;
+	uint8_t ucInk;
+	uint8_t ucPaper;
+	uint8_t ucOpaque;
+	uint8_t ucLength;
+} tListText;
+
+// A LIST_IMAGE record
+typedef struct
+{
+	tListRecord sHeader;
+	const Sharp96x96_RotatedImage *psImage;
+	int16_t lX;
+	int16_t lY;
+} tListImage;
+#endif
+
+// A LIST_BITS record is a tListRecord followed by the pixels, white pixels
+// set, one bit per line with ROTATE_90 and one bit per column without
+
+// Records are padded to keep their pointers aligned
+#define LIST_ALIGN(n)		(((n) + sizeof(void *) - 1) & ~(sizeof(void *) - 1))
+
+static union
+{
+	uint8_t pucBytes[DISPLAY_LIST_BYTES];
+	const void *pvAlign;
+} DisplayList;
+
+static uint16_t DisplayListUsed;
+static uint16_t DisplayListPeak;
+static uint16_t DisplayListDropped;
+static uint8_t DisplayListBackground = SHARP_WHITE;
+
+//*****************************************************************************
+//
+//! Appends a record to the display list.
+//!
+//! \param ucType is the type of the record.
+//! \param uiSize is the size of the record in bytes, header included.
+//! \param ucTop is the first DisplayBuffer line covered by the record.
+//! \param ucBottom is the last DisplayBuffer line covered by the record.
+//! \param ucLeft is the first DisplayBuffer column covered by the record.
+//! \param ucRight is the last DisplayBuffer column covered by the record.
+//! \param bOpaque is true when the record sets every pixel it covers.
+//!
+//! An opaque record hides whatever was drawn inside its bounds before, so the
+//! records it covers entirely are dropped first. The covered lines are marked
+//! dirty. When the list is full the record is not added and
+//! DisplayListDropped is incremented.
+//!
+//! \return Returns a pointer to the record with its header filled in, or NULL
+//! when the list is full.
+//
+//*****************************************************************************
+static tListRecord *Sharp96x96_ListAdd(uint8_t ucType, uint16_t uiSize,
+                                       uint8_t ucTop, uint8_t ucBottom,
+                                       tListColumn ucLeft, tListColumn ucRight,
+                                       bool bOpaque)
+{
+	tListRecord *psRecord;
+	uint16_t uiOffset = 0;
+
+	uiSize = LIST_ALIGN(uiSize);
+
+	if(bOpaque)
+	{
+		while(uiOffset < DisplayListUsed)
+		{
+			psRecord = (tListRecord *)&DisplayList.pucBytes[uiOffset];
+
+			if((psRecord->ucTop >= ucTop) && (psRecord->ucBottom <= ucBottom) &&
+			   (psRecord->ucLeft >= ucLeft) && (psRecord->ucRight <= ucRight))
+			{
+				DisplayListUsed -= psRecord->ucSize;
+				memmove(psRecord, (uint8_t *)psRecord + psRecord->ucSize,
+				        DisplayListUsed - uiOffset);
+			}
+			else
+			{
+				uiOffset += psRecord->ucSize;
+			}
+		}
+	}
+
+	Sharp96x96_MarkRowsDirty(ucTop, ucBottom);
+
+	if(DisplayListUsed + uiSize > DISPLAY_LIST_BYTES)
+	{
+		DisplayListDropped++;
+		return 0;
+	}
+
+	psRecord = (tListRecord *)&DisplayList.pucBytes[DisplayListUsed];
+	DisplayListUsed += uiSize;
+
+	if(DisplayListUsed > DisplayListPeak)
+	{
+		DisplayListPeak = DisplayListUsed;
+	}
+
+	psRecord->ucType = ucType;
+	psRecord->ucSize = uiSize;
+	psRecord->ucTop = ucTop;
+	psRecord->ucBottom = ucBottom;
+	psRecord->ucLeft = ucLeft;
+	psRecord->ucRight = ucRight;
+
+	return psRecord;
+}
+
+//*****************************************************************************
+//
+//! Records the fill of a rectangle of the DisplayBuffer.
+//!
+//! \param lX1 is the first DisplayBuffer column of the rectangle.
+//! \param lX2 is the last DisplayBuffer column of the rectangle (inclusive).
+//! \param lY1 is the first DisplayBuffer line of the rectangle.
+//! \param lY2 is the last DisplayBuffer line of the rectangle (inclusive).
+//! \param ulValue is the color of the rectangle.
+//!
+//! This is the display list version of the span engine. Filling the whole
+//! screen empties the list and changes its background.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void Sharp96x96_FillSpan(uint16_t lX1, uint16_t lX2, uint16_t lY1,
+                                uint16_t lY2, uint16_t ulValue)
+{
+	uint8_t ucFill = (ClrBlack == ulValue) ? SHARP_BLACK : SHARP_WHITE;
+	tListFill *psFill;
+
+	if((lX1 == 0) && (lX2 == LCD_HORIZONTAL_MAX - 1) &&
+	   (lY1 == 0) && (lY2 == LCD_VERTICAL_MAX - 1))
+	{
+		DisplayListUsed = 0;
+		DisplayListBackground = ucFill;
+		Sharp96x96_MarkRowsDirty(0, LCD_VERTICAL_MAX - 1);
+		return;
+	}
+
+	psFill = (tListFill *)Sharp96x96_ListAdd(LIST_FILL, sizeof(tListFill),
+	                                         lY1, lY2, lX1, lX2, true);
+
+	if(psFill)
+	{
+		psFill->ucFill = ucFill;
+	}
+}
+
+//*****************************************************************************
+//
+//! Draws a horizontal sequence of pixels on the screen.
+//!
+//! \param pvDisplayData is a pointer to the driver-specific data for this
+//! display driver.
+//! \param lX is the X coordinate of the first pixel.
+//! \param lY is the Y coordinate of the first pixel.
+//! \param lX0 is sub-pixel offset within the pixel data, which is valid for 1
+//! or 4 bit per pixel formats.
+//! \param lCount is the number of pixels to draw.
+//! \param lBPP is the number of bits per pixel; must be 1, 4, or 8.
+//! \param pucData is a pointer to the pixel data.  For 1 and 4 bit per pixel
+//! formats, the most significant bit(s) represent the left-most pixel.
+//! \param pucPalette is a pointer to the palette used to draw the pixels.
+//!
+//! This is the display list version of the function. The pixels are copied
+//! into a LIST_BITS record, already translated to 1 bit per pixel, since the
+//! pixel data may not outlive the call.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void Sharp96x96_DrawMultiple(void *pvDisplayData, int16_t lX,
+                                           int16_t lY, int16_t lX0, int16_t lCount,
+                                           int16_t lBPP,
+                                           const uint8_t *pucData,
+                                           const uint32_t *pucPalette)
+{
+	tListRecord *psRecord;
+	uint16_t uiWhite;
+	uint16_t uiBit;
+	uint16_t i;
+	uint8_t *pucBits;
+
+	if(lCount <= 0)
+	{
+		return;
+	}
+
+	// Drop the compression flags, the data is uncompressed by now
+	lBPP &= 0x0F;
+
+	uiWhite = Sharp96x96_PaletteWhite(pvDisplayData, lBPP, pucPalette);
+
+	// Bit offset of the first pixel in the pixel data
+	uiBit = (8 == lBPP) ? 0 : lX0 * lBPP;
+
+#ifdef ROTATE_90
+	// Screen X runs up the DisplayBuffer lines
+	psRecord = Sharp96x96_ListAdd(LIST_BITS, sizeof(tListRecord) + ((lCount + 7) >> 3),
+	                              RotatedLine(lX + lCount - 1),
+	                              RotatedLine(lX), lY, lY, true);
+#else
+	psRecord = Sharp96x96_ListAdd(LIST_BITS, sizeof(tListRecord) + ((lCount + 7) >> 3),
+	                              lY, lY, lX, lX + lCount - 1, true);
+#endif
+
+	if(!psRecord)
+	{
+		return;
+	}
+
+	pucBits = (uint8_t *)(psRecord + 1);
+	memset(pucBits, 0, (lCount + 7) >> 3);
+
+	for(i = 0; i < lCount; i++, uiBit += lBPP)
+	{
+		if(Sharp96x96_SourcePixel(pucData, uiBit, lBPP, uiWhite, pucPalette))
+		{
+			pucBits[i >> 3] |= 0x80 >> (i & 0x7);
+		}
+	}
+}
+
+#ifdef ROTATE_90
+//*****************************************************************************
+//
+//! Records a string drawn with a pre-rotated font.
+//!
+//! \param context is a pointer to the drawing context to use.
+//! \param psFont is a pointer to the rotated version of the context font.
+//! \param string is a pointer to the string to be drawn.
+//! \param lLength is the number of characters from the string that should be
+//! drawn on the screen, or AUTO_STRING_LENGTH to draw up to the end of it.
+//! \param x is the X coordinate of the upper left corner of the string.
+//! \param y is the Y coordinate of the upper left corner of the string.
+//! \param bOpaque is true if the background of each character should be
+//! drawn.
+//!
+//! Only the characters inside the clip region are kept, as glyph indexes, so
+//! a record costs sizeof(tListText) plus a byte per visible character.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void Sharp96x96_ListText(const Graphics_Context *context,
+                                const Sharp96x96_RotatedFont *psFont,
+                                const uint8_t *string, int32_t lLength,
+                                int16_t x, int16_t y, bool bOpaque)
+{
+	const Graphics_Rectangle *pClip = &context->clipRegion;
+	tListText *psText;
+	uint8_t *pucText;
+	int16_t lX1, lX2, lY1, lY2;
+	uint16_t uiFirst;
+	uint16_t uiCount;
+	uint16_t i;
+	uint8_t ucChar;
+
+	for(uiCount = 0; ((int32_t)uiCount != lLength) && string[uiCount]; uiCount++)
+	{
+	}
+
+	lX1 = x;
+	lX2 = x + uiCount * psFont->width - 1;
+	lY1 = y;
+	lY2 = y + psFont->height - 1;
+
+	if(lX1 < pClip->xMin) lX1 = pClip->xMin;
+	if(lX2 > pClip->xMax) lX2 = pClip->xMax;
+	if(lY1 < pClip->yMin) lY1 = pClip->yMin;
+	if(lY2 > pClip->yMax) lY2 = pClip->yMax;
+
+	if((lX1 > lX2) || (lY1 > lY2))
+	{
+		return;
+	}
+
+	uiFirst = (lX1 - x) / psFont->width;
+	uiCount = (lX2 - x) / psFont->width - uiFirst + 1;
+
+	psText = (tListText *)Sharp96x96_ListAdd(LIST_TEXT, sizeof(tListText) + uiCount,
+	                                         RotatedLine(lX2), RotatedLine(lX1),
+	                                         lY1, lY2, bOpaque);
+
+	if(!psText)
+	{
+		return;
+	}
+
+	psText->psFont = psFont;
+	psText->lX = x + uiFirst * psFont->width;
+	psText->lY = y;
+	psText->ucInk = context->foreground ? 0xFF : 0x00;
+	psText->ucPaper = context->background ? 0xFF : 0x00;
+	psText->ucOpaque = bOpaque;
+	psText->ucLength = uiCount;
+
+	pucText = (uint8_t *)(psText + 1);
+
+	for(i = 0; i < uiCount; i++)
+	{
+		ucChar = string[uiFirst + i];
+
+		// Characters without a glyph are drawn as a period, like grlib does
+		if((ucChar < ' ') || (ucChar > 0x7F))
+		{
+			ucChar = '.';
+		}
+
+		pucText[i] = ucChar - ' ';
+	}
+}
+
+//*****************************************************************************
+//
+//! Records a pre-rotated image.
+//!
+//! \param context is a pointer to the drawing context to use.
+//! \param image is a pointer to the image.
+//! \param x is the X coordinate of the upper left corner of the image.
+//! \param y is the Y coordinate of the upper left corner of the image.
+//!
+//! The image data stays in flash, the record only points to it.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void Sharp96x96_ListImage(const Graphics_Context *context,
+                                 const Sharp96x96_RotatedImage *image,
+                                 int16_t x, int16_t y)
+{
+	const Graphics_Rectangle *pClip = &context->clipRegion;
+	tListImage *psImage;
+	int16_t lX1 = x;
+	int16_t lX2 = x + image->width - 1;
+	int16_t lY1 = y;
+	int16_t lY2 = y + image->height - 1;
+
+	if(lX1 < pClip->xMin) lX1 = pClip->xMin;
+	if(lX2 > pClip->xMax) lX2 = pClip->xMax;
+	if(lY1 < pClip->yMin) lY1 = pClip->yMin;
+	if(lY2 > pClip->yMax) lY2 = pClip->yMax;
+
+	if((lX1 > lX2) || (lY1 > lY2))
+	{
+		return;
+	}
+
+	psImage = (tListImage *)Sharp96x96_ListAdd(LIST_IMAGE, sizeof(tListImage),
+	                                           RotatedLine(lX2), RotatedLine(lX1),
+	                                           lY1, lY2, true);
+
+	if(psImage)
+	{
+		psImage->psImage = image;
+		psImage->lX = x;
+		psImage->lY = y;
+	}
+}
+#endif //ROTATE_90
+
+//*****************************************************************************
+//
+//! Rasterizes one DisplayBuffer line from the display list.
+//!
+//! \param ucLine is the DisplayBuffer line to rasterize.
+//! \param puiLine is a pointer to the LCD_HORIZONTAL_MAX/16 words receiving
+//! the line, in DisplayBuffer format.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void Sharp96x96_ListRasterize(uint8_t ucLine, uint16_t *puiLine)
+{
+	const tListRecord *psRecord;
+	const uint8_t *pucBits;
+	uint8_t *pucLine = (uint8_t *)puiLine;
+	uint16_t uiFill;
+	uint16_t uiMask;
+	uint16_t uiOffset;
+	uint16_t wi;
+#ifdef ROTATE_90
+	const tListText *psText;
+	const tListImage *psImage;
+	const Sharp96x96_RotatedFont *psFont;
+	uint16_t uiColumn;
+#endif
+
+	uiFill = (SHARP_BLACK == DisplayListBackground) ? 0x0000 : 0xFFFF;
+
+	for(wi = 0; wi < (LCD_HORIZONTAL_MAX>>4); wi++)
+	{
+		puiLine[wi] = uiFill;
+	}
+
+	for(uiOffset = 0; uiOffset < DisplayListUsed; uiOffset += psRecord->ucSize)
+	{
+		psRecord = (const tListRecord *)&DisplayList.pucBytes[uiOffset];
+
+		if((ucLine < psRecord->ucTop) || (ucLine > psRecord->ucBottom))
+		{
+			continue;
+		}
+
+		switch(psRecord->ucType)
+		{
+		case LIST_FILL:
+			uiFill = (SHARP_BLACK == ((const tListFill *)psRecord)->ucFill) ? 0x0000 : 0xFFFF;
+			uiMask = SpanFirstMask[psRecord->ucLeft & 0xF];
+
+			for(wi = psRecord->ucLeft >> 4; wi <= (psRecord->ucRight >> 4); wi++)
+			{
+				if(wi == (psRecord->ucRight >> 4))
+				{
+					uiMask &= SpanLastMask[psRecord->ucRight & 0xF];
+				}
+
+				puiLine[wi] = (puiLine[wi] & ~uiMask) | (uiFill & uiMask);
+				uiMask = 0xFFFF;
+			}
+			break;
+
+		case LIST_BITS:
+			pucBits = (const uint8_t *)(psRecord + 1);
+#ifdef ROTATE_90
+			// One pixel of a column, the first bit is the bottom line
+			wi = psRecord->ucBottom - ucLine;
+
+			if(pucBits[wi >> 3] & (0x80 >> (wi & 0x7)))
+			{
+				pucLine[psRecord->ucLeft >> 3] |= 0x80 >> (psRecord->ucLeft & 0x7);
+			}
+			else
+			{
+				pucLine[psRecord->ucLeft >> 3] &= ~(0x80 >> (psRecord->ucLeft & 0x7));
+			}
+#else
+			Sharp96x96_MergeBits(&pucLine[psRecord->ucLeft >> 3], psRecord->ucLeft & 0x7,
+			                     pucBits, 0, psRecord->ucRight - psRecord->ucLeft + 1,
+			                     0xFF, 0x00, true);
+#endif
+			break;
+
+#ifdef ROTATE_90
+		case LIST_TEXT:
+			psText = (const tListText *)psRecord;
+			psFont = psText->psFont;
+			pucBits = (const uint8_t *)(psText + 1);
+
+			// The column of the string on this line, RotatedLine() being its
+			// own inverse
+			uiColumn = RotatedLine(ucLine) - psText->lX;
+
+			pucBits = psFont->data +
+			          (pucBits[uiColumn / psFont->width] * psFont->width +
+			           uiColumn % psFont->width) * ((psFont->height + 7) >> 3);
+
+			Sharp96x96_MergeBits(&pucLine[psRecord->ucLeft >> 3], psRecord->ucLeft & 0x7,
+			                     pucBits, psRecord->ucLeft - psText->lY,
+			                     psRecord->ucRight - psRecord->ucLeft + 1,
+			                     psText->ucInk, psText->ucPaper, psText->ucOpaque);
+			break;
+
+		case LIST_IMAGE:
+			psImage = (const tListImage *)psRecord;
+
+			uiColumn = RotatedLine(ucLine) - psImage->lX;
+
+			pucBits = psImage->psImage->data +
+			          uiColumn * ((psImage->psImage->height + 7) >> 3);
+
+			Sharp96x96_MergeBits(&pucLine[psRecord->ucLeft >> 3], psRecord->ucLeft & 0x7,
+			                     pucBits, psRecord->ucLeft - psImage->lY,
+			                     psRecord->ucRight - psRecord->ucLeft + 1,
+			                     0xFF, 0x00, true);
+			break;
+#endif
+
+		default:
+			break;
+		}
+	}
+}
+
+//*****************************************************************************
+//
+//! Reads the size of the display list.
+//!
+//! \return Returns the largest number of bytes the display list has held, to
+//! size DISPLAY_LIST_BYTES.
+//
+//*****************************************************************************
+uint16_t Sharp96x96_DisplayListPeak(void)
+{
+	return DisplayListPeak;
+}
+
+//*****************************************************************************
+//
+//! Reads the number of drawing calls lost to a full display list.
+//!
+//! \return Returns the number of records that did not fit in the display list.
+//
+//*****************************************************************************
+uint16_t Sharp96x96_DisplayListDropped(void)
+{
+	return DisplayListDropped;
+}
+#else
+//*****************************************************************************
+//
+//! Fills a rectangle of the DisplayBuffer.
+//!
+//! \param lX1 is the first DisplayBuffer column of the rectangle.
+//! \param lX2 is the last DisplayBuffer column of the rectangle (inclusive).
+//! \param lY1 is the first DisplayBuffer line of the rectangle.
+//! \param lY2 is the last DisplayBuffer line of the rectangle (inclusive).
+//! \param ulValue is the color of the rectangle.
+//!
+//! This function is the span engine behind the line and rectangle primitives.
+//! The coordinates are in DisplayBuffer space, after any rotation. The color
+//! is turned into a fill word once, the partial words at both edges are merged
+//! through precomputed masks and the words in between are written whole.
+//! Spans covering the full width of the buffer skip the edge handling. With
+//! SCROLL_BUFFER a range of lines that wraps around the end of the ring is
+//! filled in two parts.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void Sharp96x96_FillSpan(uint16_t lX1, uint16_t lX2, uint16_t lY1,
+                                uint16_t lY2, uint16_t ulValue)
+{
+	uint16_t *puiData = (uint16_t *)DisplayRow(lY1);
+	uint16_t uiRows;
+	uint16_t uiFill = (ClrBlack == ulValue) ? 0x0000 : 0xFFFF;
+	uint16_t uiFirstMask, uiLastMask;
+	uint16_t uiWords;
+	uint16_t *puiWord;
+	uint16_t wi;
+
+#ifdef SCROLL_BUFFER
+	// The lines past the end of the ring are filled separately
+	if(DisplayLine(lY1) > DisplayLine(lY2))
+	{
+		Sharp96x96_FillSpan(lX1, lX2, LCD_VERTICAL_MAX - ScrollOffset, lY2,
+		                    ulValue);
+		lY2 = LCD_VERTICAL_MAX - ScrollOffset - 1;
+	}
+#endif
+
+	uiRows = lY2 - lY1 + 1;
+
+	if((lX1 == 0) && (lX2 == LCD_HORIZONTAL_MAX - 1))
+	{
+		// Full lines
+		while(uiRows--)
+		{
+			for(wi = 0; wi < (LCD_HORIZONTAL_MAX>>4); wi++)
+			{
+				puiData[wi] = uiFill;
+			}
+
+			puiData += DISPLAY_STRIDE>>1;
+		}
+
+		return;
+	}
+
+	puiData += lX1>>4;
+	uiWords = (lX2>>4) - (lX1>>4);
+	uiFirstMask = SpanFirstMask[lX1 & 0xF];
+	uiLastMask = SpanLastMask[lX2 & 0xF];
+
+	if(!uiWords)
+	{
+		// The span fits in a single word
+		uiFirstMask &= uiLastMask;
+
+		while(uiRows--)
+		{
+			*puiData = (*puiData & ~uiFirstMask) | (uiFill & uiFirstMask);
+			puiData += DISPLAY_STRIDE>>1;
+		}
+
+		return;
+	}
+
+	while(uiRows--)
+	{
+		puiWord = puiData;
+
+		*puiWord = (*puiWord & ~uiFirstMask) | (uiFill & uiFirstMask);
+		puiWord++;
+
+		for(wi = 1; wi < uiWords; wi++)
+		{
+			*puiWord++ = uiFill;
+		}
+
+		*puiWord = (*puiWord & ~uiLastMask) | (uiFill & uiLastMask);
+
+		puiData += DISPLAY_STRIDE>>1;
+	}
+}
+
+#endif //DISPLAY_LIST
+
+//*****************************************************************************
+//
+//! Draws a pixel on the screen.
+//!
+//! \param pvDisplayData is a pointer to the driver-specific data for this
+//! display driver.
+//! \param lX is the X coordinate of the pixel.
+//! \param lY is the Y coordinate of the pixel.
+//! \param ulValue is the color of the pixel.
+//!
+//! This function sets the given pixel to a particular color.  The coordinates
+//! of the pixel are assumed to be within the extents of the display.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void Sharp96x96_PixelDraw(void *pvDisplayData, int16_t lX, int16_t lY,
+                                   uint16_t ulValue)
+{
+#ifdef ROTATE_90
+	uint16_t temp = lX;
+	lX = lY;
+	lY = RotatedLine(temp);
+#endif
+
+
+#ifdef NON_VOLATILE_MEMORY_BUFFER
+	PrepareMemoryWrite();
+#endif
+
+#ifdef DISPLAY_LIST
+	Sharp96x96_FillSpan(lX, lX, lY, lY, ulValue);
+#else
+	if(ClrBlack == ulValue){
+		DisplayRow(lY)[lX>>3] &= ~(0x80 >> (lX & 0x7));
+	}else{
+		DisplayRow(lY)[lX>>3] |= (0x80 >> (lX & 0x7));
+	}
+
+	MarkRowDirty(lY);
+#endif
+
+#ifdef NON_VOLATILE_MEMORY_BUFFER
+	FinishMemoryWrite();
+#endif
+
+}
+
+#ifndef DISPLAY_LIST
+//*****************************************************************************
+//
+//! Draws a horizontal sequence of pixels on the screen.
+//!
+//! \param pvDisplayData is a pointer to the driver-specific data for this
+//! display driver.
+//! \param lX is the X coordinate of the first pixel.
+//! \param lY is the Y coordinate of the first pixel.
+//! \param lX0 is sub-pixel offset within the pixel data, which is valid for 1
+//! or 4 bit per pixel formats.
+//! \param lCount is the number of pixels to draw.
+//! \param lBPP is the number of bits per pixel; must be 1, 4, or 8.
+//! \param pucData is a pointer to the pixel data.  For 1 and 4 bit per pixel
+//! formats, the most significant bit(s) represent the left-most pixel.
+//! \param pucPalette is a pointer to the palette used to draw the pixels.
+//!
+//! This function draws a horizontal sequence of pixels on the screen, using
+//! the supplied palette.  For 1 bit per pixel format, the palette contains
+//! pre-translated colors; for 4 and 8 bit per pixel formats, the palette
+//! contains 24-bit RGB values that must be translated before being written to
+//! the display. 2 bit per pixel data is handled like 4 bit per pixel data.
+//!
+//! 1 bit per pixel data drawn without rotation goes through
+//! Sharp96x96_MergeBits(), a byte at a time. Other formats are converted to a
+//! byte of pixels before being merged. With ROTATE_90 the sequence is a column
+//! of the DisplayBuffer and is written one line at a time.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void Sharp96x96_DrawMultiple(void *pvDisplayData, int16_t lX,
+                                           int16_t lY, int16_t lX0, int16_t lCount,
+                                           int16_t lBPP,
+                                           const uint8_t *pucData,
+                                           const uint32_t *pucPalette)
+{
+	uint16_t uiWhite;
+	uint16_t uiBit;
+	uint16_t i;
+	uint8_t *pucDst;
+	uint8_t ucMask;
+#ifndef ROTATE_90
+	uint16_t uiShift;
+	uint8_t ucBits;
+	uint8_t n;
+#endif
+
+	if(lCount <= 0)
+	{
+		return;
+	}
+
+	// Drop the compression flags, the data is uncompressed by now
+	lBPP &= 0x0F;
+
+	uiWhite = Sharp96x96_PaletteWhite(pvDisplayData, lBPP, pucPalette);
+
+	// Bit offset of the first pixel in the pixel data
+	uiBit = (8 == lBPP) ? 0 : lX0 * lBPP;
+
+#ifdef NON_VOLATILE_MEMORY_BUFFER
+	PrepareMemoryWrite();
+#endif
+
+#ifdef ROTATE_90
+	// Screen X runs up the DisplayBuffer lines, screen Y along a line
+	pucDst = &DisplayRow(RotatedLine(lX))[lY>>3];
+	ucMask = 0x80 >> (lY & 0x7);
+
+	for(i = lCount; i; i--, uiBit += lBPP)
+	{
+		if(Sharp96x96_SourcePixel(pucData, uiBit, lBPP, uiWhite, pucPalette))
+		{
+			*pucDst |= ucMask;
+		}
+		else
+		{
+			*pucDst &= ~ucMask;
+		}
+
+#ifdef SCROLL_BUFFER
+		// The line before the first one of the ring is its last one
+		if(pucDst < DisplaySlot(1))
+		{
+			pucDst += LCD_VERTICAL_MAX * DISPLAY_STRIDE;
+		}
+#endif
+
+		pucDst -= DISPLAY_STRIDE;
+	}
+
+	Sharp96x96_MarkRowsDirty(RotatedLine(lX + lCount - 1), RotatedLine(lX));
+#else
+	pucDst = &DisplayRow(lY)[lX>>3];
+	uiShift = lX & 0x7;
+
+	if(1 == lBPP)
+	{
+		// Palette entry 1 is the ink, entry 0 the paper
+		Sharp96x96_MergeBits(pucDst, uiShift, pucData, uiBit, lCount,
+		                     (uiWhite & 0x2) ? 0xFF : 0x00,
+		                     (uiWhite & 0x1) ? 0xFF : 0x00, true);
+
+		lCount = 0;
+	}
+
+	while(lCount > 0)
+	{
+		// Number of pixels going into this byte of the DisplayBuffer
+		n = 8 - uiShift;
+
+		if(n > lCount)
+		{
+			n = lCount;
+		}
+
+		ucMask = (uint8_t)(0xFF << (8 - n)) >> uiShift;
+		ucBits = 0;
+
+		for(i = 0x80 >> uiShift; i & ucMask; i >>= 1, uiBit += lBPP)
+		{
+			if(Sharp96x96_SourcePixel(pucData, uiBit, lBPP, uiWhite, pucPalette))
+			{
+				ucBits |= i;
+			}
+		}
+
+		*pucDst = (*pucDst & ~ucMask) | (ucBits & ucMask);
+		pucDst++;
+
+		lCount -= n;
+		uiShift = 0;
+	}
+
+	MarkRowDirty(lY);
+#endif
+
+#ifdef NON_VOLATILE_MEMORY_BUFFER
+	FinishMemoryWrite();
+#endif
+}
+#endif //DISPLAY_LIST
+
+//*****************************************************************************
+//
+//! Draws a horizontal line.
+//!
+//! \param pvDisplayData is a pointer to the driver-specific data for this
+//! display driver.
+//! \param lX1 is the X coordinate of the start of the line.
+//! \param lX2 is the X coordinate of the end of the line.
+//! \param lY is the Y coordinate of the line.
+//! \param ulValue is the color of the line.
+//!
+//! This function draws a horizontal line on the display.  The coordinates of
+//! the line are assumed to be within the extents of the display.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void Sharp96x96_LineDrawH(void *pvDisplayData, int16_t lX1, int16_t lX2,
+                                   int16_t lY, uint16_t ulValue)
+{
+#ifdef ROTATE_90
+	uint16_t temp = lX1;
+	lX1 = lX2;
+	lX2 = lY;
+	lY = RotatedLine(temp);
+#endif
+
+#ifdef NON_VOLATILE_MEMORY_BUFFER
+	PrepareMemoryWrite();
+#endif
+
+	Sharp96x96_FillSpan(lX1, lX2, lY, lY, ulValue);
+
+	MarkRowDirty(lY);
+
+#ifdef NON_VOLATILE_MEMORY_BUFFER
+	FinishMemoryWrite();
+#endif
+}
+
+
+//*****************************************************************************
+//
+//! Draws a vertical line.
+//!
+//! \param pvDisplayData is a pointer to the driver-specific data for this
+//! display driver.
+//! \param lX is the X coordinate of the line.
+//! \param lY1 is the Y coordinate of the start of the line.
+//! \param lY2 is the Y coordinate of the end of the line.
+//! \param ulValue is the color of the line.
+//!
+//! This function draws a vertical line on the display.  The coordinates of the
+//! line are assumed to be within the extents of the display.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void Sharp96x96_LineDrawV(void *pvDisplayData, int16_t lX, int16_t lY1,
+                                   int16_t lY2, uint16_t ulValue)
+{
+#ifdef ROTATE_90
+	uint16_t temp = lY2;
+	lY2 = RotatedLine(lX);
+	lY1 = RotatedLine(lY1);
+	lX = temp;
+#endif
+#if defined(DISPLAY_LIST)
+	Sharp96x96_FillSpan(lX, lX, lY1, lY2, ulValue);
+#elif defined(SCROLL_BUFFER)
+	// The lines may wrap around the end of the ring, which the span engine
+	// handles
+#ifdef NON_VOLATILE_MEMORY_BUFFER
+	PrepareMemoryWrite();
+#endif
+
+	Sharp96x96_FillSpan(lX, lX, lY1, lY2, ulValue);
+
+	Sharp96x96_MarkRowsDirty(lY1, lY2);
+
+#ifdef NON_VOLATILE_MEMORY_BUFFER
+	FinishMemoryWrite();
+#endif
+#else
+	uint16_t yi;
+	uint8_t *pucData = &DisplayRow(lY1)[lX>>3];
+	uint8_t data_byte;
+
+#ifdef NON_VOLATILE_MEMORY_BUFFER
+	PrepareMemoryWrite();
+#endif
+
+	//calculate data byte
+	//mod by 8 and shift this # bits
+	data_byte = (0x80 >> (lX & 0x7));
+
+	//write data to the display buffer
+	//black pixels (clear bits)
+	if(ClrBlack == ulValue)
+	{
+		data_byte = ~data_byte;
+
+		for(yi = lY1; yi <= lY2; yi++)
+		{
+			*pucData &= data_byte;
+			pucData += DISPLAY_STRIDE;
+		}
+	}
+	//white pixels (set bits)
+	else
+	{
+		for(yi = lY1; yi <= lY2; yi++)
+		{
+			*pucData |= data_byte;
+			pucData += DISPLAY_STRIDE;
+		}
+	}
+
+	Sharp96x96_MarkRowsDirty(lY1, lY2);
+
+#ifdef NON_VOLATILE_MEMORY_BUFFER
+	FinishMemoryWrite();
+#endif
+#endif //DISPLAY_LIST
+}
+
+//*****************************************************************************
+//
+//! Fills a rectangle.
+//!
+//! \param pvDisplayData is a pointer to the driver-specific data for this
+//! display driver.
+//! \param pRect is a pointer to the structure describing the rectangle.
+//! \param ulValue is the color of the rectangle.
+//!
+//! This function fills a rectangle on the display.  The coordinates of the
+//! rectangle are assumed to be within the extents of the display, and the
+//! rectangle specification is fully inclusive (in other words, both sXMin and
+//! sXMax are drawn, along with sYMin and sYMax).
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void Sharp96x96_RectFill(void *pvDisplayData, const tRectangle *pRect,
+                                  uint16_t ulValue)
+{
+#ifdef ROTATE_90
+	// Make a new rectangle with transposed coordinates
+	tRectangle tempRect = *pRect;
+
+	tempRect.sXMin = pRect->sYMin;
+	tempRect.sXMax = pRect->sYMax;
+	tempRect.sYMin = RotatedLine(pRect->sXMax);
+	tempRect.sYMax = RotatedLine(pRect->sXMin);
+
+	// Set the pointer to the rectangle to the transposed version
+	pRect = &tempRect;
+#endif
+
+#ifdef NON_VOLATILE_MEMORY_BUFFER
+	PrepareMemoryWrite();
+#endif
+
+	Sharp96x96_FillSpan(pRect->sXMin, pRect->sXMax, pRect->sYMin, pRect->sYMax,
+	                    ulValue);
+
+	Sharp96x96_MarkRowsDirty(pRect->sYMin, pRect->sYMax);
+
+#ifdef NON_VOLATILE_MEMORY_BUFFER
+	FinishMemoryWrite();
+#endif
+}
+
+//*****************************************************************************
+//
+//! Translates a 24-bit RGB color to a display driver-specific color.
+//!
+//! \param pvDisplayData is a pointer to the driver-specific data for this
+//! display driver.
+//! \param ulValue is the 24-bit RGB color.  The least-significant byte is the
+//! blue channel, the next byte is the green channel, and the third byte is the
+//! red channel.
+//!
+//! This function translates a 24-bit RGB color into a value that can be
+//! written into the display's frame buffer in order to reproduce that color,
+//! or the closest possible approximation of that color.
+//!
+//! \return Returns the display-driver specific color.
+//
+//*****************************************************************************
+static uint32_t Sharp96x96_ColorTranslate(void *pvDisplayData,
+                                          uint32_t ulValue)
+{
+    //
+    // Translate from a 24-bit RGB color to mono color.
+    //
+    return(DPYCOLORTRANSLATE(ulValue));
+}
+
+
+//*****************************************************************************
+//
+//! Sends one line of the DisplayBuffer to the LCD.
+//!
+//! \param ucLine is the LCD line to send.
+//!
+//! This function writes the line address, the line data and the line trailer
+//! of a multiple line write. It must be called between the write line command
+//! byte and the final trailer byte of a transaction.
+//!
+//! With DISPLAY_LIST the line is first rasterized from the display list.
+//!
+//! \return None.
+//
+//*****************************************************************************
+#if !defined(USE_DMA_FLUSH) && !defined(WIRE_FORMAT_BUFFER)
+static void Sharp96x96_SendLine(uint8_t ucLine)
+{
+	const uint8_t *pucData;
+	const uint8_t *pucLine;
+	uint8_t xi;
+#ifdef DISPLAY_LIST
+	uint16_t puiLine[LCD_HORIZONTAL_MAX>>4];
+
+	Sharp96x96_ListRasterize(ucLine, puiLine);
+	pucLine = (const uint8_t *)puiLine;
+#else
+	pucLine = DisplayRow(ucLine);
+#endif
+
+#ifdef LANDSCAPE
+	pucData = pucLine;
+
+	WriteCmdData(reverse(ucLine + 1));
+
+	for(xi=0; xi<(LCD_HORIZONTAL_MAX>>3); xi++)
+	{
+		WriteCmdData(*(pucData++));
+	}
+#endif
+#ifdef LANDSCAPE_FLIP
+	pucData = &pucLine[(LCD_HORIZONTAL_MAX>>3)-1];
+
+	WriteCmdData(reverse(LCD_VERTICAL_MAX - ucLine));
+
+	for(xi=0; xi<(LCD_HORIZONTAL_MAX>>3); xi++)
+	{
+		WriteCmdData(reverse(*pucData--));
+	}
+#endif
+	WriteCmdData(SHARP_LCD_TRAILER_BYTE);
+}
+#endif
+
+#ifdef WIRE_FORMAT_BUFFER
+//*****************************************************************************
+//
+//! Sends the changed lines of a wire format DisplayBuffer to the LCD.
+//!
+//! \param ucCommand is the write line command byte, including the VCOM bit.
+//!
+//! The range from the first to the last dirty line is sent as one linear
+//! block, unchanged lines in between included. The bytes just outside the
+//! range, the trailer of the line before and the address of the line after,
+//! temporarily hold the command byte and the frame trailer so that the block
+//! is a complete transaction.
+//!
+//! With SCROLL_BUFFER the block is a range of DisplayBuffer lines, whose
+//! address bytes hold the LCD lines they show. A range of LCD lines that wraps
+//! around the end of the ring is sent as the whole DisplayBuffer.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void Sharp96x96_SendWireFrame(uint8_t ucCommand)
+{
+	uint16_t wi;
+	uint16_t bits;
+	uint16_t uiSize;
+	uint8_t line;
+	uint8_t first = LCD_VERTICAL_MAX;
+	uint8_t last = 0;
+	uint8_t *pucFrame;
+#ifndef DOUBLE_BUFFER
+	uint8_t ucNextAddress;
+#endif
+
+	for(wi=0; wi<DIRTY_ROW_WORDS; wi++)
+	{
+		bits = DirtyRows[wi];
+		DirtyRows[wi] = 0;
+
+		for(line = wi << 4; bits; line++, bits >>= 1)
+		{
+			if(bits & 0x1)
+			{
+				if(line < first)
+				{
+					first = line;
+				}
+				last = line;
+			}
+		}
+	}
+
+#ifdef SCROLL_BUFFER
+	first = DisplayLine(first);
+	last = DisplayLine(last);
+
+	if(first > last)
+	{
+		first = 0;
+		last = LCD_VERTICAL_MAX - 1;
+	}
+#endif
+
+	uiSize = (last - first + 1) * SHARP_WIRE_LINE_BYTES;
+
+#ifdef DOUBLE_BUFFER
+	// Snapshot the address, data and trailer bytes of the range
+	memcpy(&FrontBuffer[1 + first*SHARP_WIRE_LINE_BYTES], DisplaySlot(first) - 1, uiSize);
+	pucFrame = &FrontBuffer[first*SHARP_WIRE_LINE_BYTES];
+#else
+	pucFrame = &DisplayBuffer[first*SHARP_WIRE_LINE_BYTES];
+#endif
+
+	uiSize += 2;
+#ifndef DOUBLE_BUFFER
+	ucNextAddress = pucFrame[uiSize - 1];
+#endif
+	pucFrame[0] = ucCommand;
+	pucFrame[uiSize - 1] = SHARP_LCD_TRAILER_BYTE;
+
+#ifdef USE_DMA_FLUSH
+	Sharp96x96_DmaSendBlock(pucFrame, uiSize, Sharp96x96_FrameDone);
+
+#ifdef DOUBLE_BUFFER
+	// The FrontBuffer bytes around the range are rewritten by the next snapshot
+	// that covers them, so there is nothing to put back
+	return;
+#else
+	// Sleep in LPM0 until the DMA ISR has closed the transaction
+	Sharp96x96_DmaWaitIdle();
+#endif
+#else
+	AssertCS();
+
+	for(wi=0; wi<uiSize; wi++)
+	{
+		WriteCmdData(pucFrame[wi]);
+	}
+
+	// Wait for last byte to be sent, then drop SCS
+	WaitUntilLcdWriteFinished();
+
+	// Ensure a 2us min delay to meet the LCD's thSCS
+	__delay_cycles(SYSTEM_CLOCK_SPEED * 0.000002);
+
+	DeassertCS();
+#endif //USE_DMA_FLUSH
+
+#ifndef DOUBLE_BUFFER
+	// Put back the trailer and address bytes of the neighbouring lines
+	pucFrame[0] = SHARP_LCD_TRAILER_BYTE;
+	pucFrame[uiSize - 1] = ucNextAddress;
+#endif
+}
+#endif //WIRE_FORMAT_BUFFER
+
+//*****************************************************************************
+//
+//! Flushes any cached drawing operations.
+//!
+//! \param pvDisplayData is a pointer to the driver-specific data for this
+//! display driver.
+//!
+//!
+//! This functions flushes any cached drawing operations to the display.  This
+//! is useful when a local frame buffer is used for drawing operations, and the
+//! flush would copy the local frame buffer to the display.
+//!
+//! Only the lines marked in the dirty line bitmap are sent. They all go out
+//! in a single multiple line write, and the transaction is skipped entirely
+//! when nothing has changed since the previous flush.
+//!
+//! With USE_DMA_FLUSH the transaction is handed to the DMA engine and the CPU
+//! sleeps in LPM0 until the DMA ISR has released the chip select.
+//!
+//! With DOUBLE_BUFFER the changed lines are copied to the FrontBuffer and the
+//! function returns as soon as the DMA frame has started. Only one frame can
+//! be in flight, so a flush issued before the previous frame has completed
+//! first sleeps until it has.
+//!
+//! With WIRE_FORMAT_BUFFER the range of changed lines is sent as a single
+//! block straight out of the buffer.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void Sharp96x96_Flush (void *pvDisplayData)
+{
+	uint16_t wi;
+	uint16_t dirty = 0;
+#if !defined(WIRE_FORMAT_BUFFER) && (!defined(USE_DMA_FLUSH) || defined(DOUBLE_BUFFER))
+	uint16_t bits;
+	uint8_t line;
+#endif
+	//image update mode(1X000000b)
+	uint8_t command = SHARP_LCD_CMD_WRITE_LINE;
+
+#ifdef USE_DMA_FLUSH
+	// Only one frame can be in flight, and its line bitmap is reused below
+	Sharp96x96_DmaWaitIdle();
+#endif
+
+	for(wi=0; wi<DIRTY_ROW_WORDS; wi++)
+	{
+		dirty |= DirtyRows[wi];
+	}
+
+	// The LCD already shows the contents of the DisplayBuffer
+	if(!dirty)
+	{
+		return;
+	}
+
+	//COM inversion bit
+	command = Sharp96x96_OpenFrame(command);
+
+#if defined(WIRE_FORMAT_BUFFER)
+	Sharp96x96_SendWireFrame(command);
+#elif defined(USE_DMA_FLUSH)
+	for(wi=0; wi<DIRTY_ROW_WORDS; wi++)
+	{
+		FlushRows[wi] = DirtyRows[wi];
+		DirtyRows[wi] = 0;
+	}
+
+#ifdef DOUBLE_BUFFER
+	for(wi=0; wi<DIRTY_ROW_WORDS; wi++)
+	{
+		bits = FlushRows[wi];
+
+		for(line = wi << 4; bits; line++, bits >>= 1)
+		{
+			if(bits & 0x1)
+			{
+				memcpy(FrontBuffer[line], DisplayRow(line), LCD_HORIZONTAL_MAX>>3);
+			}
+		}
+	}
+#endif
+
+#ifdef DOUBLE_BUFFER
+	// Drawing goes on in the DisplayBuffer while the DMA ISR sends the frame
+	Sharp96x96_DmaSendLines(command, &FrontBuffer[0][0], 0, FlushRows,
+	                        Sharp96x96_FrameDone);
+#else
+	Sharp96x96_DmaSendLines(command, &DisplayBuffer[0][0], DisplayLine(0),
+	                        FlushRows, Sharp96x96_FrameDone);
+
+	// Sleep in LPM0 until the DMA ISR has closed the transaction
+	Sharp96x96_DmaWaitIdle();
+#endif
+#else
+	AssertCS();
+
+	WriteCmdData(command);
+
+	for(wi=0; wi<DIRTY_ROW_WORDS; wi++)
+	{
+		bits = DirtyRows[wi];
+		DirtyRows[wi] = 0;
+
+		for(line = wi << 4; bits; line++, bits >>= 1)
+		{
+			if(bits & 0x1)
+			{
+				Sharp96x96_SendLine(line);
+			}
+		}
+	}
+
+	WriteCmdData(SHARP_LCD_TRAILER_BYTE);
+
+	// Wait for last byte to be sent, then drop SCS
+	WaitUntilLcdWriteFinished();
+
+    // Ensure a 2us min delay to meet the LCD's thSCS
+    __delay_cycles(SYSTEM_CLOCK_SPEED * 0.000002);
+
+	DeassertCS();
+#endif //WIRE_FORMAT_BUFFER
+
+	Sharp96x96_CloseFrame();
+}
+
+#ifdef ROTATE_90
+//*****************************************************************************
+//
+//! Finds the pre-rotated version of a font.
+//!
+//! \param psFont is a pointer to the font.
+//!
+//! \return Returns a pointer to the entry of g_ppsSharp96x96RotatedFonts made
+//! from the font, or 0 if it has none.
+//
+//*****************************************************************************
+static const Sharp96x96_RotatedFont *Sharp96x96_FindRotatedFont(const Graphics_Font *psFont)
+{
+	const Sharp96x96_RotatedFont *const *ppsFont = g_ppsSharp96x96RotatedFonts;
+
+	while(*ppsFont && ((*ppsFont)->font != psFont))
+	{
+		ppsFont++;
+	}
+
+	return *ppsFont;
+}
+
+#ifndef DISPLAY_LIST
+//*****************************************************************************
+//
+//! Finds the line holding a screen column.
+//!
+//! \param display is a pointer to the display drawn on, the LCD or the
+//! display of a Sharp96x96_Surface.
+//! \param lX is the screen X coordinate of the column.
+//!
+//! \return Returns a pointer to the first byte of the DisplayBuffer or surface
+//! line holding the column.
+//
+//*****************************************************************************
+static uint8_t *Sharp96x96_ColumnLine(const Graphics_Display *display,
+                                      int16_t lX)
+{
+	const Sharp96x96_Surface *psSurface;
+
+	if(display == &g_sharp96x96LCD)
+	{
+		return DisplayRow(RotatedLine(lX));
+	}
+
+	psSurface = (const Sharp96x96_Surface *)display->displayData;
+
+	return &psSurface->buffer[lX * psSurface->stride];
+}
+
+//*****************************************************************************
+//
+//! Merges a column of at most 8 pixels into a DisplayBuffer line.
+//!
+//! \param pucDst is a pointer to the DisplayBuffer byte holding the first
+//! pixel of the column.
+//! \param uiShift is the bit offset of the first pixel in that byte, counted
+//! from the most significant bit.
+//! \param ucBits is the column, first pixel in bit 7.
+//! \param ucMask has a bit set for every pixel of ucBits to merge.
+//! \param ucInk is 0xFF when set bits are white, 0x00 when black.
+//! \param ucPaper is 0xFF when clear bits are white, 0x00 when black.
+//! \param bOpaque is false to leave the pixels of clear bits untouched.
+//!
+//! This is Sharp96x96_MergeBits() for the columns of 8 pixel high fonts: the
+//! column is shifted once, as a word, and lands in at most two bytes.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void Sharp96x96_MergeByte(uint8_t *pucDst, uint16_t uiShift,
+                                 uint8_t ucBits, uint8_t ucMask,
+                                 uint8_t ucInk, uint8_t ucPaper, bool bOpaque)
+{
+	uint16_t uiBits = ((uint16_t)ucBits << 8) >> uiShift;
+	uint16_t uiMask = ((uint16_t)ucMask << 8) >> uiShift;
+
+	if(bOpaque)
+	{
+		uiBits = (uiBits & (ucInk ? 0xFFFF : 0x0000)) |
+		         (~uiBits & (ucPaper ? 0xFFFF : 0x0000));
+	}
+	else
+	{
+		uiMask &= uiBits;
+		uiBits = ucInk ? 0xFFFF : 0x0000;
+	}
+
+	pucDst[0] = (pucDst[0] & ~(uint8_t)(uiMask >> 8)) | (uint8_t)((uiBits & uiMask) >> 8);
+
+	if(uiMask & 0xFF)
+	{
+		pucDst[1] = (pucDst[1] & ~(uint8_t)uiMask) | (uint8_t)(uiBits & uiMask);
+	}
+}
+
+//*****************************************************************************
+//
+//! Draws columns of pre-rotated pixel data.
+//!
+//! \param context is a pointer to the drawing context, for its clip region.
+//! \param pucData is a pointer to the first column of data.
+//! \param lWidth is the number of columns.
+//! \param lHeight is the number of pixels in a column.
+//! \param x is the screen X coordinate of the first column.
+//! \param y is the screen Y coordinate of the top of the columns.
+//! \param ucInk is 0xFF when set bits are white, 0x00 when black.
+//! \param ucPaper is 0xFF when clear bits are white, 0x00 when black.
+//! \param bOpaque is false to leave the pixels of clear bits untouched.
+//!
+//! With ROTATE_90 a screen column is a DisplayBuffer line, so each column is
+//! merged into its line with Sharp96x96_MergeBits(), or Sharp96x96_MergeByte()
+//! when it fits in a byte. Surfaces have the same layout and are drawn on the
+//! same way.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void Sharp96x96_DrawColumns(const Graphics_Context *context,
+                                   const uint8_t *pucData, int16_t lWidth,
+                                   int16_t lHeight, int16_t x, int16_t y,
+                                   uint8_t ucInk, uint8_t ucPaper, bool bOpaque)
+{
+	const Graphics_Rectangle *pClip = &context->clipRegion;
+	int16_t lColumnBytes = (lHeight + 7) >> 3;
+	int16_t lX1 = x;
+	int16_t lX2 = x + lWidth - 1;
+	int16_t lY1 = y;
+	int16_t lY2 = y + lHeight - 1;
+	int16_t lX;
+	uint8_t ucMask;
+
+	if(lX1 < pClip->xMin) lX1 = pClip->xMin;
+	if(lX2 > pClip->xMax) lX2 = pClip->xMax;
+	if(lY1 < pClip->yMin) lY1 = pClip->yMin;
+	if(lY2 > pClip->yMax) lY2 = pClip->yMax;
+
+	if((lX1 > lX2) || (lY1 > lY2))
+	{
+		return;
+	}
+
+#ifdef NON_VOLATILE_MEMORY_BUFFER
+	PrepareMemoryWrite();
+#endif
+
+	pucData += (lX1 - x) * lColumnBytes;
+
+	// Fonts and images up to 8 pixels high, such as the 6x8 text cells
+	if(1 == lColumnBytes)
+	{
+		ucMask = (uint8_t)(0xFF << (8 - (lY2 - lY1 + 1)));
+
+		for(lX = lX1; lX <= lX2; lX++)
+		{
+			Sharp96x96_MergeByte(&Sharp96x96_ColumnLine(context->display, lX)[lY1>>3],
+			                     lY1 & 0x7, *pucData++ << (lY1 - y), ucMask,
+			                     ucInk, ucPaper, bOpaque);
+		}
+	}
+	else
+	{
+		for(lX = lX1; lX <= lX2; lX++)
+		{
+			Sharp96x96_MergeBits(&Sharp96x96_ColumnLine(context->display, lX)[lY1>>3],
+			                     lY1 & 0x7, pucData, lY1 - y, lY2 - lY1 + 1,
+			                     ucInk, ucPaper, bOpaque);
+
+			pucData += lColumnBytes;
+		}
+	}
+
+	if(context->display == &g_sharp96x96LCD)
+	{
+		Sharp96x96_MarkRowsDirty(RotatedLine(lX2), RotatedLine(lX1));
+	}
+
+#ifdef NON_VOLATILE_MEMORY_BUFFER
+	FinishMemoryWrite();
+#endif
+}
+#endif //DISPLAY_LIST
+
+//*****************************************************************************
+//
+//! Draws a string with the pre-rotated version of the context font.
+//!
+//! \param context is a pointer to the drawing context to use.
+//! \param string is a pointer to the string to be drawn.
+//! \param lLength is the number of characters from the string that should be
+//! drawn on the screen, or AUTO_STRING_LENGTH to draw up to the end of it.
+//! \param x is the X coordinate of the upper left corner of the string.
+//! \param y is the Y coordinate of the upper left corner of the string.
+//! \param opaque is true if the background of each character should be drawn
+//! and false if it should not (leaving the background as is).
+//!
+//! This is a drop in replacement for Graphics_drawString(). Each glyph column
+//! is merged straight into the DisplayBuffer instead of being drawn pixel by
+//! pixel, or with DISPLAY_LIST the whole string becomes a single record.
+//! Fonts without a rotated version in g_ppsSharp96x96RotatedFonts are handed
+//! to Graphics_drawString(). Contexts of a Sharp96x96_Surface are drawn on the
+//! same way.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void Sharp96x96_DrawString(const Graphics_Context *context,
+                           const uint8_t *string, int32_t lLength,
+                           int32_t x, int32_t y, bool opaque)
+{
+	const Sharp96x96_RotatedFont *psFont = Sharp96x96_FindRotatedFont(context->font);
+#ifndef DISPLAY_LIST
+	int16_t lGlyphBytes;
+	uint8_t ucInk = context->foreground ? 0xFF : 0x00;
+	uint8_t ucPaper = context->background ? 0xFF : 0x00;
+	uint8_t ucChar;
+#endif
+
+	if(!psFont)
+	{
+		Graphics_drawString(context, (uint8_t *)string, lLength, x, y, opaque);
+		return;
+	}
+
+#ifdef DISPLAY_LIST
+	Sharp96x96_ListText(context, psFont, string, lLength, x, y, opaque);
+#else
+	lGlyphBytes = psFont->width * ((psFont->height + 7) >> 3);
+
+	while(lLength-- && *string)
+	{
+		ucChar = *string++;
+
+		// Characters without a glyph are drawn as a period, like grlib does
+		if((ucChar < ' ') || (ucChar > 0x7F))
+		{
+			ucChar = '.';
+		}
+
+		Sharp96x96_DrawColumns(context, psFont->data + (ucChar - ' ') * lGlyphBytes,
+		                       psFont->width, psFont->height, x, y,
+		                       ucInk, ucPaper, opaque);
+
+		x += psFont->width;
+	}
+#endif
+}
+
+//*****************************************************************************
+//
+//! Draws a string centered on a point with the pre-rotated context font.
+//!
+//! \param context is a pointer to the drawing context to use.
+//! \param string is a pointer to the string to be drawn.
+//! \param lLength is the number of characters from the string that should be
+//! drawn on the screen, or AUTO_STRING_LENGTH to draw up to the end of it.
+//! \param x is the X coordinate of the center of the string.
+//! \param y is the Y coordinate of the center of the string.
+//! \param opaque is true if the background of each character should be drawn
+//! and false if it should not (leaving the background as is).
+//!
+//! This is a drop in replacement for Graphics_drawStringCentered(), placing
+//! the string the same way, with the width from Sharp96x96_GetStringWidth().
+//!
+//! \return None.
+//
+//*****************************************************************************
+void Sharp96x96_DrawStringCentered(const Graphics_Context *context,
+                                   const uint8_t *string, int32_t lLength,
+                                   int32_t x, int32_t y, bool opaque)
+{
+	Sharp96x96_DrawString(context, string, lLength,
+	                      x - (Sharp96x96_GetStringWidth(context, string, lLength) / 2),
+	                      y - (context->font->baseline / 2), opaque);
+}
+
+//*****************************************************************************
+//
+//! Draws a pre-rotated image.
+//!
+//! \param context is a pointer to the drawing context to use.
+//! \param image is a pointer to the image, as emitted by
+//! tools/rotate_assets.c.
+//! \param x is the X coordinate of the upper left corner of the image.
+//! \param y is the Y coordinate of the upper left corner of the image.
+//!
+//! This is the counterpart of Graphics_drawImage() for rotated images. Each
+//! image column is merged straight into the DisplayBuffer, or with
+//! DISPLAY_LIST the image becomes a single record.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void Sharp96x96_DrawRotatedImage(const Graphics_Context *context,
+                                 const Sharp96x96_RotatedImage *image,
+                                 int16_t x, int16_t y)
+{
+#ifdef DISPLAY_LIST
+	Sharp96x96_ListImage(context, image, x, y);
+#else
+	Sharp96x96_DrawColumns(context, image->data, image->width, image->height,
+	                       x, y, 0xFF, 0x00, true);
+#endif
+}
+
+#ifndef DISPLAY_LIST
+//*****************************************************************************
+//
+// The state of the decoder of a packed image. The image is a stream of 4 bit
+// codes, high nibble first, giving the lengths of the runs of white and black
+// pixels down each column, left to right, starting with white. Codes 0 to 14
+// are a run followed by a change of color, code 15 is a run of 15 pixels
+// that the next code continues.
+//
+//*****************************************************************************
+typedef struct
+{
+	const uint8_t *pucSrc;		// The byte holding the next code
+	uint8_t ucLowNibble;		// Non-zero if the next code is the low nibble
+	uint8_t ucRemain;			// Pixels left in the current run
+	uint8_t ucWhite;			// Non-zero while the current run is white
+	uint8_t ucFlip;				// Non-zero if the color changes after the run
+} tPackedRun;
+
+//*****************************************************************************
+//
+//! Decodes the next column of a packed image.
+//!
+//! \param psRun is a pointer to the decoder state.
+//! \param pucColumn is a pointer to the buffer for the column, of
+//! (uiHeight + 7) >> 3 bytes.
+//! \param uiHeight is the height of the image.
+//!
+//! The column is stored like those of a rotated image, top pixel in bit 7 of
+//! the first byte and set bits white. White runs are set a byte at a time.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void Sharp96x96_UnpackColumn(tPackedRun *psRun, uint8_t *pucColumn,
+                                    uint16_t uiHeight)
+{
+	uint16_t uiPos = 0;
+	uint16_t uiCount;
+	uint16_t n;
+	uint8_t ucCode;
+
+	for(n = 0; n < ((uiHeight + 7) >> 3); n++)
+	{
+		pucColumn[n] = 0;
+	}
+
+	while(uiPos < uiHeight)
+	{
+		while(!psRun->ucRemain)
+		{
+			if(psRun->ucFlip)
+			{
+				psRun->ucWhite = !psRun->ucWhite;
+			}
+
+			if(psRun->ucLowNibble)
+			{
+				ucCode = *psRun->pucSrc++ & 0x0F;
+			}
+			else
+			{
+				ucCode = *psRun->pucSrc >> 4;
+			}
+
+			psRun->ucLowNibble = !psRun->ucLowNibble;
+			psRun->ucRemain = ucCode;
+			psRun->ucFlip = (ucCode != 15);
+		}
+
+		uiCount = psRun->ucRemain;
+
+		if(uiCount > uiHeight - uiPos)
+		{
+			uiCount = uiHeight - uiPos;
+		}
+
+		psRun->ucRemain -= uiCount;
+
+		if(!psRun->ucWhite)
+		{
+			uiPos += uiCount;
+			continue;
+		}
+
+		while(uiCount)
+		{
+			// Number of pixels going into this byte of the column
+			n = 8 - (uiPos & 0x7);
+
+			if(n > uiCount)
+			{
+				n = uiCount;
+			}
+
+			pucColumn[uiPos >> 3] |= (uint8_t)(0xFF << (8 - n)) >> (uiPos & 0x7);
+			uiPos += n;
+			uiCount -= n;
+		}
+	}
+}
+
+//*****************************************************************************
+//
+//! Draws a packed image.
+//!
+//! \param context is a pointer to the drawing context to use.
+//! \param image is a pointer to the image, as emitted by tools/pack_image.c.
+//! \param x is the X coordinate of the upper left corner of the image.
+//! \param y is the Y coordinate of the upper left corner of the image.
+//!
+//! The columns of the image are decoded one at a time into a buffer on the
+//! stack and merged into their DisplayBuffer lines like those of
+//! Sharp96x96_DrawRotatedImage(), so the image is never expanded in RAM.
+//! Columns left of the clip region are decoded and dropped, decoding stops at
+//! its right edge. Not available with DISPLAY_LIST.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void Sharp96x96_DrawPackedImage(const Graphics_Context *context,
+                                const Sharp96x96_PackedImage *image,
+                                int16_t x, int16_t y)
+{
+	const Graphics_Rectangle *pClip = &context->clipRegion;
+	uint8_t pucColumn[SHARP_PACKED_COLUMN_BYTES];
+	int16_t lX1 = x;
+	int16_t lX2 = x + image->width - 1;
+	int16_t lY1 = y;
+	int16_t lY2 = y + image->height - 1;
+	int16_t lX;
+	tPackedRun sRun;
+
+	if(lX1 < pClip->xMin) lX1 = pClip->xMin;
+	if(lX2 > pClip->xMax) lX2 = pClip->xMax;
+	if(lY1 < pClip->yMin) lY1 = pClip->yMin;
+	if(lY2 > pClip->yMax) lY2 = pClip->yMax;
+
+	if((lX1 > lX2) || (lY1 > lY2) ||
+	   (image->height > SHARP_PACKED_COLUMN_BYTES * 8))
+	{
+		return;
+	}
+
+	sRun.pucSrc = image->data;
+	sRun.ucLowNibble = 0;
+	sRun.ucRemain = 0;
+	sRun.ucWhite = 1;
+	sRun.ucFlip = 0;
+
+#ifdef NON_VOLATILE_MEMORY_BUFFER
+	PrepareMemoryWrite();
+#endif
+
+	for(lX = x; lX <= lX2; lX++)
+	{
+		Sharp96x96_UnpackColumn(&sRun, pucColumn, image->height);
+
+		if(lX >= lX1)
+		{
+			Sharp96x96_MergeBits(&Sharp96x96_ColumnLine(context->display, lX)[lY1>>3],
+			                     lY1 & 0x7, pucColumn, lY1 - y, lY2 - lY1 + 1,
+			                     0xFF, 0x00, true);
+		}
+	}
+
+	if(context->display == &g_sharp96x96LCD)
+	{
+		Sharp96x96_MarkRowsDirty(RotatedLine(lX2), RotatedLine(lX1));
+	}
+
+#ifdef NON_VOLATILE_MEMORY_BUFFER
+	FinishMemoryWrite();
+#endif
+}
+#endif //DISPLAY_LIST
+#endif //ROTATE_90
+
+//*****************************************************************************
+//
+//! Determines the width of a string in the context font.
+//!
+//! \param context is a pointer to the drawing context to use.
+//! \param string is a pointer to the string.
+//! \param lLength is the number of characters of the string to measure, or
+//! AUTO_STRING_LENGTH to measure up to the end of it.
+//!
+//! This is a drop in replacement for Graphics_getStringWidth(). The fonts in
+//! g_ppsSharp96x96RotatedFonts are fixed width, so their strings are measured
+//! as the number of characters times the cell width instead of a glyph at a
+//! time.
+//!
+//! \return Returns the width of the string in pixels.
+//
+//*****************************************************************************
+int32_t Sharp96x96_GetStringWidth(const Graphics_Context *context,
+                                  const uint8_t *string, int32_t lLength)
+{
+#ifdef ROTATE_90
+	const Sharp96x96_RotatedFont *psFont = Sharp96x96_FindRotatedFont(context->font);
+	int32_t lCount;
+
+	if(psFont)
+	{
+		for(lCount = 0; (lCount != lLength) && string[lCount]; lCount++)
+		{
+		}
+
+		return lCount * psFont->width;
+	}
+#endif
+
+	return Graphics_getStringWidth(context, (const int8_t *)string, lLength);
+}
+
+#ifndef DISPLAY_LIST
+//*****************************************************************************
+//
+//! Writes one byte of a screen into the DisplayBuffer.
+//!
+//! \param ucValue is the byte to write.
+//! \param pucLine is a pointer to the current DisplayBuffer line.
+//! \param puiPos is a pointer to the index of the byte in the whole screen,
+//! line by line, which is advanced.
+//!
+//! \return Returns a pointer to the DisplayBuffer line the next byte goes to.
+//
+//*****************************************************************************
+static uint8_t *Sharp96x96_ScreenPut(uint8_t ucValue, uint8_t *pucLine,
+                                     uint16_t *puiPos)
+{
+	uint16_t uiColumn = *puiPos % (LCD_HORIZONTAL_MAX>>3);
+
+	pucLine[uiColumn] = ucValue;
+	(*puiPos)++;
+
+	if((uiColumn == (LCD_HORIZONTAL_MAX>>3) - 1) &&
+	   (*puiPos < LCD_VERTICAL_MAX * (LCD_HORIZONTAL_MAX>>3)))
+	{
+		pucLine = DisplayRow(*puiPos / (LCD_HORIZONTAL_MAX>>3));
+	}
+
+	return pucLine;
+}
+
+//*****************************************************************************
+//
+//! Draws a pre-rasterized screen.
+//!
+//! \param screen is a pointer to the screen, as emitted by
+//! tools/prerender_screens.c.
+//!
+//! The screen replaces the whole DisplayBuffer and every line is marked
+//! dirty. Its data is the DisplayBuffer contents, line by line, run length
+//! coded: a control byte with bit 7 set repeats the next byte
+//! (control & 0x7F) + 1 times, otherwise the next control + 1 bytes are copied
+//! as is. Not available with DISPLAY_LIST.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void Sharp96x96_DrawScreen(const Sharp96x96_Screen *screen)
+{
+	const uint8_t *pucSrc = screen->data;
+	const uint8_t *pucEnd = screen->data + screen->size;
+	uint8_t *pucLine = DisplayRow(0);
+	uint16_t uiPos = 0;
+	uint8_t ucControl;
+	uint8_t ucCount;
+
+#ifdef NON_VOLATILE_MEMORY_BUFFER
+	PrepareMemoryWrite();
+#endif
+
+	while((pucSrc < pucEnd) && (uiPos < LCD_VERTICAL_MAX * (LCD_HORIZONTAL_MAX>>3)))
+	{
+		ucControl = *pucSrc++;
+		ucCount = (ucControl & 0x7F) + 1;
+
+		if(ucControl & 0x80)
+		{
+			while(ucCount--)
+			{
+				pucLine = Sharp96x96_ScreenPut(*pucSrc, pucLine, &uiPos);
+			}
+
+			pucSrc++;
+		}
+		else
+		{
+			while(ucCount--)
+			{
+				pucLine = Sharp96x96_ScreenPut(*pucSrc++, pucLine, &uiPos);
+			}
+		}
+	}
+
+#ifdef NON_VOLATILE_MEMORY_BUFFER
+	FinishMemoryWrite();
+#endif
+
+	Sharp96x96_MarkRowsDirty(0, LCD_VERTICAL_MAX - 1);
+}
+#endif //DISPLAY_LIST
+
+#ifndef DISPLAY_LIST
+//*****************************************************************************
+//
+// The lines of a surface are laid out like those of the DisplayBuffer: with
+// ROTATE_90 screen X picks the line and screen Y the bit, most significant
+// bit first, otherwise the other way around.
+//
+//*****************************************************************************
+#ifdef ROTATE_90
+#define SurfaceLine(s, x, y)	(&(s)->buffer[(x) * (s)->stride])
+#define SurfaceBit(x, y)		(y)
+#else
+#define SurfaceLine(s, x, y)	(&(s)->buffer[(y) * (s)->stride])
+#define SurfaceBit(x, y)		(x)
+#endif
+
+//*****************************************************************************
+//
+//! Fills a span of bits of a surface line.
+//!
+//! \param pucLine is a pointer to the first byte of the line.
+//! \param uiBit1 is the first bit of the span.
+//! \param uiBit2 is the last bit of the span.
+//! \param ulValue is the color of the span.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void Sharp96x96_SurfaceSpan(uint8_t *pucLine, uint16_t uiBit1,
+                                   uint16_t uiBit2, uint16_t ulValue)
+{
+	uint8_t *pucData = &pucLine[uiBit1>>3];
+	uint8_t *pucLast = &pucLine[uiBit2>>3];
+	uint8_t ucFill = (ClrBlack == ulValue) ? 0x00 : 0xFF;
+	uint8_t ucMask = 0xFF >> (uiBit1 & 0x7);
+
+	while(pucData < pucLast)
+	{
+		*pucData = (*pucData & ~ucMask) | (ucFill & ucMask);
+		pucData++;
+		ucMask = 0xFF;
+	}
+
+	ucMask &= (uint8_t)(0xFF << (7 - (uiBit2 & 0x7)));
+	*pucData = (*pucData & ~ucMask) | (ucFill & ucMask);
+}
+
+//*****************************************************************************
+//
+//! Draws a pixel on a surface.
+//!
+//! \param pvDisplayData is a pointer to the Sharp96x96_Surface.
+//! \param lX is the X coordinate of the pixel.
+//! \param lY is the Y coordinate of the pixel.
+//! \param ulValue is the color of the pixel.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void Sharp96x96_SurfacePixelDraw(void *pvDisplayData, int16_t lX,
+                                        int16_t lY, uint16_t ulValue)
+{
+	Sharp96x96_Surface *psSurface = (Sharp96x96_Surface *)pvDisplayData;
+	uint8_t *pucData = &SurfaceLine(psSurface, lX, lY)[SurfaceBit(lX, lY)>>3];
+	uint8_t ucBit = 0x80 >> (SurfaceBit(lX, lY) & 0x7);
+
+	if(ClrBlack == ulValue)
+	{
+		*pucData &= ~ucBit;
+	}
+	else
+	{
+		*pucData |= ucBit;
+	}
+}
+
+//*****************************************************************************
+//
+//! Draws a horizontal sequence of pixels on a surface.
+//!
+//! \param pvDisplayData is a pointer to the Sharp96x96_Surface.
+//! \param lX is the X coordinate of the first pixel.
+//! \param lY is the Y coordinate of the first pixel.
+//! \param lX0 is sub-pixel offset within the pixel data, which is valid for 1
+//! or 4 bit per pixel formats.
+//! \param lCount is the number of pixels to draw.
+//! \param lBPP is the number of bits per pixel; must be 1, 2, 4 or 8.
+//! \param pucData is a pointer to the pixel data.
+//! \param pucPalette is a pointer to the palette used to draw the pixels.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void Sharp96x96_SurfaceDrawMultiple(void *pvDisplayData, int16_t lX,
+                                           int16_t lY, int16_t lX0,
+                                           int16_t lCount, int16_t lBPP,
+                                           const uint8_t *pucData,
+                                           const uint32_t *pucPalette)
+{
+	uint16_t uiWhite;
+	uint16_t uiBit;
+
+	if(lCount <= 0)
+	{
+		return;
+	}
+
+	// Drop the compression flags, the data is uncompressed by now
+	lBPP &= 0x0F;
+
+	uiWhite = Sharp96x96_PaletteWhite(pvDisplayData, lBPP, pucPalette);
+
+	// Bit offset of the first pixel in the pixel data
+	uiBit = (8 == lBPP) ? 0 : lX0 * lBPP;
+
+	while(lCount--)
+	{
+		Sharp96x96_SurfacePixelDraw(pvDisplayData, lX++, lY,
+		                            Sharp96x96_SourcePixel(pucData, uiBit, lBPP,
+		                                                   uiWhite, pucPalette));
+		uiBit += lBPP;
+	}
+}
+
+//*****************************************************************************
+//
+//! Fills a rectangle of a surface.
+//!
+//! \param pvDisplayData is a pointer to the Sharp96x96_Surface.
+//! \param pRect is a pointer to the structure describing the rectangle.
+//! \param ulValue is the color of the rectangle.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void Sharp96x96_SurfaceRectFill(void *pvDisplayData,
+                                       const tRectangle *pRect,
+                                       uint16_t ulValue)
+{
+	Sharp96x96_Surface *psSurface = (Sharp96x96_Surface *)pvDisplayData;
+	int16_t lLine;
+
+#ifdef ROTATE_90
+	for(lLine = pRect->sXMin; lLine <= pRect->sXMax; lLine++)
+	{
+		Sharp96x96_SurfaceSpan(SurfaceLine(psSurface, lLine, 0), pRect->sYMin,
+		                       pRect->sYMax, ulValue);
+	}
+#else
+	for(lLine = pRect->sYMin; lLine <= pRect->sYMax; lLine++)
+	{
+		Sharp96x96_SurfaceSpan(SurfaceLine(psSurface, 0, lLine), pRect->sXMin,
+		                       pRect->sXMax, ulValue);
+	}
+#endif
+}
+
+//*****************************************************************************
+//
+//! Draws a horizontal line on a surface.
+//!
+//! \param pvDisplayData is a pointer to the Sharp96x96_Surface.
+//! \param lX1 is the X coordinate of the start of the line.
+//! \param lX2 is the X coordinate of the end of the line.
+//! \param lY is the Y coordinate of the line.
+//! \param ulValue is the color of the line.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void Sharp96x96_SurfaceLineDrawH(void *pvDisplayData, int16_t lX1,
+                                        int16_t lX2, int16_t lY,
+                                        uint16_t ulValue)
+{
+	tRectangle sRect;
+
+	sRect.sXMin = lX1;
+	sRect.sXMax = lX2;
+	sRect.sYMin = lY;
+	sRect.sYMax = lY;
+
+	Sharp96x96_SurfaceRectFill(pvDisplayData, &sRect, ulValue);
+}
+
+//*****************************************************************************
+//
+//! Draws a vertical line on a surface.
+//!
+//! \param pvDisplayData is a pointer to the Sharp96x96_Surface.
+//! \param lX is the X coordinate of the line.
+//! \param lY1 is the Y coordinate of the start of the line.
+//! \param lY2 is the Y coordinate of the end of the line.
+//! \param ulValue is the color of the line.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void Sharp96x96_SurfaceLineDrawV(void *pvDisplayData, int16_t lX,
+                                        int16_t lY1, int16_t lY2,
+                                        uint16_t ulValue)
+{
+	tRectangle sRect;
+
+	sRect.sXMin = lX;
+	sRect.sXMax = lX;
+	sRect.sYMin = lY1;
+	sRect.sYMax = lY2;
+
+	Sharp96x96_SurfaceRectFill(pvDisplayData, &sRect, ulValue);
+}
+
+//*****************************************************************************
+//
+//! Flushes a surface, which has nothing to send.
+//!
+//! \param pvDisplayData is a pointer to the Sharp96x96_Surface.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void Sharp96x96_SurfaceFlush(void *pvDisplayData)
+{
+}
+
+//*****************************************************************************
+//
+//! Clears a surface.
+//!
+//! \param pvDisplayData is a pointer to the Sharp96x96_Surface.
+//! \param ulValue is the color to clear to.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void Sharp96x96_SurfaceClear(void *pvDisplayData, uint16_t ulValue)
+{
+	Sharp96x96_Surface *psSurface = (Sharp96x96_Surface *)pvDisplayData;
+
+	memset(psSurface->buffer, (ClrBlack == ulValue) ? 0x00 : 0xFF,
+	       SHARP_SURFACE_BYTES(psSurface->display.width,
+	                           psSurface->display.heigth));
+}
+
+//*****************************************************************************
+//
+//! Initializes an offscreen surface.
+//!
+//! \param surface is a pointer to the surface.
+//! \param buffer is a pointer to the pixels of the surface, of
+//! SHARP_SURFACE_BYTES(width, height) bytes.
+//! \param width is the width of the surface.
+//! \param height is the height of the surface.
+//!
+//! The display of the surface is set up so that a Graphics_Context
+//! initialized with it draws into the buffer, which is left as it is. Not
+//! available with DISPLAY_LIST.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void Sharp96x96_SurfaceInit(Sharp96x96_Surface *surface, uint8_t *buffer,
+                            uint16_t width, uint16_t height)
+{
+	surface->display.size = sizeof(tDisplay);
+	surface->display.displayData = surface;
+	surface->display.width = width;
+	surface->display.heigth = height;
+	surface->display.callPixelDraw = Sharp96x96_SurfacePixelDraw;
+	surface->display.callPixelDrawMultiple = Sharp96x96_SurfaceDrawMultiple;
+	surface->display.callLineDrawH = Sharp96x96_SurfaceLineDrawH;
+	surface->display.callLineDrawV = Sharp96x96_SurfaceLineDrawV;
+	surface->display.callRectFill = Sharp96x96_SurfaceRectFill;
+	surface->display.callColorTranslate = Sharp96x96_ColorTranslate;
+	surface->display.callFlush = Sharp96x96_SurfaceFlush;
+	surface->display.callClearDisplay = Sharp96x96_SurfaceClear;
+
+	surface->buffer = buffer;
+#ifdef ROTATE_90
+	surface->stride = (height + 7) >> 3;
+#else
+	surface->stride = (width + 7) >> 3;
+#endif
+}
+
+//*****************************************************************************
+//
+//! Combines a byte of a surface with a byte of the DisplayBuffer.
+//!
+//! \param ucDst is the DisplayBuffer byte.
+//! \param ucSrc is the surface byte.
+//! \param ucOp is the raster operation, one of the SHARP_BLIT_ values.
+//!
+//! \return Returns the combined byte.
+//
+//*****************************************************************************
+static uint8_t Sharp96x96_BlitByte(uint8_t ucDst, uint8_t ucSrc, uint8_t ucOp)
+{
+	switch(ucOp)
+	{
+	case SHARP_BLIT_OR:
+		return ucDst | ucSrc;
+	case SHARP_BLIT_AND:
+		return ucDst & ucSrc;
+	case SHARP_BLIT_XOR:
+		return ucDst ^ ucSrc;
+	default:
+		return ucSrc;
+	}
+}
+
+//*****************************************************************************
+//
+//! Combines a run of bits of a surface line with a DisplayBuffer line.
+//!
+//! \param pucDst is a pointer to the DisplayBuffer byte holding the first
+//! pixel.
+//! \param uiShift is the bit offset of the first pixel in that byte, counted
+//! from the most significant bit.
+//! \param pucSrc is a pointer to the surface line.
+//! \param uiBit is the first bit of the line to combine.
+//! \param lCount is the number of bits to combine.
+//! \param ucOp is the raster operation, one of the SHARP_BLIT_ values.
+//!
+//! Runs at different bit offsets are shifted a byte at a time. Once both are
+//! byte aligned whole bytes are combined, a word at a time where both pointers
+//! are word aligned.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void Sharp96x96_BlitBits(uint8_t *pucDst, uint16_t uiShift,
+                                const uint8_t *pucSrc, uint16_t uiBit,
+                                int16_t lCount, uint8_t ucOp)
+{
+	uint16_t *puiDst;
+	const uint16_t *puiSrc;
+	uint16_t uiWords;
+	uint16_t n;
+	uint8_t ucBits;
+	uint8_t ucMask;
+
+	pucSrc += uiBit >> 3;
+	uiBit &= 0x7;
+
+	while(lCount > 0)
+	{
+		if(!uiShift && !uiBit && (lCount >= 16) &&
+		   !(((uintptr_t)pucDst | (uintptr_t)pucSrc) & 0x1))
+		{
+			puiDst = (uint16_t *)pucDst;
+			puiSrc = (const uint16_t *)pucSrc;
+			uiWords = lCount >> 4;
+
+			pucDst += uiWords << 1;
+			pucSrc += uiWords << 1;
+			lCount -= uiWords << 4;
+
+			switch(ucOp)
+			{
+			case SHARP_BLIT_OR:
+				while(uiWords--) *puiDst++ |= *puiSrc++;
+				break;
+			case SHARP_BLIT_AND:
+				while(uiWords--) *puiDst++ &= *puiSrc++;
+				break;
+			case SHARP_BLIT_XOR:
+				while(uiWords--) *puiDst++ ^= *puiSrc++;
+				break;
+			default:
+				while(uiWords--) *puiDst++ = *puiSrc++;
+				break;
+			}
+
+			continue;
+		}
+
+		// The bits of the source that land in this destination byte
+		n = 8 - uiShift;
+
+		if(n > lCount)
+		{
+			n = lCount;
+		}
+
+		ucBits = pucSrc[0] << uiBit;
+
+		if(uiBit + n > 8)
+		{
+			ucBits |= pucSrc[1] >> (8 - uiBit);
+		}
+
+		ucBits >>= uiShift;
+		ucMask = (uint8_t)(0xFF << (8 - n)) >> uiShift;
+
+		*pucDst = (*pucDst & ~ucMask) |
+		          (Sharp96x96_BlitByte(*pucDst, ucBits, ucOp) & ucMask);
+		pucDst++;
+
+		uiBit += n;
+		pucSrc += uiBit >> 3;
+		uiBit &= 0x7;
+		lCount -= n;
+		uiShift = 0;
+	}
+}
+
+//*****************************************************************************
+//
+//! Composites an offscreen surface into the DisplayBuffer.
+//!
+//! \param context is a pointer to the drawing context of the LCD, for its
+//! clip region.
+//! \param surface is a pointer to the surface.
+//! \param x is the X coordinate of the upper left corner of the surface.
+//! \param y is the Y coordinate of the upper left corner of the surface.
+//! \param ucOp is how surface pixels combine with the screen: SHARP_BLIT_COPY
+//! replaces them, and SHARP_BLIT_OR, SHARP_BLIT_AND and SHARP_BLIT_XOR combine
+//! them bitwise, white being a set bit. AND draws the black pixels of a
+//! surface over the screen, OR its white pixels, XOR inverts the screen under
+//! its white pixels.
+//!
+//! The surface is clipped to the clip region and its lines merged into their
+//! DisplayBuffer lines with Sharp96x96_BlitBits(), so a surface placed on a
+//! byte boundary, a Y coordinate that is a multiple of 8 with ROTATE_90, is
+//! copied a word at a time. The lines it covers are marked dirty. Not
+//! available with DISPLAY_LIST.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void Sharp96x96_BlitSurface(const Graphics_Context *context,
+                            const Sharp96x96_Surface *surface,
+                            int16_t x, int16_t y, uint8_t ucOp)
+{
+	const Graphics_Rectangle *pClip = &context->clipRegion;
+	int16_t lX1 = x;
+	int16_t lX2 = x + surface->display.width - 1;
+	int16_t lY1 = y;
+	int16_t lY2 = y + surface->display.heigth - 1;
+	int16_t lLine;
+
+	if(lX1 < pClip->xMin) lX1 = pClip->xMin;
+	if(lX2 > pClip->xMax) lX2 = pClip->xMax;
+	if(lY1 < pClip->yMin) lY1 = pClip->yMin;
+	if(lY2 > pClip->yMax) lY2 = pClip->yMax;
+
+	if((lX1 > lX2) || (lY1 > lY2))
+	{
+		return;
+	}
+
+#ifdef NON_VOLATILE_MEMORY_BUFFER
+	PrepareMemoryWrite();
+#endif
+
+#ifdef ROTATE_90
+	for(lLine = lX1; lLine <= lX2; lLine++)
+	{
+		Sharp96x96_BlitBits(&DisplayRow(RotatedLine(lLine))[lY1>>3],
+		                    lY1 & 0x7, SurfaceLine(surface, lLine - x, 0),
+		                    lY1 - y, lY2 - lY1 + 1, ucOp);
+	}
+
+	Sharp96x96_MarkRowsDirty(RotatedLine(lX2), RotatedLine(lX1));
+#else
+	for(lLine = lY1; lLine <= lY2; lLine++)
+	{
+		Sharp96x96_BlitBits(&DisplayRow(lLine)[lX1>>3], lX1 & 0x7,
+		                    SurfaceLine(surface, 0, lLine - y), lX1 - x,
+		                    lX2 - lX1 + 1, ucOp);
+	}
+
+	Sharp96x96_MarkRowsDirty(lY1, lY2);
+#endif
+
+#ifdef NON_VOLATILE_MEMORY_BUFFER
+	FinishMemoryWrite();
+#endif
+}
+#endif //DISPLAY_LIST
+
+#ifdef SCROLL_BUFFER
+//*****************************************************************************
+//
+//! Scrolls the whole screen by a number of LCD lines.
+//!
+//! \param context is a pointer to the drawing context, for its background
+//! color.
+//! \param lLines is the number of lines to scroll by. The picture moves
+//! towards the higher LCD lines when it is positive and towards line 0 when
+//! it is negative. With ROTATE_90 the LCD lines are the screen columns from
+//! right to left, so a positive count moves the picture left.
+//!
+//! Only ScrollOffset moves, and the lines uncovered are cleared to the
+//! background color, so the cost does not depend on what is on screen. Every
+//! line is marked dirty, as the whole LCD changes. With WIRE_FORMAT_BUFFER
+//! the address byte of every DisplayBuffer line is rewritten as well.
+//! Available with SCROLL_BUFFER.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void Sharp96x96_ScrollLines(const Graphics_Context *context, int16_t lLines)
+{
+	uint16_t uiLines = (lLines < 0) ? -lLines : lLines;
+#ifdef WIRE_FORMAT_BUFFER
+	uint16_t i;
+#endif
+
+	if(!uiLines)
+	{
+		return;
+	}
+
+	if(uiLines > LCD_VERTICAL_MAX)
+	{
+		uiLines = LCD_VERTICAL_MAX;
+	}
+
+#ifdef NON_VOLATILE_MEMORY_BUFFER
+	PrepareMemoryWrite();
+#endif
+
+	if(lLines > 0)
+	{
+		// LCD line y now shows what line y - uiLines did
+		ScrollOffset = (ScrollOffset + LCD_VERTICAL_MAX - uiLines) % LCD_VERTICAL_MAX;
+
+		Sharp96x96_FillSpan(0, LCD_HORIZONTAL_MAX - 1, 0, uiLines - 1,
+		                    context->background);
+	}
+	else
+	{
+		// LCD line y now shows what line y + uiLines did
+		ScrollOffset = (ScrollOffset + uiLines) % LCD_VERTICAL_MAX;
+
+		Sharp96x96_FillSpan(0, LCD_HORIZONTAL_MAX - 1, LCD_VERTICAL_MAX - uiLines,
+		                    LCD_VERTICAL_MAX - 1, context->background);
+	}
+
+#ifdef WIRE_FORMAT_BUFFER
+	// Every DisplayBuffer line carries the address of the LCD line it holds
+	for(i = 0; i < LCD_VERTICAL_MAX; i++)
+	{
+		DisplayRow(i)[-1] = reverse(i + 1);
+	}
+#endif
+
+#ifdef NON_VOLATILE_MEMORY_BUFFER
+	FinishMemoryWrite();
+#endif
+
+	Sharp96x96_MarkRowsDirty(0, LCD_VERTICAL_MAX - 1);
+}
+#endif //SCROLL_BUFFER
+
+#ifdef USE_DMA_FLUSH
+//*****************************************************************************
+//
+//! Sets the function called when a flushed frame has been sent to the LCD.
+//!
+//! \param pfnCallback is a pointer to the function, or NULL for none. It is
+//! called from the DMA ISR and must be short.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void Sharp96x96_SetFlushCallback(void (*pfnCallback)(void))
+{
+	FlushCallback = pfnCallback;
+}
+
+//*****************************************************************************
+//
+//! Checks whether a flushed frame is still being sent to the LCD.
+//!
+//! \return Returns true while the DMA engine owns a frame.
+//
+//*****************************************************************************
+bool Sharp96x96_FlushBusy(void)
+{
+	return Sharp96x96_DmaBusy();
+}
+#endif
+
+//*****************************************************************************
+//
+// Span rasterizer. Lines and circles are broken into the horizontal and
+// vertical runs of pixels that Bresenham's algorithms step along, and each run
+// goes to Sharp96x96_LineDrawH() or Sharp96x96_LineDrawV() in one call instead
+// of a call through callPixelDraw per pixel. The runs are clipped to the clip
+// region of the context here, as grlib clips its lines.
+//
+// With ROTATE_90 the two line functions trade places, as in g_sharp96x96LCD.
+//
+//*****************************************************************************
+#ifdef ROTATE_90
+#define ScreenLineDrawH		Sharp96x96_LineDrawV
+#define ScreenLineDrawV		Sharp96x96_LineDrawH
+#else
+#define ScreenLineDrawH		Sharp96x96_LineDrawH
+#define ScreenLineDrawV		Sharp96x96_LineDrawV
+#endif
+
+static void Sharp96x96_SpanH(const Graphics_Context *context, int16_t lX1,
+                             int16_t lX2, int16_t lY)
+{
+	const Graphics_Rectangle *clip = &context->clipRegion;
+
+	if((lY < clip->yMin) || (lY > clip->yMax) ||
+	   (lX2 < clip->xMin) || (lX1 > clip->xMax))
+	{
+		return;
+	}
+
+	if(lX1 < clip->xMin)
+	{
+		lX1 = clip->xMin;
+	}
+
+	if(lX2 > clip->xMax)
+	{
+		lX2 = clip->xMax;
+	}
+
+	ScreenLineDrawH(context->display->displayData, lX1, lX2, lY,
+	                context->foreground);
+}
+
+static void Sharp96x96_SpanV(const Graphics_Context *context, int16_t lX,
+                             int16_t lY1, int16_t lY2)
+{
+	const Graphics_Rectangle *clip = &context->clipRegion;
 
-	//Write bytes of data to the display buffer
-	for(xj=0;xj<lCount>>3;xj++){
-		*pData++ = *pucData++;
+	if((lX < clip->xMin) || (lX > clip->xMax) ||
+	   (lY2 < clip->yMin) || (lY1 > clip->yMax))
+	{
+		return;
 	}
 
-	//Write last data byte to the display buffer
-	*pData = (*pData & (0xFF >> (lCount & 0x7))) | *pucData;
+	if(lY1 < clip->yMin)
+	{
+		lY1 = clip->yMin;
+	}
 
-#ifdef NON_VOLATILE_MEMORY_BUFFER
-	FinishMemoryWrite();
-#endif
+	if(lY2 > clip->yMax)
+	{
+		lY2 = clip->yMax;
+	}
+
+	ScreenLineDrawV(context->display->displayData, lX, lY1, lY2,
+	                context->foreground);
 }
+
 //*****************************************************************************
 //
-//! Draws a horizontal line.
+//! Draws a line.
 //!
-//! \param pvDisplayData is a pointer to the driver-specific data for this
-//! display driver.
-//! \param lX1 is the X coordinate of the start of the line.
-//! \param lX2 is the X coordinate of the end of the line.
-//! \param lY is the Y coordinate of the line.
-//! \param ulValue is the color of the line.
+//! \param context is a pointer to the drawing context to use.
+//! \param x1 is the X coordinate of the start of the line.
+//! \param y1 is the Y coordinate of the start of the line.
+//! \param x2 is the X coordinate of the end of the line.
+//! \param y2 is the Y coordinate of the end of the line.
 //!
-//! This function draws a horizontal line on the display.  The coordinates of
-//! the line are assumed to be within the extents of the display.
+//! This is a drop in replacement for Graphics_drawLine(), drawing the same
+//! pixels. Each run of pixels on the same row, or on the same column for a
+//! line steeper than 45 degrees, is drawn as one horizontal or vertical line.
 //!
 //! \return None.
 //
 //*****************************************************************************
-static void Sharp96x96_LineDrawH(void *pvDisplayData, int16_t lX1, int16_t lX2,
-                                   int16_t lY, uint16_t ulValue)
+void Sharp96x96_DrawLine(const Graphics_Context *context, int16_t x1,
+                         int16_t y1, int16_t x2, int16_t y2)
 {
-#ifdef ROTATE_90
-	uint16_t temp = lX1;
-	lX1 = lX2;
-	lX2 = lY;
-	lY = LCD_HORIZONTAL_MAX - temp - 1;
-#endif
-
-	volatile uint16_t xi = 0;
-	volatile uint16_t x_index_min = lX1>>3;
-	volatile uint16_t x_index_max = lX2>>3;
-	volatile uint8_t *pucData, ucfirst_x_byte, uclast_x_byte;
-
-#ifdef NON_VOLATILE_MEMORY_BUFFER
-	PrepareMemoryWrite();
-#endif
+	int16_t temp;
+	int16_t deltaX;
+	int16_t deltaY;
+	int16_t error;
+	int16_t yStep;
+	int16_t runStart;
+	bool steep;
+
+	// Step along the major axis, left to right
+	steep = abs(y2 - y1) > abs(x2 - x1);
+
+	if(steep)
+	{
+		temp = x1;
+		x1 = y1;
+		y1 = temp;
+		temp = x2;
+		x2 = y2;
+		y2 = temp;
+	}
 
-	//calculate first byte
-	//mod by 8 and shift this # bits
-	ucfirst_x_byte = (0xFF >> (lX1 & 0x7));    
-	//calculate last byte
-	//mod by 8 and shift this # bits
-	uclast_x_byte = (0xFF << (7-(lX2 & 0x7))); 
+	if(x1 > x2)
+	{
+		temp = x1;
+		x1 = x2;
+		x2 = temp;
+		temp = y1;
+		y1 = y2;
+		y2 = temp;
+	}
 
-	//check if more than one data byte
-	if(x_index_min != x_index_max){
+	deltaX = x2 - x1;
+	deltaY = abs(y2 - y1);
+	error = -deltaX / 2;
+	yStep = (y1 < y2) ? 1 : -1;
 
-		//set buffer to correct location
-		pucData = &DisplayBuffer[lY][x_index_min];
+	for(runStart = x1; x1 <= x2; x1++)
+	{
+		error += deltaY;
 
-		//black pixels (clear bits)
-		if(ClrBlack == ulValue)
+		// The minor axis steps after this pixel, or the line ends, so the run
+		// is complete
+		if((error > 0) || (x1 == x2))
 		{
-			//write first byte
-			*pucData++ &= ~ucfirst_x_byte;
-
-			//write middle bytes
-			for(xi = x_index_min; xi < x_index_max-1; xi++)
+			if(steep)
 			{
-				*pucData++ = 0x00;
+				Sharp96x96_SpanV(context, y1, runStart, x1);
 			}
-
-			//write last byte
-			*pucData &= ~uclast_x_byte;
-		}
-		//white pixels (set bits)
-		else
-		{
-			//write first byte
-			*pucData++ |= ucfirst_x_byte;
-
-			//write middle bytes
-			for(xi = x_index_min; xi < x_index_max-1; xi++)
+			else
 			{
-				*pucData++ = 0xFF;
+				Sharp96x96_SpanH(context, runStart, x1, y1);
 			}
 
-			//write last byte
-			*pucData |= uclast_x_byte;
+			runStart = x1 + 1;
 		}
-	}
-	//only one data byte
-	else
-	{
-		//calculate value of single byte
-		ucfirst_x_byte &= uclast_x_byte;
 
-		//set buffer to correct location
-		pucData = &DisplayBuffer[lY][x_index_min];
-
-		//draw black pixels (clear bits)
-		if(ClrBlack == ulValue)
-		{
-			*pucData++ &= ~ucfirst_x_byte;
-		}
-		//white pixels (set bits)
-		else
+		if(error > 0)
 		{
-			*pucData++ |= ucfirst_x_byte;
+			y1 += yStep;
+			error -= deltaX;
 		}
 	}
-
-#ifdef NON_VOLATILE_MEMORY_BUFFER
-	FinishMemoryWrite();
-#endif
 }
 
+//*****************************************************************************
+//
+// Draws the eight runs of a circle made of the pixels a = lA1 to lA2 across
+// at a distance of lB, as Bresenham's midpoint algorithm traces them an
+// octant at a time.
+//
+//*****************************************************************************
+static void Sharp96x96_CircleRuns(const Graphics_Context *context, int16_t x,
+                                  int16_t y, int16_t lA1, int16_t lA2,
+                                  int16_t lB)
+{
+	// The runs on the rows above and below the center, left and right halves
+	// joined when they meet on the center column
+	if(lA1)
+	{
+		Sharp96x96_SpanH(context, x - lA2, x - lA1, y - lB);
+		Sharp96x96_SpanH(context, x + lA1, x + lA2, y - lB);
+		Sharp96x96_SpanH(context, x - lA2, x - lA1, y + lB);
+		Sharp96x96_SpanH(context, x + lA1, x + lA2, y + lB);
+	}
+	else
+	{
+		Sharp96x96_SpanH(context, x - lA2, x + lA2, y - lB);
+		Sharp96x96_SpanH(context, x - lA2, x + lA2, y + lB);
+	}
+
+	// The runs on the columns left and right of the center
+	if(lA1)
+	{
+		Sharp96x96_SpanV(context, x - lB, y - lA2, y - lA1);
+		Sharp96x96_SpanV(context, x - lB, y + lA1, y + lA2);
+		Sharp96x96_SpanV(context, x + lB, y - lA2, y - lA1);
+		Sharp96x96_SpanV(context, x + lB, y + lA1, y + lA2);
+	}
+	else
+	{
+		Sharp96x96_SpanV(context, x - lB, y - lA2, y + lA2);
+		Sharp96x96_SpanV(context, x + lB, y - lA2, y + lA2);
+	}
+}
 
 //*****************************************************************************
 //
-//! Draws a vertical line.
+//! Draws a circle.
 //!
-//! \param pvDisplayData is a pointer to the driver-specific data for this
-//! display driver.
-//! \param lX is the X coordinate of the line.
-//! \param lY1 is the Y coordinate of the start of the line.
-//! \param lY2 is the Y coordinate of the end of the line.
-//! \param ulValue is the color of the line.
+//! \param context is a pointer to the drawing context to use.
+//! \param x is the X coordinate of the center of the circle.
+//! \param y is the Y coordinate of the center of the circle.
+//! \param lRadius is the radius of the circle.
 //!
-//! This function draws a vertical line on the display.  The coordinates of the
-//! line are assumed to be within the extents of the display.
+//! This is a drop in replacement for Graphics_drawCircle(), drawing the same
+//! pixels. The pixels of an octant that stay the same distance from the
+//! center are drawn as one horizontal or vertical line.
 //!
 //! \return None.
 //
 //*****************************************************************************
-static void Sharp96x96_LineDrawV(void *pvDisplayData, int16_t lX, int16_t lY1,
-                                   int16_t lY2, uint16_t ulValue)
+void Sharp96x96_DrawCircle(const Graphics_Context *context, int16_t x,
+                           int16_t y, int16_t lRadius)
 {
-#ifdef ROTATE_90
-	uint16_t temp = lY2;
-	lY2 = LCD_HORIZONTAL_MAX - lX  - 1;
-	lY1 = LCD_HORIZONTAL_MAX - lY1 - 1;
-	lX = temp;
-#endif
-	volatile uint16_t yi = 0;
-	volatile uint16_t x_index = lX>>3;
-	volatile uint8_t data_byte;
-
-#ifdef NON_VOLATILE_MEMORY_BUFFER
-	PrepareMemoryWrite();
-#endif
-
-	//calculate data byte
-	//mod by 8 and shift this # bits
-	data_byte = (0x80 >> (lX & 0x7));     
-
-	//write data to the display buffer
-	for(yi = lY1; yi <= lY2; yi++){
+	int16_t a = 0;
+	int16_t b = lRadius;
+	int16_t d = 3 - (lRadius << 1);
+	int16_t runStart = 0;
 
-		//black pixels (clear bits)
-		if(ClrBlack == ulValue)
+	while(a <= b)
+	{
+		if(d < 0)
 		{
-			DisplayBuffer[yi][x_index] &= ~data_byte;
+			d += (a << 2) + 6;
 		}
-		//white pixels (set bits)
 		else
 		{
-			DisplayBuffer[yi][x_index] |= data_byte;
+			// b steps in after this pixel, so the run at b is complete
+			Sharp96x96_CircleRuns(context, x, y, runStart, a, b);
+			runStart = a + 1;
+			d += 4 * (a - b) + 10;
+			b--;
 		}
+
+		a++;
 	}
 
-#ifdef NON_VOLATILE_MEMORY_BUFFER
-	FinishMemoryWrite();
-#endif
+	if(runStart < a)
+	{
+		Sharp96x96_CircleRuns(context, x, y, runStart, a - 1, b);
+	}
 }
 
 //*****************************************************************************
 //
-//! Fills a rectangle.
+//! Draws a filled circle.
 //!
-//! \param pvDisplayData is a pointer to the driver-specific data for this
-//! display driver.
-//! \param pRect is a pointer to the structure describing the rectangle.
-//! \param ulValue is the color of the rectangle.
+//! \param context is a pointer to the drawing context to use.
+//! \param x is the X coordinate of the center of the circle.
+//! \param y is the Y coordinate of the center of the circle.
+//! \param lRadius is the radius of the circle.
 //!
-//! This function fills a rectangle on the display.  The coordinates of the
-//! rectangle are assumed to be within the extents of the display, and the
-//! rectangle specification is fully inclusive (in other words, both sXMin and
-//! sXMax are drawn, along with sYMin and sYMax).
+//! This is a drop in replacement for Graphics_fillCircle(), drawing the same
+//! pixels. The circle is symmetric about its diagonals, so it is filled a
+//! line of the DisplayBuffer at a time: every column of the screen with
+//! ROTATE_90, every row without, each drawn once.
 //!
 //! \return None.
 //
 //*****************************************************************************
-static void Sharp96x96_RectFill(void *pvDisplayData, const tRectangle *pRect,
-                                  uint16_t ulValue)
-{
 #ifdef ROTATE_90
-	// Make a new rectangle with transposed coordinates
-	tRectangle tempRect = *pRect;
-
-	tempRect.sXMin = pRect->sYMin;
-	tempRect.sXMax = pRect->sYMax;
-	tempRect.sYMin = LCD_HORIZONTAL_MAX - pRect->sXMax - 1;
-	tempRect.sYMax = LCD_HORIZONTAL_MAX - pRect->sXMin - 1;
-
-	// Set the pointer to the rectangle to the transposed version
-	pRect = &tempRect;
-#endif
-
-	volatile uint16_t xi = 0;
-	volatile uint16_t yi = 0;
-	volatile uint16_t x_index_min = pRect->sXMin>>3;
-	volatile uint16_t x_index_max = pRect->sXMax>>3;
-	volatile uint8_t *pucData, ucfirst_x_byte, uclast_x_byte;
-
-#ifdef NON_VOLATILE_MEMORY_BUFFER
-	PrepareMemoryWrite();
+#define FillCircleSpan(lHalf, lOffset)										\
+	Sharp96x96_SpanV(context, x + (lOffset), y - (lHalf), y + (lHalf))
+#else
+#define FillCircleSpan(lHalf, lOffset)										\
+	Sharp96x96_SpanH(context, x - (lHalf), x + (lHalf), y + (lOffset))
 #endif
 
-	//calculate first byte
-	//mod by 8 and shift this # bits
-	ucfirst_x_byte = (0xFF >> (pRect->sXMin & 0x7));  
-
-	//calculate last byte
-	//mod by 8 and shift this # bits
-	uclast_x_byte = (0xFF << (7-(pRect->sXMax & 0x7)));   
+void Sharp96x96_FillCircle(const Graphics_Context *context, int16_t x,
+                           int16_t y, int16_t lRadius)
+{
+	int16_t a = 0;
+	int16_t b = lRadius;
+	int16_t d = 3 - (lRadius << 1);
 
-	//check if more than one data byte
-	if(x_index_min != x_index_max){
+	while(a <= b)
+	{
+		FillCircleSpan(b, a);
 
-		//write bytes
-		for (yi = pRect->sYMin; yi<= pRect->sYMax; yi++)
+		if(a)
 		{
-			//set buffer to correct location
-			pucData = &DisplayBuffer[yi][x_index_min];
-
-			//black pixels (clear bits)
-			if(ClrBlack == ulValue)
-			{
-				//write first byte
-				*pucData++ &= ~ucfirst_x_byte;
-
-				//write middle bytes
-				for(xi = x_index_min; xi < x_index_max-1; xi++)
-				{
-					*pucData++ = 0x00;
-				}
-
-				//write last byte
-				*pucData &= ~uclast_x_byte;
-			}
-			//white pixels (set bits)
-			else
-			{
-				//write first byte
-				*pucData++ |= ucfirst_x_byte;
-
-				//write middle bytes
-				for(xi = x_index_min; xi < x_index_max-1; xi++)
-				{
-					*pucData++ = 0xFF;
-				}
-
-				//write last byte
-				*pucData |= uclast_x_byte;
-			}
+			FillCircleSpan(b, -a);
 		}
-	}
-	//only one data byte
-	else
-	{
-		//calculate value of single byte
-		ucfirst_x_byte &= uclast_x_byte;
 
-		//set buffer to correct location
-		pucData = &DisplayBuffer[pRect->sYMin][x_index_min];
+		// The lines at +-b are filled once, before b steps in
+		if((a != b) && (d >= 0))
+		{
+			FillCircleSpan(a, b);
+			FillCircleSpan(a, -b);
+		}
 
-		//black pixels (clear bits)
-		if(ClrBlack == ulValue)
+		if(d < 0)
 		{
-			*pucData++ &= ~ucfirst_x_byte;
+			d += (a << 2) + 6;
 		}
-		//white pixels (set bits)
 		else
 		{
-			*pucData++ |= ucfirst_x_byte;
+			d += 4 * (a - b) + 10;
+			b--;
 		}
-	}
 
-#ifdef NON_VOLATILE_MEMORY_BUFFER
-	FinishMemoryWrite();
-#endif
+		a++;
+	}
 }
 
 //*****************************************************************************
 //
-//! Translates a 24-bit RGB color to a display driver-specific color.
+//! Marks the frame as needing a flush.
 //!
-//! \param pvDisplayData is a pointer to the driver-specific data for this
-//! display driver.
-//! \param ulValue is the 24-bit RGB color.  The least-significant byte is the
-//! blue channel, the next byte is the green channel, and the third byte is the
-//! red channel.
-//!
-//! This function translates a 24-bit RGB color into a value that can be
-//! written into the display's frame buffer in order to reproduce that color,
-//! or the closest possible approximation of that color.
+//! Drawing code calls this instead of Graphics_flushBuffer(), and the main
+//! loop calls Sharp96x96_ServiceFlush() at a point where it is safe to send
+//! the frame, so that several changes made in a row go out in one flush. A
+//! request made while one is pending is counted by
+//! Sharp96x96_FlushesAvoided().
 //!
-//! \return Returns the display-driver specific color.
+//! \return None.
 //
 //*****************************************************************************
-static uint32_t Sharp96x96_ColorTranslate(void *pvDisplayData,
-                                          uint32_t ulValue)
+void Sharp96x96_RequestFlush(void)
 {
-    //
-    // Translate from a 24-bit RGB color to mono color.
-    //
-    return(DPYCOLORTRANSLATE(ulValue));
-}
+	if(FlushRequested)
+	{
+		FlushesAvoided++;
+	}
 
+	FlushRequested = true;
+}
 
 //*****************************************************************************
 //
-//! Flushes any cached drawing operations.
+//! Flushes the frame if a flush has been requested and is due.
 //!
-//! \param pvDisplayData is a pointer to the driver-specific data for this
-//! display driver.
+//! \param context is a pointer to the drawing context to flush.
+//! \param ulMillis is the time in milliseconds. It may wrap or jump, only the
+//! difference from the time of the previous flush is used.
 //!
+//! Flushes are paced to at most FLUSH_MAX_RATE a second. With USE_DMA_FLUSH a
+//! flush is also put off while the previous frame is still being sent, rather
+//! than sleeping until it has been.
 //!
-//! This functions flushes any cached drawing operations to the display.  This
-//! is useful when a local frame buffer is used for drawing operations, and the
-//! flush would copy the local frame buffer to the display.
+//! When no frame has been requested, a VCOM flip that is due goes out on its
+//! own. Polled builds must call this regularly for VCOM to be toggled.
 //!
-//! \return None.
+//! \return Returns true if the frame was flushed.
 //
 //*****************************************************************************
-void Sharp96x96_Flush (void *pvDisplayData)
+bool Sharp96x96_ServiceFlush(const Graphics_Context *context, uint32_t ulMillis)
 {
-	uint8_t *pucData = &DisplayBuffer[0][0];
-	int32_t xi =0;
-	int32_t xj = 0;
-	//image update mode(1X000000b)
-	uint8_t command = SHARP_LCD_CMD_WRITE_LINE;
-
-	//COM inversion bit
-	command = command^VCOMbit;
-
-	AssertCS();
-
-	WriteCmdData(command);
-	flagSendToggleVCOMCommand = SHARP_SKIP_TOGGLE_VCOM_COMMAND;
-#ifdef LANDSCAPE
-	for(xj=0; xj<LCD_VERTICAL_MAX; xj++)
-		{
-		  WriteCmdData(reverse(xj + 1));
-
-		  for(xi=0; xi<(LCD_HORIZONTAL_MAX>>3); xi++)
-		  {
-			WriteCmdData(*(pucData++));
-		  }
-		  WriteCmdData(SHARP_LCD_TRAILER_BYTE);
-		}
-
-
-#endif
-#ifdef LANDSCAPE_FLIP
-	pucData = &DisplayBuffer[LCD_VERTICAL_MAX-1][(LCD_HORIZONTAL_MAX>>3)-1];
+	if(!FlushRequested)
+	{
+		Sharp96x96_SendDueVCOM();
+		return false;
+	}
 
-	for(xj=1; xj<=LCD_VERTICAL_MAX; xj++)
+	if((uint32_t)(ulMillis - LastFlushMillis) < 1000 / FLUSH_MAX_RATE)
 	{
-		WriteCmdData(reverse(xj));
+		return false;
+	}
 
-	  for(xi=0; xi < (LCD_HORIZONTAL_MAX>>3); xi++)
-	  {
-		WriteCmdData(reverse(*pucData--));
-	  }
-	  WriteCmdData(SHARP_LCD_TRAILER_BYTE);
+#ifdef USE_DMA_FLUSH
+	if(Sharp96x96_DmaBusy())
+	{
+		return false;
 	}
 #endif
 
-	WriteCmdData(SHARP_LCD_TRAILER_BYTE);
+	FlushRequested = false;
+	LastFlushMillis = ulMillis;
+	Graphics_flushBuffer(context);
 
-	// Wait for last byte to be sent, then drop SCS
-	WaitUntilLcdWriteFinished();
+	return true;
+}
 
-    // Ensure a 2us min delay to meet the LCD's thSCS
-    __delay_cycles(SYSTEM_CLOCK_SPEED * 0.000002);
+//*****************************************************************************
+//
+//! Checks whether a requested flush has not been sent yet.
+//!
+//! A main loop that sleeps can use this to know that it must wake up again
+//! and call Sharp96x96_ServiceFlush() once the flush is due.
+//!
+//! \return Returns true from Sharp96x96_RequestFlush() until the frame has
+//! been flushed.
+//
+//*****************************************************************************
+bool Sharp96x96_FlushPending(void)
+{
+	return FlushRequested;
+}
 
-	DeassertCS();
+//*****************************************************************************
+//
+//! Reads the number of flushes saved by coalescing.
+//!
+//! \return Returns the number of Sharp96x96_RequestFlush() calls that were
+//! merged into a flush already pending.
+//
+//*****************************************************************************
+uint16_t Sharp96x96_FlushesAvoided(void)
+{
+	return FlushesAvoided;
 }
 
 //*****************************************************************************
@@ -593,22 +3544,23 @@ void Sharp96x96_Flush (void *pvDisplayData)
 //! display driver.
 //! \param ucValue is the background color of the buffered data.
 //!
-//! This function sets every pixel to the background color.
+//! This function sets every pixel to the background color. Clearing to white
+//! leaves the LCD and the DisplayBuffer identical, so no line is left dirty.
 //!
 //! \return None.
 //
 //*****************************************************************************
 void Sharp96x96_ClearScreen (void *pvDisplayData, uint16_t ulValue)
 {
+	uint16_t i;
 	//clear screen mode(0X100000b)
 	uint8_t command = SHARP_LCD_CMD_CLEAR_SCREEN;
 	//COM inversion bit
-	command = command^VCOMbit;
+	command = Sharp96x96_OpenFrame(command);
 
 	AssertCS();
 
 	WriteCmdData(command);
-	flagSendToggleVCOMCommand = SHARP_SKIP_TOGGLE_VCOM_COMMAND;
 	WriteCmdData(SHARP_LCD_TRAILER_BYTE);
 
 	// Wait for last byte to be sent, then drop SCS
@@ -618,11 +3570,23 @@ void Sharp96x96_ClearScreen (void *pvDisplayData, uint16_t ulValue)
 	__delay_cycles(SYSTEM_CLOCK_SPEED * 0.000002);
 
 	DeassertCS();
+
+	Sharp96x96_CloseFrame();
 	if(ClrBlack == ulValue)
-	Sharp96x96_InitializeDisplayBuffer(pvDisplayData, SHARP_BLACK);
+	{
+		Sharp96x96_InitializeDisplayBuffer(pvDisplayData, SHARP_BLACK);
+	}
 	else
-	Sharp96x96_InitializeDisplayBuffer(pvDisplayData, SHARP_WHITE);
+	{
+		Sharp96x96_InitializeDisplayBuffer(pvDisplayData, SHARP_WHITE);
 
+		// The clear command leaves the LCD white, which is what the
+		// DisplayBuffer now holds, so no line needs to be sent
+		for(i=0; i<DIRTY_ROW_WORDS; i++)
+		{
+			DirtyRows[i] = 0;
+		}
+	}
 }
 
 //*****************************************************************************
@@ -630,37 +3594,35 @@ void Sharp96x96_ClearScreen (void *pvDisplayData, uint16_t ulValue)
 //! Send toggle VCOM command.
 //!
 //! This function toggles the state of VCOM which prevents a DC bias from being 
-//! built up within the panel.
+//! built up within the panel. It is called from the Timer ISR about once a
+//! second and never waits for the bus.
+//!
+//! The new VCOM bit rides on the command byte of the next frame. When no
+//! frame has been requested with Sharp96x96_RequestFlush(), USE_DMA_FLUSH
+//! builds hand a standalone change VCOM transaction to the DMA engine right
+//! away, or as soon as the frame being built or sent is out. Polled builds
+//! leave it to Sharp96x96_ServiceFlush(), or to the next flush. A flip still
+//! not sent a period later goes out on its own instead of flipping again.
 //!
 //! \return None.
 //
 //*****************************************************************************
 void Sharp96x96_SendToggleVCOMCommand()
 {
-	VCOMbit ^= SHARP_VCOM_TOGGLE_BIT;
-
-	if(SHARP_SEND_TOGGLE_VCOM_COMMAND == flagSendToggleVCOMCommand)
+	if(SentVCOMbit == VCOMbit)
 	{
-		//clear screen mode(0X100000b)
-		uint8_t command = SHARP_LCD_CMD_CHANGE_VCOM;
-		//COM inversion bit
-		command = command^VCOMbit;
+		VCOMbit ^= SHARP_VCOM_TOGGLE_BIT;
 
-	    AssertCS();
-
-		WriteCmdData(command);
-		WriteCmdData(SHARP_LCD_TRAILER_BYTE);
-
-		// Wait for last byte to be sent, then drop SCS
-		WaitUntilLcdWriteFinished();
-
-		// Ensure a 2us min delay to meet the LCD's thSCS
-		__delay_cycles(SYSTEM_CLOCK_SPEED * 0.000002);
-
-		DeassertCS();
+		// The requested frame will carry it
+		if(FlushRequested)
+		{
+			return;
+		}
 	}
 
-	flagSendToggleVCOMCommand = SHARP_SEND_TOGGLE_VCOM_COMMAND;
+#ifdef USE_DMA_FLUSH
+	Sharp96x96_SendDueVCOM();
+#endif
 }
 
 
@@ -674,15 +3636,22 @@ void Sharp96x96_SendToggleVCOMCommand()
 //!	\param ucValue is the foreground color of the buffered data.
 //!
 //! This function initializes the display buffer and discards any cached data.
+//! Every line is marked dirty.
 //!
 //! \return None.
 //
 //*****************************************************************************
 static void Sharp96x96_InitializeDisplayBuffer(void *pvDisplayData, uint8_t ucValue)
 {
-	uint16_t i=0,j=0;
-	uint8_t *pucData = pvDisplayData;
+#if defined(WIRE_FORMAT_BUFFER) && !defined(USE_FLASH_BUFFER)
+	uint16_t i;
+	uint8_t *pucData;
+#endif
 
+#ifdef SCROLL_BUFFER
+	// LCD line y is held by DisplayBuffer line y again
+	ScrollOffset = 0;
+#endif
 
 #ifdef USE_FLASH_BUFFER
 	// This is a callback function to HAL file since it implements device specific
@@ -690,11 +3659,25 @@ static void Sharp96x96_InitializeDisplayBuffer(void *pvDisplayData, uint8_t ucVa
 	InitializeDisplayBuffer(pvDisplayData, ucValue);
 
 #else
+#ifdef WIRE_FORMAT_BUFFER
+	// Every line carries its own address and trailer bytes
 	for(i =0; i< LCD_VERTICAL_MAX; i++)
-	for(j =0; j< (LCD_HORIZONTAL_MAX>>3); j++)
-		*pucData++ = ucValue;
+	{
+		pucData = DisplayRow(i);
+		pucData[-1] = reverse(i + 1);
+		pucData[LCD_HORIZONTAL_MAX>>3] = SHARP_LCD_TRAILER_BYTE;
+	}
+
+	// The command byte is written by every flush
+	DisplayBuffer[SHARP_WIRE_FRAME_BYTES - 1] = SHARP_LCD_TRAILER_BYTE;
+#endif //WIRE_FORMAT_BUFFER
+
+	Sharp96x96_FillSpan(0, LCD_HORIZONTAL_MAX - 1, 0, LCD_VERTICAL_MAX - 1,
+	                    (SHARP_BLACK == ucValue) ? ClrBlack : ClrWhite);
 
 #endif //USE_FLASH_BUFFER
+
+	Sharp96x96_MarkRowsDirty(0, LCD_VERTICAL_MAX - 1);
 }
 
 //*****************************************************************************
@@ -706,9 +3689,13 @@ static void Sharp96x96_InitializeDisplayBuffer(void *pvDisplayData, uint8_t ucVa
 const tDisplay g_sharp96x96LCD =
 {
     sizeof(tDisplay),
+#ifdef DISPLAY_LIST
+    &DisplayList,
+#else
     DisplayBuffer,
-    LCD_HORIZONTAL_MAX,
-    LCD_VERTICAL_MAX,
+#endif
+    SHARP_SCREEN_WIDTH,
+    SHARP_SCREEN_HEIGHT,
     Sharp96x96_PixelDraw, //PixelDraw,
     Sharp96x96_DrawMultiple,
 #ifdef ROTATE_90
@@ -0,0 +1,70 @@
+//*****************************************************************************
+//
+// Sharp96x96_Widgets.h - Retained text labels and strip charts drawn with the
+// Sharp96x96 LCD driver.
+//
+// These only use the public API of the driver: they draw through grlib and the
+// Sharp96x96_* drawing functions and let the driver track the dirty lines.
+//
+//*****************************************************************************
+
+#ifndef __SHARPLCD_WIDGETS_H__
+#define __SHARPLCD_WIDGETS_H__
+
+#include <stdint.h>
+#include "grlib.h"
+
+//*****************************************************************************
+//
+// A line of centered text that remembers what it has drawn, so that changing
+// its text only redraws the characters that differ.
+//
+//*****************************************************************************
+#define SHARP_LABEL_MAX_LENGTH				16
+
+typedef struct Sharp96x96_Label
+{
+	int16_t x;					//!< The X coordinate of the center of the label.
+	int16_t y;					//!< The Y coordinate of the center of the label.
+	int16_t left;				//!< The left edge of the text on screen.
+	int16_t width;				//!< The width of the text on screen.
+	uint8_t length;				//!< The number of characters on screen.
+	uint8_t text[SHARP_LABEL_MAX_LENGTH];	//!< The characters on screen.
+} Sharp96x96_Label;
+
+//*****************************************************************************
+//
+// A strip chart drawn along the right edge of the screen, which scrolls left
+// by step columns for every sample appended.
+//
+//*****************************************************************************
+typedef struct Sharp96x96_StripChart
+{
+	int16_t top;				//!< The Y coordinate of the highest value.
+	int16_t bottom;				//!< The Y coordinate of the lowest value.
+	int16_t min;				//!< The value plotted at the bottom.
+	int16_t max;				//!< The value plotted at the top.
+	int16_t last;				//!< The Y coordinate of the last sample, or -1.
+	uint8_t step;				//!< The number of columns of every sample.
+} Sharp96x96_StripChart;
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+extern void Sharp96x96_LabelInit(Sharp96x96_Label *label, int16_t x, int16_t y);
+extern void Sharp96x96_LabelInvalidate(Sharp96x96_Label *label);
+extern void Sharp96x96_LabelSetText(const Graphics_Context *context,
+                                    Sharp96x96_Label *label,
+                                    const uint8_t *string);
+
+// Available with SCROLL_BUFFER and ROTATE_90
+extern void Sharp96x96_StripChartInit(Sharp96x96_StripChart *chart, int16_t top,
+                                      int16_t bottom, int16_t min, int16_t max,
+                                      uint8_t step);
+extern void Sharp96x96_StripChartAppend(const Graphics_Context *context,
+                                        Sharp96x96_StripChart *chart,
+                                        int16_t value);
+
+#endif // __SHARPLCD_WIDGETS_H__
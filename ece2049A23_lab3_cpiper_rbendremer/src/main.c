@@ -6,6 +6,11 @@
 #define TEMP_AVG_SAMPLES 30  // one per second
 #define POT_AVG_SAMPLES 30
 
+// Temperature chart, in screen pixels
+#define CHART_TOP 28
+#define CHART_BOTTOM 92
+#define CHART_STEP 3  // pixels per sample
+
 // Conversions
 #define SEC_PER_MIN 60UL
 #define SEC_PER_HOUR 3600UL
@@ -30,6 +35,15 @@ char months[12][3] = {"Jan", "Feb", "Mar", "Apr", "May", "Jun",
 uint32_t editingSeconds = 0;
 uint8_t editIndex = 0;
 
+// Fields of the date and time edit screens, the one being edited is selected
+// Only the fields whose text or selection change are redrawn
+#define EDIT_FIELDS 3
+char editTexts[EDIT_FIELDS][4];
+Graphics_Button editButtons[EDIT_FIELDS];
+Graphics_Widget editWidgets[EDIT_FIELDS];
+Graphics_Widget editScreen;
+bool editScreenShown = false;
+
 // Bits to C conversion
 // Set in initADC()
 float degC_per_bit = 0.0f;
@@ -44,16 +58,28 @@ uint8_t potIndex = 0;
 uint8_t potCount = 0;
 
 // State
-enum State { DATE, EDIT_DATE, TIME, EDIT_TIME, TEMP_C, TEMP_F };
+enum State { DATE, EDIT_DATE, TIME, EDIT_TIME, TEMP_C, TEMP_F, TEMP_CHART };
 enum State currState = DATE;
 uint32_t lastUpdate = 0;
 uint32_t lastStateUpdate = 0;
 
+// Centered text of the date, time and temperature screens
+// Only the characters that change are redrawn while it is on screen
+Sharp96x96_Label centerLabel;
+bool centerLabelShown = false;
+
+// Chart of the temperature readings, scrolled one sample at a time
+Sharp96x96_StripChart tempChart;
+uint8_t tempChartIndex = 0;
+
 // Main
 void main(void) {
   WDTCTL = WDTPW | WDTHOLD;  // Stop watchdog timer. Always need to stop this!!
                              // You can then configure it properly, if desired
 
+  // 25MHz MCLK/SMCLK and 32768Hz ACLK, before anything that uses them
+  Clock_Init();
+
   // Enable global interrupts
   _BIS_SR(GIE);
 
@@ -64,6 +90,7 @@ void main(void) {
   initADC();
   configDisplay();
   configKeypad();
+  Sharp96x96_LabelInit(&centerLabel, 48, 15);
 
   // Main loop
   while (1) {
@@ -77,6 +104,7 @@ void main(void) {
           if (editIndex > 1) {
             editIndex = 0;
             currState = EDIT_TIME;
+            editScreenShown = false;
           }
           break;
         case EDIT_TIME:
@@ -84,17 +112,20 @@ void main(void) {
           if (editIndex > 2) {
             editIndex = 0;
             currState = EDIT_DATE;
+            editScreenShown = false;
           }
           break;
         case TIME:
           currState = EDIT_TIME;
           editIndex = 0;
+          editScreenShown = false;
           setupADCPot();
           editingSeconds = getSec();
           break;
         default:
           currState = EDIT_DATE;
           editIndex = 0;
+          editScreenShown = false;
           setupADCPot();
           editingSeconds = getSec();
           break;
@@ -152,39 +183,10 @@ void main(void) {
           seconds += monthToDays(month) * SEC_PER_DAY;
         }
 
-        // Compare the previously edited seconds to the current calculated
-        // value for seconds
-        if (seconds != editingSeconds) {
-          // Update the editing seconds
-          editingSeconds = seconds;
-
-          // Display the time
-          // Convert seconds to months and days
-          uint8_t month = daysToMonth(editingSeconds / SEC_PER_DAY);
-          uint16_t day = remainingDays(editingSeconds / SEC_PER_DAY);
-
-          // Convert to strings
-          char outputString[7];
-          outputString[0] = months[month][0];
-          outputString[1] = months[month][1];
-          outputString[2] = months[month][2];
-          outputString[3] = ' ';
-          outputString[4] = day / 10 + '0';
-          outputString[5] = day % 10 + '0';
-          outputString[6] = '\0';
-
-          Graphics_clearDisplay(&g_sContext);
-          Graphics_drawStringCentered(&g_sContext, outputString,
-                                      AUTO_STRING_LENGTH, 48, 15,
-                                      TRANSPARENT_TEXT);
-          uint8_t xPos = editIndex * 24 + 30;
-          if (editIndex == 0) {
-            Graphics_drawLineH(&g_sContext, xPos, xPos + 16, 20);
-          } else if (editIndex == 1) {
-            Graphics_drawLineH(&g_sContext, xPos, xPos + 10, 20);
-          }
-          Graphics_flushBuffer(&g_sContext);
-        }
+        // Update the editing seconds and display the date being edited
+        // Only the fields that changed are redrawn
+        editingSeconds = seconds;
+        displayEditDate(editingSeconds);
         break;
       }
       case TIME:
@@ -217,46 +219,10 @@ void main(void) {
           seconds += (uint32_t)(getPot() / 4096.0f * 60);
         }
 
-        // Compare the previously edited seconds to the current calculated
-        // value for seconds
-        if (seconds != editingSeconds) {
-          // Update the editing seconds
-          editingSeconds = seconds;
-
-          // Display the time
-          uint32_t timeInSeconds = editingSeconds;
-
-          // Lop off the days
-          timeInSeconds %= SEC_PER_DAY;
-
-          // Convert to hours, minutes, seconds
-          uint8_t hour = timeInSeconds / SEC_PER_HOUR;
-          timeInSeconds %= SEC_PER_HOUR;
-          uint8_t minute = timeInSeconds / SEC_PER_MIN;
-          timeInSeconds %= SEC_PER_MIN;
-          uint8_t second = timeInSeconds;
-
-          // Convert to strings
-          char outputString[9];
-          outputString[0] = hour / 10 + '0';
-          outputString[1] = hour % 10 + '0';
-          outputString[2] = ':';
-          outputString[3] = minute / 10 + '0';
-          outputString[4] = minute % 10 + '0';
-          outputString[5] = ':';
-          outputString[6] = second / 10 + '0';
-          outputString[7] = second % 10 + '0';
-          outputString[8] = '\0';
-
-          // Display the string
-          Graphics_clearDisplay(&g_sContext);
-          Graphics_drawStringCentered(&g_sContext, outputString,
-                                      AUTO_STRING_LENGTH, 48, 15,
-                                      TRANSPARENT_TEXT);
-          uint8_t xPos = editIndex * 18 + 24;
-          Graphics_drawLineH(&g_sContext, xPos, xPos + 10, 20);
-          Graphics_flushBuffer(&g_sContext);
-        }
+        // Update the editing seconds and display the time being edited
+        // Only the fields that changed are redrawn
+        editingSeconds = seconds;
+        displayEditTime(editingSeconds);
         break;
       }
       case TEMP_C:
@@ -279,6 +245,24 @@ void main(void) {
           displayTempF(C_to_F(getTempCAvg()));
         }
 
+        // Change to the chart after 3 seconds passes
+        if (getSec() - lastStateUpdate >= DISPLAY_TIME) {
+          currState = TEMP_CHART;
+          lastStateUpdate = getSec();
+          displayTempChart();
+        }
+        break;
+      case TEMP_CHART:
+        // Add every new reading to the chart
+        if (tempChartIndex != tempIndex) {
+          chartTempReading(tempReadings[tempChartIndex]);
+          tempChartIndex++;
+          if (tempChartIndex >= TEMP_AVG_SAMPLES) {
+            tempChartIndex = 0;
+          }
+          displayTempC(getTempCAvg());
+        }
+
         // Change to date after 3 seconds passes
         if (getSec() - lastStateUpdate >= DISPLAY_TIME) {
           currState = DATE;
@@ -286,6 +270,9 @@ void main(void) {
         }
         break;
     }
+
+    // Send what this pass has drawn
+    serviceDisplay();
   }
 }
 
@@ -360,7 +347,7 @@ void initTimerA() {
   // So 32768 ticks per second / 1 = 32768 ticks per second
   // Subtract 1 because the timer counts from 0
   // No error, so no need for leap counting
-  TA2CCR0 = 32768 - 1;
+  TA2CCR0 = CLOCK_ACLK_HZ - 1;
 
   // Enable interrupts for Timer A2
   TA2CCTL0 |= CCIE;
@@ -560,6 +547,36 @@ uint32_t getSec() {
   return count;
 }
 
+/**
+ * @brief Get the current time in ms, from the seconds count and Timer A2.
+ * MUST BE USED TO PREVENT READING ISSUES
+ *
+ * Wraps around, and jumps when the time is set, so only use the difference
+ * between two close readings
+ *
+ * @return uint32_t The current time in ms
+ */
+uint32_t getMillis() {
+  uint16_t ticks;
+
+  __disable_interrupt();
+  uint32_t count = A2Count;
+
+  // Timer A2 runs from ACLK, read until two reads agree
+  do {
+    ticks = TA2R;
+  } while (ticks != TA2R);
+
+  // The timer rolled over but the ISR has not counted the second yet
+  if ((TA2CCTL0 & CCIFG) && ticks < CLOCK_ACLK_HZ / 2) {
+    count++;
+  }
+  __enable_interrupt();
+
+  // CLOCK_ACLK_HZ ticks per second, a power of two so this is a shift
+  return count * 1000 + ((uint32_t)ticks * 1000) / CLOCK_ACLK_HZ;
+}
+
 /**
  * @brief Sets the count of Timer A2. MUST BE USED TO PREVENT ISSUES
  *
@@ -588,19 +605,38 @@ void setTimerA2CountSec(uint32_t seconds) {
  */
 void clearDisplay() {
   Graphics_clearDisplay(&g_sContext);
-  Graphics_flushBuffer(&g_sContext);
+  centerLabelShown = false;
+  Sharp96x96_RequestFlush();
+}
+
+/**
+ * @brief Sends the changes drawn to the display, if a flush has been requested
+ * and the last flush was long enough ago. Called once every pass of the main
+ * loop
+ *
+ * Drawing only requests a flush, so changes drawn one after another, like the
+ * temperature in F and the chart after it, are sent to the display together
+ */
+void serviceDisplay() {
+  Sharp96x96_ServiceFlush(&g_sContext, getMillis());
 }
 
 /**
  * @brief Displays the given string in the center of the screen
  *
+ * Only the characters that differ from the last string are redrawn, unless
+ * something else has been drawn since
+ *
  * @param string The string to display
  */
 void displayCenteredText(char* string) {
-  Graphics_clearDisplay(&g_sContext);
-  Graphics_drawStringCentered(&g_sContext, string, AUTO_STRING_LENGTH, 48, 15,
-                              TRANSPARENT_TEXT);
-  Graphics_flushBuffer(&g_sContext);
+  if (!centerLabelShown) {
+    Graphics_clearDisplay(&g_sContext);
+    Sharp96x96_LabelInvalidate(&centerLabel);
+    centerLabelShown = true;
+  }
+  Sharp96x96_LabelSetText(&g_sContext, &centerLabel, (uint8_t*)string);
+  Sharp96x96_RequestFlush();
 }
 
 /**
@@ -614,15 +650,16 @@ void displayCenteredText(char* string) {
 void displayCenteredTexts(uint8_t* string1, uint8_t* string2, uint8_t* string3,
                           uint8_t* string4) {
   Graphics_clearDisplay(&g_sContext);
-  Graphics_drawStringCentered(&g_sContext, string1, AUTO_STRING_LENGTH, 48, 15,
-                              TRANSPARENT_TEXT);
-  Graphics_drawStringCentered(&g_sContext, string2, AUTO_STRING_LENGTH, 48, 30,
-                              TRANSPARENT_TEXT);
-  Graphics_drawStringCentered(&g_sContext, string3, AUTO_STRING_LENGTH, 48, 45,
-                              TRANSPARENT_TEXT);
-  Graphics_drawStringCentered(&g_sContext, string4, AUTO_STRING_LENGTH, 48, 60,
-                              TRANSPARENT_TEXT);
-  Graphics_flushBuffer(&g_sContext);
+  centerLabelShown = false;
+  Sharp96x96_DrawStringCentered(&g_sContext, string1, AUTO_STRING_LENGTH, 48, 15,
+                                TRANSPARENT_TEXT);
+  Sharp96x96_DrawStringCentered(&g_sContext, string2, AUTO_STRING_LENGTH, 48, 30,
+                                TRANSPARENT_TEXT);
+  Sharp96x96_DrawStringCentered(&g_sContext, string3, AUTO_STRING_LENGTH, 48, 45,
+                                TRANSPARENT_TEXT);
+  Sharp96x96_DrawStringCentered(&g_sContext, string4, AUTO_STRING_LENGTH, 48, 60,
+                                TRANSPARENT_TEXT);
+  Sharp96x96_RequestFlush();
 }
 
 /**
@@ -727,6 +764,148 @@ void displayTime(uint32_t timeInSeconds) {
   displayCenteredText(outputString);
 }
 
+/**
+ * @brief Displays a date or time being edited in the center of the screen,
+ * with the field being edited selected
+ *
+ * The whole screen is drawn the first time after entering an edit state,
+ * after that only the fields whose text or selection changed are redrawn
+ *
+ * @param string The date or time to display
+ * @param fieldStarts The index in string of the first character of each field
+ * @param fieldLengths The number of characters of each field
+ * @param fields The number of fields, at most EDIT_FIELDS
+ */
+void displayEditFields(char* string, const uint8_t* fieldStarts,
+                       const uint8_t* fieldLengths, uint8_t fields) {
+  uint8_t i;
+
+  if (!editScreenShown) {
+    // Draw the whole string once, for the characters between the fields
+    Graphics_clearDisplay(&g_sContext);
+    centerLabelShown = false;
+    Sharp96x96_DrawStringCentered(&g_sContext, (uint8_t*)string,
+                                  AUTO_STRING_LENGTH, 48, 15,
+                                  TRANSPARENT_TEXT);
+
+    // As Sharp96x96_DrawStringCentered() places the string
+    int16_t x = 48 - Sharp96x96_GetStringWidth(&g_sContext, (uint8_t*)string,
+                                               AUTO_STRING_LENGTH) /
+                         2;
+    int16_t y = 15 - g_sFontFixed6x8.baseline / 2;
+
+    Graphics_initWidget(&g_sContext, &editScreen, GRAPHICS_WIDGET_GROUP, NULL);
+
+    for (i = 0; i < fields; i++) {
+      Graphics_Button* button = &editButtons[i];
+
+      memcpy(editTexts[i], &string[fieldStarts[i]], fieldLengths[i]);
+      editTexts[i][fieldLengths[i]] = '\0';
+
+      // The field, with the blank column of the character before it
+      button->textXPos = x + fieldStarts[i] * g_sFontFixed6x8.maxWidth;
+      button->textYPos = y;
+      button->xMin = button->textXPos - 1;
+      button->xMax =
+          button->textXPos + fieldLengths[i] * g_sFontFixed6x8.maxWidth - 2;
+      button->yMin = y - 1;
+      button->yMax = y + g_sFontFixed6x8.height;
+
+      button->borderWidth = 0;
+      button->selected = (i == editIndex);
+      button->fillColor = ClrWhite;
+      button->borderColor = ClrWhite;
+      button->selectedColor = ClrBlack;
+      button->textColor = ClrBlack;
+      button->selectedTextColor = ClrWhite;
+      button->text = (int8_t*)editTexts[i];
+      button->font = &g_sFontFixed6x8;
+
+      Graphics_initWidget(&g_sContext, &editWidgets[i], GRAPHICS_WIDGET_BUTTON,
+                          button);
+      Graphics_addWidget(&editScreen, &editWidgets[i]);
+    }
+
+    Graphics_drawWidget(&g_sContext, &editScreen);
+    editScreenShown = true;
+    Sharp96x96_RequestFlush();
+  } else {
+    for (i = 0; i < fields; i++) {
+      if (Graphics_isWidgetSelected(&editWidgets[i]) != (i == editIndex)) {
+        Graphics_selectWidget(&g_sContext, &editWidgets[i], i == editIndex);
+        Sharp96x96_RequestFlush();
+      }
+
+      if (memcmp(editTexts[i], &string[fieldStarts[i]], fieldLengths[i])) {
+        memcpy(editTexts[i], &string[fieldStarts[i]], fieldLengths[i]);
+        Graphics_drawWidget(&g_sContext, &editWidgets[i]);
+        Sharp96x96_RequestFlush();
+      }
+    }
+  }
+}
+
+/**
+ * @brief Displays the given date being edited, month then day
+ *
+ * @param seconds The date in seconds to display
+ */
+void displayEditDate(uint32_t seconds) {
+  static const uint8_t fieldStarts[] = {0, 4};
+  static const uint8_t fieldLengths[] = {3, 2};
+
+  // Convert seconds to months and days
+  uint8_t month = daysToMonth(seconds / SEC_PER_DAY);
+  uint16_t day = remainingDays(seconds / SEC_PER_DAY);
+
+  // Convert to strings
+  char outputString[7];
+  outputString[0] = months[month][0];
+  outputString[1] = months[month][1];
+  outputString[2] = months[month][2];
+  outputString[3] = ' ';
+  outputString[4] = day / 10 + '0';
+  outputString[5] = day % 10 + '0';
+  outputString[6] = '\0';
+
+  displayEditFields(outputString, fieldStarts, fieldLengths, 2);
+}
+
+/**
+ * @brief Displays the given time being edited, hours then minutes then
+ * seconds
+ *
+ * @param seconds The time in seconds to display
+ */
+void displayEditTime(uint32_t seconds) {
+  static const uint8_t fieldStarts[] = {0, 3, 6};
+  static const uint8_t fieldLengths[] = {2, 2, 2};
+
+  // Lop off the days
+  seconds %= SEC_PER_DAY;
+
+  // Convert to hours, minutes, seconds
+  uint8_t hour = seconds / SEC_PER_HOUR;
+  seconds %= SEC_PER_HOUR;
+  uint8_t minute = seconds / SEC_PER_MIN;
+  seconds %= SEC_PER_MIN;
+  uint8_t second = seconds;
+
+  // Convert to strings
+  char outputString[9];
+  outputString[0] = hour / 10 + '0';
+  outputString[1] = hour % 10 + '0';
+  outputString[2] = ':';
+  outputString[3] = minute / 10 + '0';
+  outputString[4] = minute % 10 + '0';
+  outputString[5] = ':';
+  outputString[6] = second / 10 + '0';
+  outputString[7] = second % 10 + '0';
+  outputString[8] = '\0';
+
+  displayEditFields(outputString, fieldStarts, fieldLengths, 3);
+}
+
 /**
  * @brief Displays the given temperature in C in the center of the screen
  *
@@ -792,3 +971,72 @@ void displayTempF(float tempInF) {
     displayCenteredText(outputString);
   }
 }
+
+/**
+ * @brief Draws the chart of the stored temperature readings, oldest first
+ *
+ * The chart spans 1 C above and below the stored readings
+ */
+void displayTempChart() {
+  // Snapshot the readings, the ADC ISR adds one every second
+  __disable_interrupt();
+  uint8_t index = tempIndex;
+  uint8_t count = tempCount;
+  __enable_interrupt();
+
+  // The oldest reading is the next one to be overwritten once all are stored
+  uint8_t first = (count < TEMP_AVG_SAMPLES) ? 0 : index;
+
+  // Range of the chart, in tenths of a degree C
+  int16_t min = 0;
+  int16_t max = 0;
+  uint8_t i;
+  for (i = 0; i < count; i++) {
+    int16_t tenths = (int16_t)(tempReadings[i] * 10);
+    if (!i || tenths < min) {
+      min = tenths;
+    }
+    if (!i || tenths > max) {
+      max = tenths;
+    }
+  }
+
+  Graphics_clearDisplay(&g_sContext);
+  centerLabelShown = false;
+  Sharp96x96_StripChartInit(&tempChart, CHART_TOP, CHART_BOTTOM, min - 10,
+                            max + 10, CHART_STEP);
+
+  // Catch up on the stored readings
+  tempChartIndex = first;
+  for (i = 0; i < count; i++) {
+    chartTempReading(tempReadings[tempChartIndex]);
+    tempChartIndex++;
+    if (tempChartIndex >= TEMP_AVG_SAMPLES) {
+      tempChartIndex = 0;
+    }
+  }
+  tempChartIndex = index;
+
+  displayTempC(getTempCAvg());
+}
+
+/**
+ * @brief Adds a temperature reading to the right of the chart
+ *
+ * The whole screen scrolls left with the chart, so the temperature above it is
+ * cleared and must be displayed again
+ *
+ * @param tempC The temperature in C to add
+ */
+void chartTempReading(float tempC) {
+  Sharp96x96_StripChartAppend(&g_sContext, &tempChart, (int16_t)(tempC * 10));
+
+  // Clear what scrolled in over the temperature
+  Graphics_Rectangle rect = {0, 0, SHARP_SCREEN_WIDTH - 1, CHART_TOP - 1};
+  Graphics_setForegroundColor(&g_sContext, ClrWhite);
+  Graphics_fillRectangle(&g_sContext, &rect);
+  Graphics_setForegroundColor(&g_sContext, ClrBlack);
+
+  Sharp96x96_LabelInvalidate(&centerLabel);
+  centerLabelShown = true;
+}
@@ -2,8 +2,12 @@
 
 #include <msp430.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "peripherals.h"
+#include "button.h"
+#include "widget.h"
+#include "LcdDriver/Sharp96x96_Widgets.h"
 
 // Temperature Sensor Calibration = Reading at 30 degrees C is stored at addr
 // 1A1Ah See end of datasheet for TLV table memory mapping
@@ -25,10 +29,12 @@ float C_to_F(float tempC);
 void setupADCPot();
 uint16_t getPot();
 uint32_t getSec();
+uint32_t getMillis();
 void setTimerA2Count(uint8_t month, uint8_t day, uint8_t hour, uint8_t minute,
                      uint8_t second);
 void setTimerA2CountSec(uint32_t seconds);
 void clearDisplay();
+void serviceDisplay();
 void displayCenteredText(char* string);
 void displayCenteredTexts(uint8_t* string1, uint8_t* string2, uint8_t* string3,
                           uint8_t* string4);
@@ -37,5 +43,11 @@ uint8_t remainingDays(uint32_t days);
 uint16_t monthToDays(uint8_t month);
 void displayDate(uint32_t days);
 void displayTime(uint32_t timeInSeconds);
+void displayEditFields(char* string, const uint8_t* fieldStarts,
+                       const uint8_t* fieldLengths, uint8_t fields);
+void displayEditDate(uint32_t seconds);
+void displayEditTime(uint32_t seconds);
 void displayTempC(float averageTempC);
 void displayTempF(float averageTempF);
+void displayTempChart();
+void chartTempReading(float tempC);
@@ -20,6 +20,8 @@
 // Globals
 tContext g_sContext;    // user defined type used by graphics library
 
+static void keypadDriveColumn(unsigned char col);
+
 
 void initLeds(void)
 {
@@ -103,6 +105,41 @@ void BuzzerOff(void)
 }
 
 
+// Keypad scanner state, all owned by the Timer A1 CCR1 ISR except the queue
+static const unsigned char keyMap[KEYPAD_KEYS] =
+{
+    '1', '2', '3',
+    '4', '5', '6',
+    '7', '8', '9',
+    '*', '0', '#'
+};
+static unsigned char keyColumn;                     // Column being driven
+static unsigned char keyRows[KEYPAD_COLS];          // Rows read low, per column
+static unsigned char keyCount[KEYPAD_KEYS];         // Debounce integrators
+static unsigned int keyHeld[KEYPAD_KEYS];           // Samples held down
+static volatile unsigned int keyDown;               // Debounced keys, bit per key
+static volatile unsigned char keyLast;              // Last key pressed
+static KeyEvent keyQueue[KEY_QUEUE_LENGTH];
+static volatile unsigned char keyQueueHead;
+static volatile unsigned char keyQueueCount;
+
+// Wakeup events, set by the Timer A1 ISR and cleared by waitForEvent()
+static volatile unsigned char pendingEvents;
+static volatile unsigned char waitEvents;
+static volatile unsigned long eventTimerTicks;      // Left after this compare
+
+#ifdef MEASURE_ACTIVE_TIME
+// ACLK ticks spent asleep in waitForEvent(), and all ticks, since the last
+// getActivePercent(). TA1R is read when the CPU goes to sleep and wakes up,
+// and at every keypad scan so that it cannot wrap in between.
+static volatile bool sleeping;
+static volatile unsigned int sleepSince;
+static volatile unsigned int countedTo;
+static volatile unsigned long sleepTicks;
+static volatile unsigned long totalTicks;
+#endif
+
+
 void configKeypad(void)
 {
     // Configure digital IO for keypad
@@ -120,72 +157,380 @@ void configKeypad(void)
     P2SEL &= ~(BIT5|BIT4);
     P4SEL &= ~(BIT3);
 
-    // Columns are ??
-    P2DIR |= (BIT5|BIT4);
-    P1DIR |= BIT5;
-    P2OUT |= (BIT5|BIT4); //
-    P1OUT |= BIT5;        //
+    // Columns idle as inputs with pull ups, and are driven low one at a
+    // time by the scanner. Never driving a column high keeps two keys in
+    // the same row from shorting two outputs together.
+    P2DIR &= ~(BIT5|BIT4);
+    P1DIR &= ~BIT5;
+    P2REN |= (BIT5|BIT4);
+    P1REN |= BIT5;
+    P2OUT |= (BIT5|BIT4);
+    P1OUT |= BIT5;
 
-    // Rows are ??
+    // Rows are inputs with pull ups
     P1DIR &= ~(BIT2|BIT3|BIT4);
     P4DIR &= ~(BIT3);
     P4REN |= (BIT3);  //
     P1REN |= (BIT2|BIT3|BIT4);
     P4OUT |= (BIT3);  //
     P1OUT |= (BIT2|BIT3|BIT4);
+
+    keyColumn = 0;
+    keypadDriveColumn(keyColumn);
+
+    // Scan from Timer A1 CCR1, ACLK in continuous mode so it keeps
+    // running in LPM3. CCR2 times setEventTimer(), and CCR0 flips the
+    // display VCOM once configDisplay() has armed it.
+    TA1CTL = (TASSEL__ACLK|ID__1|MC__CONTINUOUS|TACLR);
+    TA1CCR1 = KEYPAD_SCAN_TICKS;
+    TA1CCTL1 = CCIE;
 }
 
 
 unsigned char getKey(void)
 {
-    // Returns ASCII value of key pressed from keypad or 0.
-    // Does not decode or detect when multiple keys pressed.
-    // smj -- 27 Dec 2015
-    // Updated -- 14 Jan 2018
+    // Returns ASCII value of the last key pressed that is still held
+    // down, or 0. Only reads the scanner state, the keypad is scanned
+    // in the background by the Timer A1 CCR1 ISR.
+
+    if (keyDown)
+        return(keyMap[keyLast]);
+
+    return(0);
+}
 
+
+unsigned char getKeyEvent(KeyEvent *event)
+{
+    // Takes the oldest keypad event from the queue.
+    // Returns 1 if event was filled in, 0 if the queue is empty.
+
+    unsigned short state = __get_interrupt_state();
     unsigned char ret_val = 0;
 
-    // Set Col1 = ?, Col2 = ? and Col3 = ?
-    P1OUT &= ~BIT5;
-    P2OUT |= (BIT5|BIT4);
-    // Now check value from each rows
-    if ((P4IN & BIT3)==0)
-        ret_val = '1';
-    if ((P1IN & BIT2)==0)
-        ret_val = '4';
-    if ((P1IN & BIT3)==0)
-        ret_val = '7';
-    if ((P1IN & BIT4)==0)
-        ret_val = '*';
+    __disable_interrupt();
+
+    if (keyQueueCount)
+    {
+        *event = keyQueue[keyQueueHead];
+        keyQueueHead = (keyQueueHead + 1) % KEY_QUEUE_LENGTH;
+        keyQueueCount--;
+        ret_val = 1;
+    }
+
+    __set_interrupt_state(state);
+
+    return(ret_val);
+}
+
+
+unsigned char getKeyPress(void)
+{
+    // Returns ASCII value of the next key press in the queue, or 0.
+    // Release and long press events before it are dropped.
+
+    KeyEvent event;
+
+    while (getKeyEvent(&event))
+    {
+        if (event.type == KEY_EVENT_PRESS)
+            return(event.key);
+    }
+
+    return(0);
+}
+
+
+static unsigned int readTimerA1(void)
+{
+    // Timer A1 runs from ACLK, read until two reads agree
+    unsigned int ticks;
+
+    do {
+        ticks = TA1R;
+    } while (ticks != TA1R);
+
+    return(ticks);
+}
+
+
+#ifdef MEASURE_ACTIVE_TIME
+static void countActiveTime(void)
+{
+    // Adds the ACLK ticks since the last count, with interrupts disabled
+    unsigned int now = readTimerA1();
+
+    totalTicks += (unsigned int)(now - countedTo);
+    countedTo = now;
+
+    if (sleeping)
+    {
+        sleepTicks += (unsigned int)(now - sleepSince);
+        sleepSince = now;
+    }
+}
+#endif
+
+
+void setEventTimer(unsigned long ms)
+{
+    // Raises EVENT_TIMER ms milliseconds from now, up to 131071ms,
+    // replacing the previous deadline. Timer A1 is started by
+    // configKeypad().
+
+    unsigned short state = __get_interrupt_state();
+    unsigned long ticks = (ms * CLOCK_ACLK_HZ + 999) / 1000;
+    unsigned int chunk;
+
+    __disable_interrupt();
+
+    TA1CCTL2 = 0;
+    pendingEvents &= ~EVENT_TIMER;
+
+    if (ticks == 0)
+    {
+        pendingEvents |= EVENT_TIMER;
+    }
+    else
+    {
+        // Compares are at most 0xC000 ticks ahead, and a long deadline
+        // is split so that its last compare is not a tick away
+        chunk = (ticks > 0xC000) ? 0x8000 : ticks;
+        eventTimerTicks = ticks - chunk;
+
+        TA1CCR2 = readTimerA1() + chunk;
+        TA1CCTL2 = CCIE;
+    }
+
+    __set_interrupt_state(state);
+}
+
+
+unsigned char waitForEvent(unsigned char events)
+{
+    // Sleeps until one of events happens, and returns the events that
+    // did. Events that happened since the last wait return at once.
+    //
+    // The CPU sleeps in LPM3, or in LPM0 while SMCLK is needed: when a
+    // display frame is going out by DMA, or the buzzer runs from SMCLK.
+
+    unsigned short state = __get_interrupt_state();
+    unsigned char ret_val;
+
+    __disable_interrupt();
+
+    waitEvents = events;
+
+    while (1)
+    {
+        // Events read from the queue leave it non empty
+        if (keyQueueCount)
+            pendingEvents |= EVENT_KEY;
+
+        if (pendingEvents & events)
+            break;
+
+#ifdef MEASURE_ACTIVE_TIME
+        sleepSince = readTimerA1();
+        sleeping = true;
+#endif
+
+        // Enabling GIE and sleeping is one instruction, so an event
+        // cannot be missed between the check and the sleep
+#ifdef USE_DMA_FLUSH
+        if (Sharp96x96_FlushBusy())
+            __bis_SR_register(LPM0_bits|GIE);
+        else
+#endif
+        if (TB0CCTL5 && ((TB0CTL & TBSSEL_3) == TBSSEL__SMCLK))
+            __bis_SR_register(LPM0_bits|GIE);
+        else
+            __bis_SR_register(LPM3_bits|GIE);
+
+        __disable_interrupt();
+
+#ifdef MEASURE_ACTIVE_TIME
+        countActiveTime();
+        sleeping = false;
+#endif
+    }
+
+    ret_val = pendingEvents & events;
+    pendingEvents &= ~ret_val;
+    waitEvents = 0;
+
+    __set_interrupt_state(state);
+
+    return(ret_val);
+}
+
+
+void sleepMillis(unsigned long ms)
+{
+    // Sleeps for ms milliseconds
+    setEventTimer(ms);
+
+    while (!waitForEvent(EVENT_TIMER))
+        ;
+}
+
+
+#ifdef MEASURE_ACTIVE_TIME
+unsigned char getActivePercent(void)
+{
+    // Returns the share of time since the last call that the CPU spent
+    // out of waitForEvent(), in percent. It is counted in ACLK ticks of
+    // about 30us, and ISRs that run while the CPU sleeps count as asleep.
+    // Call it at least every 20 minutes, or the count overflows.
+
+    unsigned short state = __get_interrupt_state();
+    unsigned char ret_val = 0;
+
+    __disable_interrupt();
+
+    countActiveTime();
+
+    if (totalTicks)
+        ret_val = 100 - (unsigned char)((sleepTicks * 100) / totalTicks);
+
+    sleepTicks = 0;
+    totalTicks = 0;
+
+    __set_interrupt_state(state);
+
+    return(ret_val);
+}
+#endif
+
+
+static void keypadDriveColumn(unsigned char col)
+{
+    // Release every column to its pull up, then drive col low
+    P1DIR &= ~BIT5;
+    P2DIR &= ~(BIT5|BIT4);
     P1OUT |= BIT5;
+    P2OUT |= (BIT5|BIT4);
 
-    // Set Col1 = ?, Col2 = ? and Col3 = ?
-    P2OUT &= ~BIT4;
-    // Now check value from each rows
-    if ((P4IN & BIT3)==0)
-        ret_val = '2';
-    if ((P1IN & BIT2)==0)
-        ret_val = '5';
-    if ((P1IN & BIT3)==0)
-        ret_val = '8';
-    if ((P1IN & BIT4)==0)
-        ret_val = '0';
-    P2OUT |= BIT4;
+    switch (col)
+    {
+    case 0:
+        P1OUT &= ~BIT5;
+        P1DIR |= BIT5;
+        break;
+    case 1:
+        P2OUT &= ~BIT4;
+        P2DIR |= BIT4;
+        break;
+    default:
+        P2OUT &= ~BIT5;
+        P2DIR |= BIT5;
+        break;
+    }
+}
+
+
+static unsigned char keypadReadRows(void)
+{
+    // Returns a bit per row pulled low by the driven column
+    unsigned char rows = 0;
 
-    // Set Col1 = ?, Col2 = ? and Col3 = ?
-    P2OUT &= ~BIT5;
-    // Now check value from each rows
     if ((P4IN & BIT3)==0)
-        ret_val = '3';
+        rows |= BIT0;
     if ((P1IN & BIT2)==0)
-        ret_val = '6';
+        rows |= BIT1;
     if ((P1IN & BIT3)==0)
-        ret_val = '9';
+        rows |= BIT2;
     if ((P1IN & BIT4)==0)
-        ret_val = '#';
-    P2OUT |= BIT5;
+        rows |= BIT3;
 
-    return(ret_val);
+    return(rows);
+}
+
+
+static void keypadPost(unsigned char type, unsigned char k)
+{
+    // Called from the ISR only
+    if (keyQueueCount < KEY_QUEUE_LENGTH)
+    {
+        keyQueue[(keyQueueHead + keyQueueCount) % KEY_QUEUE_LENGTH].type = type;
+        keyQueue[(keyQueueHead + keyQueueCount) % KEY_QUEUE_LENGTH].key = keyMap[k];
+        keyQueueCount++;
+        pendingEvents |= EVENT_KEY;
+    }
+}
+
+
+static void keypadUpdate(void)
+{
+    // Runs the debounce integrators on a complete scan of the matrix.
+    //
+    // Without diodes, three keys on the corners of a rectangle also
+    // pull the fourth corner's row low. Two columns sharing two or
+    // more rows is that pattern, and then the real keys cannot be told
+    // from the ghost, so the scan is ignored and every key keeps its
+    // state. Any other combination of keys is reported as is.
+
+    unsigned char row, col, k;
+    unsigned char common;
+    unsigned int bit;
+
+    for (col = 0; col < KEYPAD_COLS; col++)
+    {
+        for (k = col + 1; k < KEYPAD_COLS; k++)
+        {
+            common = keyRows[col] & keyRows[k];
+            if (common & (common - 1))
+                return;
+        }
+    }
+
+    for (row = 0; row < KEYPAD_ROWS; row++)
+    {
+        for (col = 0; col < KEYPAD_COLS; col++)
+        {
+            k = row * KEYPAD_COLS + col;
+            bit = 1u << k;
+
+            if (keyRows[col] & (1 << row))
+            {
+                if (keyCount[k] < KEYPAD_DEBOUNCE_SAMPLES)
+                {
+                    keyCount[k]++;
+                    if ((keyCount[k] == KEYPAD_DEBOUNCE_SAMPLES) && !(keyDown & bit))
+                    {
+                        keyDown |= bit;
+                        keyHeld[k] = 0;
+                        keyLast = k;
+                        keypadPost(KEY_EVENT_PRESS, k);
+                    }
+                }
+            }
+            else if (keyCount[k] > 0)
+            {
+                keyCount[k]--;
+                if ((keyCount[k] == 0) && (keyDown & bit))
+                {
+                    keyDown &= ~bit;
+                    keypadPost(KEY_EVENT_RELEASE, k);
+                }
+            }
+
+            if ((keyDown & bit) && (keyHeld[k] < KEYPAD_LONG_PRESS_SAMPLES))
+            {
+                keyHeld[k]++;
+                if (keyHeld[k] == KEYPAD_LONG_PRESS_SAMPLES)
+                    keypadPost(KEY_EVENT_LONG_PRESS, k);
+            }
+        }
+    }
+
+    // getKey() reports the lowest key still down once the last one is up
+    if (keyDown && !(keyDown & (1u << keyLast)))
+    {
+        for (k = 0; !(keyDown & (1u << k)); k++)
+            ;
+        keyLast = k;
+    }
 }
 
 
@@ -210,28 +555,73 @@ void configDisplay(void)
     Graphics_setFont(&g_sContext, &g_sFontFixed6x8);
     Graphics_clearDisplay(&g_sContext);
     Graphics_flushBuffer(&g_sContext);
+
+    // Flip VCOM about once a second from Timer A1 CCR0. Timer A1 runs
+    // from ACLK in continuous mode, shared with the keypad scanner, and
+    // is started here if configKeypad() has not started it yet.
+    if ((TA1CTL & MC_3) == MC__STOP)
+        TA1CTL = (TASSEL__ACLK|ID__1|MC__CONTINUOUS|TACLR);
+
+    TA1CCR0 = readTimerA1() + VCOM_TOGGLE_TICKS;
+    TA1CCTL0 = CCIE;
 }
 
 /*
-void setupSPI_DAC(void)
+ * The DAC (MCP4921) shares UCB0 with the display. Writes go through the
+ * SPI bus manager, so a DAC write made while a display frame is going out
+ * waits for the end of the current display line instead of the whole frame.
+ */
+static uint8_t dacWord[2];
+
+// Called from the bus interrupt once the DAC chip select is released
+static void dacLatch(void)
 {
-// ** Set UCSI A0 Reset=1 to configure control registers **
-     UCB0CTL1 |= UCSWRST;
-     // 3-pin (SCLK, SIMO, SOMI), 8-bit, this MSP430 is SPI master,
-     // Clock polarity high, send data MSB first
-     UCB0CTL0 = UCMST + UCSYNC + UCCKPH + UCMSB;
-     // Use SMCLK as clock source, keep RESET = 1
-     UCB0CTL1 = UCSWRST + UCSSEL_2;
+    // Pulse LDAC low to move the new code to the output
+    DAC_PORT_LDAC_OUT &= ~DAC_PIN_LDAC;
+    DAC_PORT_LDAC_OUT |= DAC_PIN_LDAC;
+}
 
-     UCB0BR0 = 2;   // SCLK = SMCLK/2 = 524288Hz
-     UCB0BR1 = 0;
+static const tSpiBusDevice dacDevice =
+{
+    &DAC_PORT_CS_OUT, DAC_PIN_CS, false, UCCKPH|UCMSB, DAC_SPI_CLK_TICKS
+};
 
-     //UCB0MCTL = 0;   // write MCTL as 0
+static const tSpiBusTransaction dacWrite =
+{
+    &dacDevice, dacWord, sizeof(dacWord), dacLatch
+};
 
-     // Enable UCSI A0
-     UCB0CTL1 &= ~UCSWRST;
+void DACInit(void)
+{
+    // CS (P8.2) and LDAC (P3.7) are outputs, idle high. The SPI pins and
+    // UCB0 are set up by configDisplay(), which must be called first.
+    DAC_PORT_CS_SEL &= ~DAC_PIN_CS;
+    DAC_PORT_CS_DIR |= DAC_PIN_CS;
+    DAC_PORT_CS_OUT |= DAC_PIN_CS;
+
+    DAC_PORT_LDAC_SEL &= ~DAC_PIN_LDAC;
+    DAC_PORT_LDAC_DIR |= DAC_PIN_LDAC;
+    DAC_PORT_LDAC_OUT |= DAC_PIN_LDAC;
+}
+
+void DACSetValue(unsigned int dac_code)
+{
+    // Writes a 12 bit code to the DAC. Returns straight away: the bus
+    // interrupt sends the write now if the bus is free, or as soon as the
+    // display lets go of it. A code written while the previous one is still
+    // waiting replaces it, one written while it goes out follows it.
+    unsigned short state = __get_interrupt_state();
+
+    __disable_interrupt();
+
+    // Channel A, unbuffered, gain 1x, output on, then the code, MSB first
+    dacWord[0] = 0x30 | ((dac_code >> 8) & 0x0F);
+    dacWord[1] = dac_code & 0xFF;
+
+    SpiBus_Submit(&dacWrite);
+
+    __set_interrupt_state(state);
 }
-*/
 
 //------------------------------------------------------------------------------
 // Timer1 A0 Interrupt Service Routine
@@ -239,7 +629,64 @@ void setupSPI_DAC(void)
 #pragma vector=TIMER1_A0_VECTOR
 __interrupt void TIMER1_A0_ISR (void)
 {
-	// Display is using Timer A1
-	// Not sure where Timer A1 is configured?
-	Sharp96x96_SendToggleVCOMCommand();  // display needs this toggle < 1 per sec
+	// Timer A1 CCR0, armed by configDisplay(). Flips VCOM, which the display
+	// needs about once a second. The flip rides on the next frame, or goes out
+	// by DMA if the bus is free, so this never waits for the SPI bus.
+	TA1CCR0 += VCOM_TOGGLE_TICKS;
+
+	Sharp96x96_SendToggleVCOMCommand();
+}
+
+//------------------------------------------------------------------------------
+// Timer1 A1 Interrupt Service Routine
+//------------------------------------------------------------------------------
+#pragma vector=TIMER1_A1_VECTOR
+__interrupt void TIMER1_A1_ISR (void)
+{
+    switch (__even_in_range(TA1IV, 14))
+    {
+    case TA1IV_TACCR1:
+        // Keypad scan: the column driven last time has settled for a
+        // scan period, read it and drive the next one
+        TA1CCR1 += KEYPAD_SCAN_TICKS;
+
+        keyRows[keyColumn] = keypadReadRows();
+
+        if (++keyColumn == KEYPAD_COLS)
+        {
+            keyColumn = 0;
+            keypadUpdate();
+            pendingEvents |= EVENT_TICK;
+        }
+
+        keypadDriveColumn(keyColumn);
+
+#ifdef MEASURE_ACTIVE_TIME
+        countActiveTime();
+#endif
+        break;
+
+    case TA1IV_TACCR2:
+        // Event timer, a long deadline takes several compares
+        if (eventTimerTicks)
+        {
+            unsigned int chunk = (eventTimerTicks > 0xC000) ? 0x8000 : eventTimerTicks;
+
+            eventTimerTicks -= chunk;
+            TA1CCR2 += chunk;
+        }
+        else
+        {
+            TA1CCTL2 = 0;
+            pendingEvents |= EVENT_TIMER;
+        }
+        break;
+
+    default:
+        break;
+    }
+
+    // Wake up waitForEvent() if it waits for one of the events
+    if (pendingEvents & waitEvents)
+        __bic_SR_register_on_exit(LPM3_bits);
 }
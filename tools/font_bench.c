@@ -0,0 +1,240 @@
+//*****************************************************************************
+//
+// font_bench.c - Measures how fast text is drawn into the DisplayBuffer.
+//
+// Draws the same strings with the driver's fixed cell path,
+// Sharp96x96_DrawString(), and with the generic grlib path,
+// Graphics_drawString(), which goes through the driver a pixel at a time, and
+// reports glyphs per second for each. String widths are timed the same way,
+// Sharp96x96_GetStringWidth() against Graphics_getStringWidth(). Nothing is
+// flushed, only the drawing is timed.
+//
+// The numbers are host numbers. Only the ratio between the two paths carries
+// over to the MSP430.
+//
+// Build and run it from the root of a lab project:
+//
+//     gcc -O2 -I ../tools/sharp_host -I grlib -I . -o font_bench
+//         ../tools/font_bench.c ../tools/sharp_host/sharp_spy.c
+//         ../tools/sharp_host/msp430_model.c ../tools/sharp_host/grlib_host.c
+//         LcdDriver/Sharp96x96.c LcdDriver/HAL_MSP_EXP430FR5529_Sharp96x96.c
+//         LcdDriver/HAL_MSP_EXP430FR5529_SpiBus.c
+//         fonts/fontfixed6x8.c fonts/fontfixed6x8_rot90.c
+//     ./font_bench
+//
+//*****************************************************************************
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+
+#include "grlib.h"
+#include "LcdDriver/Sharp96x96.h"
+#include "LcdDriver/HAL_MSP_EXP430FR5529_Sharp96x96.h"
+#include "sharp_spy.h"
+
+#ifndef ROTATE_90
+#error "The fixed cell path needs ROTATE_90"
+#endif
+
+#define NUM_ELEMENTS(a)     (sizeof(a) / sizeof((a)[0]))
+
+// How long each case runs for
+#define BENCH_SECONDS       0.5
+
+static Graphics_Context g_sContext;
+
+// Strings of the lab screens, drawn at positions that put the cells at
+// different bit offsets of the DisplayBuffer bytes
+static const char *const g_strings[] =
+{
+    "Select a song", "1: Twinkle", "You lost :(", "Rock on and",
+    "try again!", "Press #", "12:34:56", "Nov 05",
+};
+
+static const int32_t g_positions[][2] =
+{
+    { 9, 11 }, { 17, 26 }, { 10, 41 }, { 13, 57 },
+};
+
+//*****************************************************************************
+//
+// The cases. Each one draws or measures every string once, at every position,
+// and returns the number of glyphs it handled.
+//
+//*****************************************************************************
+static uint32_t drawFixed(bool opaque)
+{
+    uint32_t glyphs = 0;
+    unsigned i, j;
+
+    for(i = 0; i < NUM_ELEMENTS(g_strings); i++)
+    {
+        for(j = 0; j < NUM_ELEMENTS(g_positions); j++)
+        {
+            Sharp96x96_DrawString(&g_sContext, (const uint8_t *)g_strings[i],
+                                  AUTO_STRING_LENGTH, g_positions[j][0],
+                                  g_positions[j][1], opaque);
+            glyphs += strlen(g_strings[i]);
+        }
+    }
+
+    return glyphs;
+}
+
+static uint32_t drawGeneric(bool opaque)
+{
+    uint32_t glyphs = 0;
+    unsigned i, j;
+
+    for(i = 0; i < NUM_ELEMENTS(g_strings); i++)
+    {
+        for(j = 0; j < NUM_ELEMENTS(g_positions); j++)
+        {
+            Graphics_drawString(&g_sContext, (uint8_t *)g_strings[i],
+                                AUTO_STRING_LENGTH, g_positions[j][0],
+                                g_positions[j][1], opaque);
+            glyphs += strlen(g_strings[i]);
+        }
+    }
+
+    return glyphs;
+}
+
+static volatile int32_t g_lWidthSink;
+
+static uint32_t widthFixed(bool unused)
+{
+    uint32_t glyphs = 0;
+    unsigned i;
+
+    for(i = 0; i < NUM_ELEMENTS(g_strings); i++)
+    {
+        g_lWidthSink = Sharp96x96_GetStringWidth(&g_sContext,
+                                                 (const uint8_t *)g_strings[i],
+                                                 AUTO_STRING_LENGTH);
+        glyphs += strlen(g_strings[i]);
+    }
+
+    return glyphs;
+}
+
+static uint32_t widthGeneric(bool unused)
+{
+    uint32_t glyphs = 0;
+    unsigned i;
+
+    for(i = 0; i < NUM_ELEMENTS(g_strings); i++)
+    {
+        g_lWidthSink = Graphics_getStringWidth(&g_sContext,
+                                               (const int8_t *)g_strings[i],
+                                               AUTO_STRING_LENGTH);
+        glyphs += strlen(g_strings[i]);
+    }
+
+    return glyphs;
+}
+
+//*****************************************************************************
+//
+// Runs a case for BENCH_SECONDS and returns glyphs per second.
+//
+//*****************************************************************************
+static double run(uint32_t (*bench)(bool), bool opaque)
+{
+    clock_t start = clock();
+    clock_t end = start + (clock_t)(BENCH_SECONDS * CLOCKS_PER_SEC);
+    clock_t now;
+    uint64_t glyphs = 0;
+
+    do
+    {
+        glyphs += bench(opaque);
+        now = clock();
+    }
+    while(now < end);
+
+    return glyphs / ((double)(now - start) / CLOCKS_PER_SEC);
+}
+
+//*****************************************************************************
+//
+// Checks that both paths draw the same pixels, so that the comparison is
+// fair, by comparing what they send to the panel. Returns non-zero if they
+// differ.
+//
+//*****************************************************************************
+static int checkSame(bool opaque)
+{
+    static uint8_t fixed[LCD_VERTICAL_MAX][LCD_HORIZONTAL_MAX >> 3];
+    uint16_t line;
+    int differ = 0;
+
+    Graphics_clearDisplay(&g_sContext);
+    drawFixed(opaque);
+    Graphics_flushBuffer(&g_sContext);
+
+    for(line = 0; line < LCD_VERTICAL_MAX; line++)
+    {
+        memcpy(fixed[line], spyPanelLine(line), sizeof(fixed[line]));
+    }
+
+    Graphics_clearDisplay(&g_sContext);
+    drawGeneric(opaque);
+    Graphics_flushBuffer(&g_sContext);
+
+    for(line = 0; line < LCD_VERTICAL_MAX; line++)
+    {
+        differ |= memcmp(fixed[line], spyPanelLine(line), sizeof(fixed[line]));
+    }
+
+    return differ;
+}
+
+int main(void)
+{
+    static const struct
+    {
+        const char *name;
+        uint32_t (*fixed)(bool);
+        uint32_t (*generic)(bool);
+        bool opaque;
+    }
+    cases[] =
+    {
+        { "draw transparent", drawFixed, drawGeneric, false },
+        { "draw opaque", drawFixed, drawGeneric, true },
+        { "string width", widthFixed, widthGeneric, false },
+    };
+    double fixed, generic;
+    unsigned i;
+
+    // As configDisplay() does
+    Sharp96x96_Init();
+    Graphics_initContext(&g_sContext, &g_sharp96x96LCD);
+    Graphics_setForegroundColor(&g_sContext, ClrBlack);
+    Graphics_setBackgroundColor(&g_sContext, ClrWhite);
+    Graphics_setFont(&g_sContext, &g_sFontFixed6x8);
+
+    if(checkSame(false) || checkSame(true))
+    {
+        fprintf(stderr, "the fixed cell and generic paths draw different pixels\n");
+        return 1;
+    }
+
+    printf("%-18s %14s %14s %8s\n", "case", "fixed glyph/s", "grlib glyph/s",
+           "speedup");
+
+    for(i = 0; i < NUM_ELEMENTS(cases); i++)
+    {
+        fixed = run(cases[i].fixed, cases[i].opaque);
+        generic = run(cases[i].generic, cases[i].opaque);
+
+        printf("%-18s %14.0f %14.0f %7.1fx\n", cases[i].name, fixed, generic,
+               fixed / generic);
+    }
+
+    return 0;
+}
@@ -0,0 +1,659 @@
+//*****************************************************************************
+//
+// gfx_bench.c - Graphics micro-benchmarks, on the host or on an MSP430.
+//
+// Times the primitives the labs draw with, each through the driver of a lab
+// project: pixels, horizontal and vertical lines, rectangle fills, images,
+// centered strings, clearing the screen and flushing it to the panel. Every
+// case repeats an operation BENCH_REPS times and reports the average cost of
+// one operation, and of one item of it (a pixel, a line, a glyph...), in
+// ticks, with the items per thousand ticks. The cost of reading the tick
+// counter itself, the overhead case, is taken off every other case.
+//
+// The *_bytes fill cases draw through a copy of the driver display whose
+// rectangle fill is the byte at a time one the driver had before its span
+// engine, into a buffer of its own, so that the fill rate of the two can be
+// compared within one report.
+//
+// The frame_* cases produce the bytes of a full frame multiple line write the
+// two ways a polled flush can, into a volatile byte standing in for TXBUF:
+// frame_lines a line at a time out of a plain buffer, scanning the dirty line
+// bitmap and reversing every address as the driver does without
+// WIRE_FORMAT_BUFFER, and frame_wire as one linear block of a wire format
+// buffer as Sharp96x96_SendWireFrame() does. Their difference is the CPU time
+// the wire format saves on a flush, which a polled flush at SMCLK/1 is bound
+// by. The flush_* cases include the SPI port itself.
+//
+// The report is CSV with a comment line giving the tick unit and the driver
+// configuration, so reports of two builds can be diffed directly.
+//
+// On the host a tick is a nanosecond. The driver and its HAL are built against
+// the peripheral model of sharp_host and the grlib primitives are those of
+// grlib_host.c, so only the ratios between two driver builds carry over to the
+// MSP430. Build
+// and run it from the root of a lab project that has an images directory:
+//
+//     gcc -O2 -I ../tools/sharp_host -I grlib -I . -o gfx_bench
+//         ../tools/gfx_bench.c ../tools/sharp_host/sharp_spy.c
+//         ../tools/sharp_host/msp430_model.c ../tools/sharp_host/grlib_host.c
+//         LcdDriver/Sharp96x96.c LcdDriver/HAL_MSP_EXP430FR5529_Sharp96x96.c
+//         LcdDriver/HAL_MSP_EXP430FR5529_SpiBus.c
+//         fonts/fontfixed6x8.c fonts/fontfixed6x8_rot90.c images/*.c
+//     ./gfx_bench > host.csv
+//
+// Add -DBENCH_REPS=10000 for steadier host figures.
+//
+// On the MSP430 a tick is an MCLK cycle, counted by TA0 running from SMCLK,
+// which Clock_Init() runs at the MCLK rate. One operation must take less than
+// 131072 cycles. The DMA flush engine of the HAL shares TA0, its CCR0 compare
+// releases the LCD chip select, so benchStart() only clears the counter with
+// no frame in flight. Build it with the real HAL and the MSP430Ware grlib
+// sources in place of the host stand-ins:
+//
+//     msp430-elf-gcc -mmcu=msp430f5529 -O2 -I <msp430-gcc>/include -I grlib
+//         -I . -I $MSP430WARE_ROOT/grlib/grlib -o gfx_bench.elf
+//         ../tools/gfx_bench.c LcdDriver/*.c fonts/fontfixed6x8.c
+//         fonts/fontfixed6x8_rot90.c images/*.c
+//         $MSP430WARE_ROOT/grlib/grlib/*.c
+//
+// The report is written to g_benchReport, and benchDone() is called when it
+// is complete. On a LaunchPad, or in a simulator such as the mspdebug sim
+// driver with its Timer_A model mapped at the TA0 base address 0x0340, stop
+// there and dump the buffer:
+//
+//     mspdebug sim
+//     (mspdebug) simio add timer ta0
+//     (mspdebug) simio config ta0 base 0x0340
+//     (mspdebug) prog gfx_bench.elf
+//     (mspdebug) setbreak benchDone
+//     (mspdebug) run
+//     (mspdebug) md g_benchReport 1024
+//
+// Simulators without a USCI or DMA model never see a frame complete. Define
+// BENCH_NO_FLUSH for them, to leave out the flush cases.
+//
+//*****************************************************************************
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#ifdef __MSP430__
+#include <msp430.h>
+#else
+#include <time.h>
+#endif
+
+#include "grlib.h"
+#include "LcdDriver/Sharp96x96.h"
+#include "LcdDriver/HAL_MSP_EXP430FR5529_Sharp96x96.h"
+#include "images/images.h"
+
+#define NUM_ELEMENTS(a)     (sizeof(a) / sizeof((a)[0]))
+
+// Times each operation is repeated. A simulator runs a few hundred times
+// slower than the part, so the MSP430 build keeps it short.
+#ifndef BENCH_REPS
+#ifdef __MSP430__
+#define BENCH_REPS          16
+#else
+#define BENCH_REPS          1000
+#endif
+#endif
+
+// Size of the report
+#define BENCH_REPORT_BYTES  1024
+
+// Items of the batched primitives
+#define PIXELS_PER_OP       64
+#define LINES_PER_OP        16
+
+#define BENCH_STRING        "Hello World!"
+
+#ifdef __MSP430__
+#define BENCH_TICK_UNIT     "cycles"
+#else
+#define BENCH_TICK_UNIT     "ns"
+#endif
+
+static Graphics_Context g_sContext;
+
+// The driver display with the byte at a time rectangle fill
+static Graphics_Display g_sByteDisplay;
+static Graphics_Context g_sByteContext;
+static uint8_t g_pucByteBuffer[LCD_VERTICAL_MAX][LCD_HORIZONTAL_MAX>>3];
+
+// The frame_* cases, which send g_pucByteBuffer line by line
+static volatile uint8_t g_ucTxSink;
+static uint8_t g_pucWireFrame[SHARP_WIRE_FRAME_BYTES];
+static uint16_t g_puiFrameLines[SHARP_LINE_BITMAP_WORDS];
+
+char g_benchReport[BENCH_REPORT_BYTES];
+static uint16_t g_uiReportUsed;
+
+//*****************************************************************************
+//
+// The tick counter. benchStart() restarts it and benchStop() returns the ticks
+// since.
+//
+//*****************************************************************************
+#ifdef __MSP430__
+static void benchInitTicks(void)
+{
+    TA0CTL = TASSEL__SMCLK | MC__CONTINUOUS | TACLR;
+}
+
+static inline void benchStart(void)
+{
+    TA0CTL = (TA0CTL | TACLR) & ~TAIFG;
+}
+
+static inline uint32_t benchStop(void)
+{
+    uint32_t ulTicks = TA0R;
+
+    // An overflow before TA0R was read leaves it small, one after it was
+    // read leaves it large
+    if((TA0CTL & TAIFG) && (ulTicks < 0x8000))
+    {
+        ulTicks += 0x10000;
+    }
+
+    return ulTicks;
+}
+#else
+static struct timespec g_sStart;
+
+static void benchInitTicks(void)
+{
+}
+
+static inline void benchStart(void)
+{
+    clock_gettime(CLOCK_MONOTONIC, &g_sStart);
+}
+
+static inline uint32_t benchStop(void)
+{
+    struct timespec sNow;
+
+    clock_gettime(CLOCK_MONOTONIC, &sNow);
+
+    return (uint32_t)((sNow.tv_sec - g_sStart.tv_sec) * 1000000000L +
+                      (sNow.tv_nsec - g_sStart.tv_nsec));
+}
+#endif
+
+//*****************************************************************************
+//
+// Called once the report is complete, a place for a debugger to stop.
+//
+//*****************************************************************************
+void __attribute__((noinline)) benchDone(void)
+{
+#ifdef __MSP430__
+    while(1)
+    {
+        __no_operation();
+    }
+#else
+    fputs(g_benchReport, stdout);
+#endif
+}
+
+//*****************************************************************************
+//
+// Appends a line to the report.
+//
+//*****************************************************************************
+static void report(const char *pcFormat, ...)
+    __attribute__((format(printf, 1, 2)));
+
+static void report(const char *pcFormat, ...)
+{
+    va_list args;
+    int iLength;
+
+    va_start(args, pcFormat);
+    iLength = vsnprintf(&g_benchReport[g_uiReportUsed],
+                        BENCH_REPORT_BYTES - g_uiReportUsed, pcFormat, args);
+    va_end(args);
+
+    if(iLength > 0)
+    {
+        g_uiReportUsed += iLength;
+
+        if(g_uiReportUsed >= BENCH_REPORT_BYTES)
+        {
+            g_uiReportUsed = BENCH_REPORT_BYTES - 1;
+        }
+    }
+}
+
+//*****************************************************************************
+//
+// The rectangle fill of the driver before its span engine, the reference of
+// the rect_fill_*_bytes cases. It fills a byte at a time through volatile
+// locals and picks the color for every line, as the driver did. Its bug of
+// only filling the first line of a rectangle within one byte column is kept;
+// the cases do not draw such rectangles.
+//
+//*****************************************************************************
+static void benchByteRectFill(void *pvDisplayData, const Graphics_Rectangle *pRect,
+                              uint16_t ulValue)
+{
+#ifdef ROTATE_90
+    Graphics_Rectangle tempRect = *pRect;
+
+    tempRect.xMin = pRect->yMin;
+    tempRect.xMax = pRect->yMax;
+    tempRect.yMin = LCD_HORIZONTAL_MAX - pRect->xMax - 1;
+    tempRect.yMax = LCD_HORIZONTAL_MAX - pRect->xMin - 1;
+
+    pRect = &tempRect;
+#endif
+
+    volatile uint16_t xi = 0;
+    volatile uint16_t yi = 0;
+    volatile uint16_t x_index_min = pRect->xMin>>3;
+    volatile uint16_t x_index_max = pRect->xMax>>3;
+    volatile uint8_t *pucData, ucfirst_x_byte, uclast_x_byte;
+
+    ucfirst_x_byte = (0xFF >> (pRect->xMin & 0x7));
+    uclast_x_byte = (0xFF << (7-(pRect->xMax & 0x7)));
+
+    if(x_index_min != x_index_max)
+    {
+        for(yi = pRect->yMin; yi <= pRect->yMax; yi++)
+        {
+            pucData = &g_pucByteBuffer[yi][x_index_min];
+
+            if(ClrBlack == ulValue)
+            {
+                *pucData++ &= ~ucfirst_x_byte;
+
+                for(xi = x_index_min; xi < x_index_max-1; xi++)
+                {
+                    *pucData++ = 0x00;
+                }
+
+                *pucData &= ~uclast_x_byte;
+            }
+            else
+            {
+                *pucData++ |= ucfirst_x_byte;
+
+                for(xi = x_index_min; xi < x_index_max-1; xi++)
+                {
+                    *pucData++ = 0xFF;
+                }
+
+                *pucData |= uclast_x_byte;
+            }
+        }
+    }
+    else
+    {
+        ucfirst_x_byte &= uclast_x_byte;
+        pucData = &g_pucByteBuffer[pRect->yMin][x_index_min];
+
+        if(ClrBlack == ulValue)
+        {
+            *pucData &= ~ucfirst_x_byte;
+        }
+        else
+        {
+            *pucData |= ucfirst_x_byte;
+        }
+    }
+}
+
+//*****************************************************************************
+//
+// Waits for the frame handed to the panel to be complete, so that a flush is
+// timed up to its last byte.
+//
+//*****************************************************************************
+static void waitFrame(void)
+{
+#ifdef USE_DMA_FLUSH
+    while(Sharp96x96_FlushBusy())
+    {
+        __no_operation();
+    }
+#endif
+}
+
+//*****************************************************************************
+//
+// The cases. Setup runs before every repetition and is not timed.
+//
+//*****************************************************************************
+static void runNothing(void)
+{
+}
+
+static void runPixels(void)
+{
+    uint16_t i;
+
+    for(i = 0; i < PIXELS_PER_OP; i++)
+    {
+        Graphics_drawPixel(&g_sContext, i & 0x3F, 16 + (i >> 3));
+    }
+}
+
+static void runLinesH(void)
+{
+    int32_t y;
+
+    for(y = 8; y < 8 + LINES_PER_OP; y++)
+    {
+        Graphics_drawLineH(&g_sContext, 0, SHARP_SCREEN_WIDTH - 1, y);
+    }
+}
+
+static void runLinesV(void)
+{
+    int32_t x;
+
+    for(x = 8; x < 8 + LINES_PER_OP; x++)
+    {
+        Graphics_drawLineV(&g_sContext, x, 0, SHARP_SCREEN_HEIGHT - 1);
+    }
+}
+
+static const Graphics_Rectangle g_sRect = { 10, 10, 57, 57 };
+
+static void runRectFill(void)
+{
+    Graphics_fillRectangle(&g_sContext, &g_sRect);
+}
+
+static void runRectFillBytes(void)
+{
+    Graphics_fillRectangle(&g_sByteContext, &g_sRect);
+}
+
+// Both colors, so that every line is written whatever was there
+static const Graphics_Rectangle g_sFullRect =
+{
+    0, 0, SHARP_SCREEN_WIDTH - 1, SHARP_SCREEN_HEIGHT - 1
+};
+
+static void runRectFillScreen(void)
+{
+    Graphics_setForegroundColor(&g_sContext, ClrWhite);
+    Graphics_fillRectangle(&g_sContext, &g_sFullRect);
+    Graphics_setForegroundColor(&g_sContext, ClrBlack);
+    Graphics_fillRectangle(&g_sContext, &g_sFullRect);
+}
+
+static void runRectFillScreenBytes(void)
+{
+    Graphics_setForegroundColor(&g_sByteContext, ClrWhite);
+    Graphics_fillRectangle(&g_sByteContext, &g_sFullRect);
+    Graphics_setForegroundColor(&g_sByteContext, ClrBlack);
+    Graphics_fillRectangle(&g_sByteContext, &g_sFullRect);
+}
+
+static void runFrameLines(void)
+{
+    const uint8_t *pucData;
+    uint16_t wi;
+    uint16_t bits;
+    uint8_t line;
+    uint8_t xi;
+
+    g_ucTxSink = SHARP_LCD_CMD_WRITE_LINE;
+
+    for(wi = 0; wi < SHARP_LINE_BITMAP_WORDS; wi++)
+    {
+        bits = g_puiFrameLines[wi];
+
+        for(line = wi << 4; bits; line++, bits >>= 1)
+        {
+            if(bits & 0x1)
+            {
+                pucData = g_pucByteBuffer[line];
+
+                g_ucTxSink = reverse(line + 1);
+
+                for(xi = 0; xi < (LCD_HORIZONTAL_MAX>>3); xi++)
+                {
+                    g_ucTxSink = *(pucData++);
+                }
+
+                g_ucTxSink = SHARP_LCD_TRAILER_BYTE;
+            }
+        }
+    }
+
+    g_ucTxSink = SHARP_LCD_TRAILER_BYTE;
+}
+
+static void runFrameWire(void)
+{
+    uint16_t wi;
+
+    for(wi = 0; wi < SHARP_WIRE_FRAME_BYTES; wi++)
+    {
+        g_ucTxSink = g_pucWireFrame[wi];
+    }
+}
+
+static void runImage(void)
+{
+    Graphics_drawImage(&g_sContext, &TI_Logo_69x64_1BPP_UNCOMP, 13, 16);
+}
+
+static void runString(void)
+{
+    Graphics_drawStringCentered(&g_sContext, (uint8_t *)BENCH_STRING,
+                                AUTO_STRING_LENGTH, SHARP_SCREEN_WIDTH / 2,
+                                SHARP_SCREEN_HEIGHT / 2, OPAQUE_TEXT);
+}
+
+#ifdef ROTATE_90
+static void runStringRotated(void)
+{
+    Sharp96x96_DrawStringCentered(&g_sContext, (const uint8_t *)BENCH_STRING,
+                                  AUTO_STRING_LENGTH, SHARP_SCREEN_WIDTH / 2,
+                                  SHARP_SCREEN_HEIGHT / 2, OPAQUE_TEXT);
+}
+#endif
+
+static void runClear(void)
+{
+    Graphics_clearDisplay(&g_sContext);
+}
+
+#ifndef BENCH_NO_FLUSH
+// Dirties every line. Clearing would not, the panel is cleared by command.
+static const Graphics_Rectangle g_sScreen =
+{
+    0, 0, SHARP_SCREEN_WIDTH - 1, SHARP_SCREEN_HEIGHT - 1
+};
+
+static void setupFullFrame(void)
+{
+    Graphics_fillRectangle(&g_sContext, &g_sScreen);
+}
+
+// Dirties a single line whatever the orientation
+static void setupOneLine(void)
+{
+    Graphics_drawPixel(&g_sContext, 10, 10);
+}
+
+static void runFlush(void)
+{
+    Graphics_flushBuffer(&g_sContext);
+    waitFrame();
+}
+#endif
+
+static const struct
+{
+    const char *name;
+    void (*pfnSetup)(void);
+    void (*pfnRun)(void);
+    uint16_t uiItems;
+}
+g_cases[] =
+{
+    { "overhead", 0, runNothing, 1 },
+    { "pixel", 0, runPixels, PIXELS_PER_OP },
+    { "line_h", 0, runLinesH, LINES_PER_OP },
+    { "line_v", 0, runLinesV, LINES_PER_OP },
+    { "rect_fill_48x48", 0, runRectFill, 48 * 48 },
+    { "rect_fill_48x48_bytes", 0, runRectFillBytes, 48 * 48 },
+    { "rect_fill_screen_x2", 0, runRectFillScreen,
+      2 * SHARP_SCREEN_WIDTH * SHARP_SCREEN_HEIGHT },
+    { "rect_fill_screen_x2_bytes", 0, runRectFillScreenBytes,
+      2 * SHARP_SCREEN_WIDTH * SHARP_SCREEN_HEIGHT },
+    { "frame_lines", 0, runFrameLines, LCD_VERTICAL_MAX },
+    { "frame_wire", 0, runFrameWire, LCD_VERTICAL_MAX },
+    { "image_69x64", 0, runImage, 69 * 64 },
+    { "string_centered", 0, runString, sizeof(BENCH_STRING) - 1 },
+#ifdef ROTATE_90
+    { "string_centered_rot90", 0, runStringRotated, sizeof(BENCH_STRING) - 1 },
+#endif
+    { "clear", 0, runClear, 1 },
+#ifndef BENCH_NO_FLUSH
+    { "flush_full", setupFullFrame, runFlush, LCD_VERTICAL_MAX },
+    { "flush_1_line", setupOneLine, runFlush, 1 },
+#endif
+};
+
+//*****************************************************************************
+//
+// Returns the total ticks of BENCH_REPS operations of case i, less the
+// overhead of reading the tick counter ulOverhead times.
+//
+//*****************************************************************************
+static uint32_t run(unsigned i, uint32_t ulOverhead)
+{
+    uint32_t ulTotal = 0;
+    uint32_t ulTicks;
+    uint16_t uiRep;
+
+    for(uiRep = 0; uiRep < BENCH_REPS; uiRep++)
+    {
+        if(g_cases[i].pfnSetup)
+        {
+            g_cases[i].pfnSetup();
+#ifndef BENCH_NO_FLUSH
+            waitFrame();
+#endif
+        }
+
+        benchStart();
+        g_cases[i].pfnRun();
+        ulTicks = benchStop();
+
+        ulTotal += (ulTicks > ulOverhead) ? (ulTicks - ulOverhead) : 0;
+    }
+
+    return ulTotal;
+}
+
+int main(void)
+{
+    uint32_t ulOverhead = 0;
+    uint32_t ulTotal;
+    uint32_t ulCount;
+    unsigned i;
+
+#ifdef __MSP430__
+    WDTCTL = WDTPW | WDTHOLD;
+    Clock_Init();
+#endif
+
+    // As configDisplay() does
+    Sharp96x96_Init();
+    Graphics_initContext(&g_sContext, &g_sharp96x96LCD);
+    Graphics_setForegroundColor(&g_sContext, ClrBlack);
+    Graphics_setBackgroundColor(&g_sContext, ClrWhite);
+    Graphics_setFont(&g_sContext, &g_sFontFixed6x8);
+    Graphics_clearDisplay(&g_sContext);
+    Graphics_flushBuffer(&g_sContext);
+
+    g_sByteDisplay = g_sharp96x96LCD;
+    g_sByteDisplay.callRectFill = benchByteRectFill;
+    Graphics_initContext(&g_sByteContext, &g_sByteDisplay);
+    Graphics_setForegroundColor(&g_sByteContext, ClrBlack);
+    Graphics_setBackgroundColor(&g_sByteContext, ClrWhite);
+
+    for(i = 0; i < SHARP_LINE_BITMAP_WORDS; i++)
+    {
+        g_puiFrameLines[i] = 0xFFFF;
+    }
+
+    benchInitTicks();
+
+    // The DMA flush completes in its ISR
+    __enable_interrupt();
+
+    report("# gfx_bench ticks=%s lcd=%ux%u reps=%u rot90=%d dma=%d "
+           "double=%d wire=%d list=%d scroll=%d\n",
+           BENCH_TICK_UNIT, LCD_HORIZONTAL_MAX, LCD_VERTICAL_MAX, BENCH_REPS,
+#ifdef ROTATE_90
+           1,
+#else
+           0,
+#endif
+#ifdef USE_DMA_FLUSH
+           1,
+#else
+           0,
+#endif
+#ifdef DOUBLE_BUFFER
+           1,
+#else
+           0,
+#endif
+#ifdef WIRE_FORMAT_BUFFER
+           1,
+#else
+           0,
+#endif
+#ifdef DISPLAY_LIST
+           1,
+#else
+           0,
+#endif
+#ifdef SCROLL_BUFFER
+           1
+#else
+           0
+#endif
+           );
+    report("case,items_per_op,ticks_per_op,ticks_per_item,items_per_kilotick\n");
+
+    for(i = 0; i < NUM_ELEMENTS(g_cases); i++)
+    {
+        ulTotal = run(i, ulOverhead);
+
+        // The first case measures the tick counter alone
+        if(i == 0)
+        {
+            ulOverhead = ulTotal / BENCH_REPS;
+        }
+
+        // Two decimals without floating point
+        ulCount = (uint32_t)BENCH_REPS * g_cases[i].uiItems;
+
+        report("%s,%u,%lu,%lu.%02lu,%lu\n", g_cases[i].name,
+               g_cases[i].uiItems, (unsigned long)(ulTotal / BENCH_REPS),
+               (unsigned long)(ulTotal / ulCount),
+               (unsigned long)((ulTotal % ulCount) * 100 / ulCount),
+               (unsigned long)(ulTotal ? (uint64_t)ulCount * 1000 / ulTotal : 0));
+    }
+
+    benchDone();
+
+    return 0;
+}
@@ -0,0 +1,196 @@
+//*****************************************************************************
+//
+// image_bench.c - Measures the flash and draw time of the bundled images.
+//
+// Every image of a lab's images directory is drawn into the DisplayBuffer in
+// each of its forms: the original Graphics_Image through Graphics_drawImage(),
+// the rotated image through Sharp96x96_DrawRotatedImage() and the packed
+// image through Sharp96x96_DrawPackedImage(). The three are first checked to
+// draw the same pixels, then timed. Nothing is flushed, only the drawing is
+// timed.
+//
+// The times are host times. Only the ratios between the forms carry over to
+// the MSP430.
+//
+// Build and run it from the root of a lab project that has an images
+// directory:
+//
+//     gcc -O2 -I ../tools/sharp_host -I grlib -I . -o image_bench
+//         ../tools/image_bench.c ../tools/sharp_host/sharp_spy.c
+//         ../tools/sharp_host/msp430_model.c ../tools/sharp_host/grlib_host.c
+//         LcdDriver/Sharp96x96.c LcdDriver/HAL_MSP_EXP430FR5529_Sharp96x96.c
+//         LcdDriver/HAL_MSP_EXP430FR5529_SpiBus.c
+//         fonts/fontfixed6x8.c fonts/fontfixed6x8_rot90.c images/*.c
+//     ./image_bench
+//
+//*****************************************************************************
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+
+#include "grlib.h"
+#include "LcdDriver/Sharp96x96.h"
+#include "LcdDriver/HAL_MSP_EXP430FR5529_Sharp96x96.h"
+#include "images/images.h"
+#include "sharp_spy.h"
+
+#if !defined(ROTATE_90) || defined(DISPLAY_LIST)
+#error "Packed images need ROTATE_90 without DISPLAY_LIST"
+#endif
+
+#define NUM_ELEMENTS(a)     (sizeof(a) / sizeof((a)[0]))
+
+// How long each case runs for
+#define BENCH_SECONDS       0.5
+
+static Graphics_Context g_sContext;
+
+static const struct
+{
+    const char *name;
+    const Graphics_Image *image;
+    const Sharp96x96_RotatedImage *rotated;
+    const Sharp96x96_PackedImage *packed;
+    int16_t x;
+    int16_t y;
+}
+g_images[] =
+{
+    { "LPRocket_96x37", &LPRocket_96x37_1BPP_UNCOMP, &LPRocket_96x37_ROT90,
+      &LPRocket_96x37_PACKED, 0, 30 },
+    { "TI_Logo_69x64", &TI_Logo_69x64_1BPP_UNCOMP, &TI_Logo_69x64_ROT90,
+      &TI_Logo_69x64_PACKED, 13, 16 },
+};
+
+//*****************************************************************************
+//
+// Draws image i in one of its forms.
+//
+//*****************************************************************************
+enum
+{
+    FORM_GRLIB,
+    FORM_ROTATED,
+    FORM_PACKED,
+    NUM_FORMS
+};
+
+static void draw(unsigned i, int form)
+{
+    switch(form)
+    {
+    case FORM_GRLIB:
+        Graphics_drawImage(&g_sContext, g_images[i].image, g_images[i].x,
+                           g_images[i].y);
+        break;
+
+    case FORM_ROTATED:
+        Sharp96x96_DrawRotatedImage(&g_sContext, g_images[i].rotated,
+                                    g_images[i].x, g_images[i].y);
+        break;
+
+    default:
+        Sharp96x96_DrawPackedImage(&g_sContext, g_images[i].packed,
+                                   g_images[i].x, g_images[i].y);
+        break;
+    }
+}
+
+//*****************************************************************************
+//
+// Returns the average time of a draw in microseconds.
+//
+//*****************************************************************************
+static double run(unsigned i, int form)
+{
+    clock_t start = clock();
+    clock_t end = start + (clock_t)(BENCH_SECONDS * CLOCKS_PER_SEC);
+    clock_t now;
+    uint32_t draws = 0;
+
+    do
+    {
+        draw(i, form);
+        draws++;
+        now = clock();
+    }
+    while(now < end);
+
+    return ((double)(now - start) / CLOCKS_PER_SEC) * 1000000 / draws;
+}
+
+//*****************************************************************************
+//
+// Checks that every form of image i draws the same pixels, by comparing what
+// they send to the panel. Returns non-zero if they differ.
+//
+//*****************************************************************************
+static int checkSame(unsigned i)
+{
+    static uint8_t first[LCD_VERTICAL_MAX][LCD_HORIZONTAL_MAX >> 3];
+    uint16_t line;
+    int form;
+    int differ = 0;
+
+    for(form = 0; form < NUM_FORMS; form++)
+    {
+        Graphics_clearDisplay(&g_sContext);
+        draw(i, form);
+        Graphics_flushBuffer(&g_sContext);
+
+        for(line = 0; line < LCD_VERTICAL_MAX; line++)
+        {
+            if(!form)
+            {
+                memcpy(first[line], spyPanelLine(line), sizeof(first[line]));
+            }
+            else
+            {
+                differ |= memcmp(first[line], spyPanelLine(line),
+                                 sizeof(first[line]));
+            }
+        }
+    }
+
+    return differ;
+}
+
+int main(void)
+{
+    const Graphics_Image *image;
+    unsigned i;
+
+    // As configDisplay() does
+    Sharp96x96_Init();
+    Graphics_initContext(&g_sContext, &g_sharp96x96LCD);
+    Graphics_setForegroundColor(&g_sContext, ClrBlack);
+    Graphics_setBackgroundColor(&g_sContext, ClrWhite);
+
+    printf("%-16s %18s %18s %18s\n", "", "grlib", "rotated", "packed");
+    printf("%-16s %8s %9s %8s %9s %8s %9s\n", "image", "bytes", "us/draw",
+           "bytes", "us/draw", "bytes", "us/draw");
+
+    for(i = 0; i < NUM_ELEMENTS(g_images); i++)
+    {
+        if(checkSame(i))
+        {
+            fprintf(stderr, "%s: the forms of the image draw different pixels\n",
+                    g_images[i].name);
+            return 1;
+        }
+
+        image = g_images[i].image;
+
+        printf("%-16s %8u %9.2f %8u %9.2f %8u %9.2f\n", g_images[i].name,
+               ((image->xSize * image->bPP + 7) >> 3) * image->ySize,
+               run(i, FORM_GRLIB),
+               g_images[i].rotated->width * ((g_images[i].rotated->height + 7) >> 3),
+               run(i, FORM_ROTATED),
+               g_images[i].packed->size, run(i, FORM_PACKED));
+    }
+
+    return 0;
+}
@@ -0,0 +1,302 @@
+//*****************************************************************************
+//
+// pack_image.c - Converts PBM images into packed images for the Sharp96x96
+// driver.
+//
+// Each image is run length coded for Sharp96x96_DrawPackedImage(), which
+// decodes it a screen column at a time for ROTATE_90. The image is a stream
+// of 4 bit codes, high nibble first, giving the lengths of the runs of white
+// and black pixels down each column, left to right, starting with white.
+// Codes 0 to 14 are a run followed by a change of color, code 15 is a run of
+// 15 pixels that the next code continues.
+//
+// Both plain (P1) and raw (P4) PBMs are read; other formats can be converted
+// first, for example with pngtopnm image.png | pamditherbw | pamtopnm. The
+// symbols are named after the file, images/TI_Logo_69x64.pbm becoming
+// TI_Logo_69x64_PACKED. The flash used by every image, as a rotated image
+// and packed, is reported on stderr.
+//
+// Build and run it from the root of a lab project that has an images
+// directory:
+//
+//     gcc -o pack_image ../tools/pack_image.c
+//     ./pack_image images/*.pbm > images/images_packed.c
+//
+//*****************************************************************************
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+// As in the driver
+#define PACKED_COLUMN_BYTES 8
+#define MAX_WIDTH           96
+
+//*****************************************************************************
+//
+// The image being converted, one byte per pixel, non-zero when black.
+//
+//*****************************************************************************
+static uint8_t g_pixels[PACKED_COLUMN_BYTES * 8][MAX_WIDTH];
+static int g_width;
+static int g_height;
+
+//*****************************************************************************
+//
+// Reads the next number of a PBM header, skipping white space and comments.
+//
+//*****************************************************************************
+static int readNumber(FILE *file)
+{
+    int ch;
+    int value = 0;
+
+    do
+    {
+        ch = fgetc(file);
+
+        if('#' == ch)
+        {
+            while((ch != '\n') && (ch != EOF))
+            {
+                ch = fgetc(file);
+            }
+        }
+    }
+    while((ch == ' ') || (ch == '\t') || (ch == '\r') || (ch == '\n'));
+
+    if((ch < '0') || (ch > '9'))
+    {
+        return -1;
+    }
+
+    while((ch >= '0') && (ch <= '9'))
+    {
+        value = value * 10 + ch - '0';
+        ch = fgetc(file);
+    }
+
+    return value;
+}
+
+//*****************************************************************************
+//
+// Reads a PBM into g_pixels. Returns non-zero on error.
+//
+//*****************************************************************************
+static int readPbm(const char *path)
+{
+    FILE *file = fopen(path, "rb");
+    int format, row, col, ch, byte = 0;
+
+    if(!file)
+    {
+        perror(path);
+        return 1;
+    }
+
+    format = (fgetc(file) == 'P') ? fgetc(file) : 0;
+    g_width = readNumber(file);
+    g_height = readNumber(file);
+
+    if(((format != '1') && (format != '4')) || (g_width < 1) || (g_height < 1))
+    {
+        fprintf(stderr, "%s: not a PBM\n", path);
+        fclose(file);
+        return 1;
+    }
+
+    if((g_width > MAX_WIDTH) || (g_height > PACKED_COLUMN_BYTES * 8))
+    {
+        fprintf(stderr, "%s: images larger than %dx%d are not supported\n", path,
+                MAX_WIDTH, PACKED_COLUMN_BYTES * 8);
+        fclose(file);
+        return 1;
+    }
+
+    for(row = 0; row < g_height; row++)
+    {
+        for(col = 0; col < g_width; col++)
+        {
+            if('4' == format)
+            {
+                // Rows of raw PBMs are padded to a whole byte
+                if(!(col & 0x7))
+                {
+                    byte = fgetc(file);
+                }
+
+                ch = (byte < 0) ? EOF : ((byte >> (7 - (col & 0x7))) & 0x1) + '0';
+            }
+            else
+            {
+                do
+                {
+                    ch = fgetc(file);
+                }
+                while((ch == ' ') || (ch == '\t') || (ch == '\r') || (ch == '\n'));
+            }
+
+            if((ch != '0') && (ch != '1'))
+            {
+                fprintf(stderr, "%s: truncated or corrupt pixel data\n", path);
+                fclose(file);
+                return 1;
+            }
+
+            g_pixels[row][col] = (ch == '1');
+        }
+    }
+
+    fclose(file);
+    return 0;
+}
+
+//*****************************************************************************
+//
+// Appends a 4 bit code to out, high nibble first.
+//
+//*****************************************************************************
+static void putCode(uint8_t *out, unsigned *codes, uint8_t code)
+{
+    if(*codes & 0x1)
+    {
+        out[*codes >> 1] |= code;
+    }
+    else
+    {
+        out[*codes >> 1] = code << 4;
+    }
+
+    (*codes)++;
+}
+
+//*****************************************************************************
+//
+// Run length codes g_pixels down each column, left to right, starting with
+// white. Returns the number of bytes written to out.
+//
+//*****************************************************************************
+static unsigned encode(uint8_t *out)
+{
+    unsigned codes = 0;
+    unsigned run = 0;
+    int white = 1;
+    int row, col;
+
+    for(col = 0; col < g_width; col++)
+    {
+        for(row = 0; row < g_height; row++)
+        {
+            // PBM pixels are black when set
+            if(white == g_pixels[row][col])
+            {
+                // Runs of 15 pixels or more go out as 15s, then the rest
+                for(; run >= 15; run -= 15)
+                {
+                    putCode(out, &codes, 15);
+                }
+
+                putCode(out, &codes, run);
+                white = !white;
+                run = 0;
+            }
+
+            run++;
+        }
+    }
+
+    for(; run >= 15; run -= 15)
+    {
+        putCode(out, &codes, 15);
+    }
+
+    putCode(out, &codes, run);
+
+    return (codes + 1) >> 1;
+}
+
+//*****************************************************************************
+//
+// Returns the symbol name of an image, its file name without directory and
+// extension.
+//
+//*****************************************************************************
+static const char *imageName(const char *path)
+{
+    static char name[64];
+    const char *base = strrchr(path, '/');
+    char *dot;
+
+    snprintf(name, sizeof(name), "%s", base ? base + 1 : path);
+    dot = strrchr(name, '.');
+
+    if(dot)
+    {
+        *dot = 0;
+    }
+
+    return name;
+}
+
+int main(int argc, char *argv[])
+{
+    // At worst a code per pixel, two codes a byte
+    static uint8_t coded[MAX_WIDTH * PACKED_COLUMN_BYTES * 8 / 2 + 1];
+    const char *name;
+    unsigned rotated, size, j;
+    int i;
+
+    if(argc < 2)
+    {
+        fprintf(stderr, "usage: %s image.pbm...\n", argv[0]);
+        return 1;
+    }
+
+    printf("//*****************************************************************************\n");
+    printf("//\n");
+    printf("// Generated by tools/pack_image.c, do not edit.\n");
+    printf("//\n");
+    printf("//*****************************************************************************\n");
+    printf("\n");
+    printf("#include <stdint.h>\n");
+    printf("#include \"grlib.h\"\n");
+    printf("#include \"LcdDriver/Sharp96x96.h\"\n");
+    printf("\n");
+    printf("#include \"images/images.h\"\n");
+    printf("\n");
+
+    for(i = 1; i < argc; i++)
+    {
+        if(readPbm(argv[i]))
+        {
+            return 1;
+        }
+
+        name = imageName(argv[i]);
+        rotated = g_width * ((g_height + 7) >> 3);
+        size = encode(coded);
+
+        printf("static const uint8_t g_pucPacked%sData[] =\n{", name);
+
+        for(j = 0; j < size; j++)
+        {
+            printf("%s0x%02x,", (j % 12) ? " " : "\n    ", coded[j]);
+        }
+
+        printf("\n};\n\n");
+
+        printf("const Sharp96x96_PackedImage %s_PACKED =\n{\n", name);
+        printf("    %d,\n", g_width);
+        printf("    %d,\n", g_height);
+        printf("    %u,\n", size);
+        printf("    g_pucPacked%sData\n", name);
+        printf("};\n\n");
+
+        fprintf(stderr, "%-16s %2dx%-2d rotated %4u bytes, packed %4u bytes (%u%%)\n",
+                name, g_width, g_height, rotated, size, size * 100 / rotated);
+    }
+
+    return 0;
+}
@@ -0,0 +1,311 @@
+//*****************************************************************************
+//
+// prerender_screens.c - Rasterizes the fixed screens of the labs at build
+// time.
+//
+// Every screen is drawn by the lab's own Sharp96x96 driver, built for the
+// host against tools/sharp_host, exactly as displayCenteredText() and
+// displayCenteredTexts() would draw it. The resulting DisplayBuffer contents
+// are run length coded for Sharp96x96_DrawScreen(): a control byte with bit 7
+// set repeats the next byte (control & 0x7F) + 1 times, otherwise the next
+// control + 1 bytes are copied as is.
+//
+// Build and run it from the root of a lab project:
+//
+//     gcc -I ../tools/sharp_host -I grlib -I . -o prerender_screens
+//         ../tools/prerender_screens.c ../tools/sharp_host/sharp_spy.c
+//         ../tools/sharp_host/msp430_model.c ../tools/sharp_host/grlib_host.c
+//         LcdDriver/Sharp96x96.c LcdDriver/HAL_MSP_EXP430FR5529_Sharp96x96.c
+//         LcdDriver/HAL_MSP_EXP430FR5529_SpiBus.c
+//         fonts/fontfixed6x8.c fonts/fontfixed6x8_rot90.c
+//     ./prerender_screens lab1 source > screens/screens.c
+//     ./prerender_screens lab1 header > screens/screens.h
+//
+// Rerun it whenever the screens, the font or the driver's drawing changes.
+//
+//*****************************************************************************
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "grlib.h"
+#include "LcdDriver/Sharp96x96.h"
+#include "LcdDriver/HAL_MSP_EXP430FR5529_Sharp96x96.h"
+#include "sharp_spy.h"
+
+#ifdef LANDSCAPE_FLIP
+#error "The panel memory is read back as the DisplayBuffer, which needs LANDSCAPE"
+#endif
+
+#define NUM_ELEMENTS(a)     (sizeof(a) / sizeof((a)[0]))
+
+#define LINE_BYTES          (LCD_HORIZONTAL_MAX >> 3)
+#define SCREEN_BYTES        (LCD_VERTICAL_MAX * LINE_BYTES)
+
+//*****************************************************************************
+//
+// The screens of every lab. The strings are centered on x = 48 at y = 15,
+// 30, 45 and 60, as displayCenteredTexts() places them.
+//
+//*****************************************************************************
+typedef struct
+{
+    const char *name;
+    const char *lines[4];
+}
+tScreen;
+
+static const tScreen g_lab1Screens[] =
+{
+    { "Simon", { "SIMON" } },
+    { "Memorize", { "Memorize", "the", "pattern" } },
+    { "Repeat", { "Repeat", "the", "pattern" } },
+    { "YouLose", { "You lose!" } },
+};
+
+static const tScreen g_lab2Screens[] =
+{
+    { "Welcome", { "MSP430", "Hero", "", "Press *" } },
+    { "SelectSong", { "Select a song", "1: Twinkle", "2: Song 2", "3: Song 3" } },
+    { "Lost", { "You lost :(", "Rock on and", "try again!", "Press #" } },
+    { "Won", { "You won!", "Radical!", "", "Press #" } },
+};
+
+static const struct
+{
+    const char *lab;
+    const tScreen *screens;
+    unsigned count;
+}
+g_labs[] =
+{
+    { "lab1", g_lab1Screens, NUM_ELEMENTS(g_lab1Screens) },
+    { "lab2", g_lab2Screens, NUM_ELEMENTS(g_lab2Screens) },
+};
+
+static Graphics_Context g_sContext;
+
+//*****************************************************************************
+//
+// Draws a screen and reads the DisplayBuffer back from the panel memory.
+//
+//*****************************************************************************
+static void rasterize(const tScreen *screen, uint8_t *buffer)
+{
+    unsigned i;
+
+    Graphics_clearDisplay(&g_sContext);
+
+    for(i = 0; i < NUM_ELEMENTS(screen->lines); i++)
+    {
+        if(screen->lines[i] && screen->lines[i][0])
+        {
+#ifdef ROTATE_90
+            Sharp96x96_DrawStringCentered(&g_sContext,
+                                          (const uint8_t *)screen->lines[i],
+                                          AUTO_STRING_LENGTH, 48, 15 * (i + 1),
+                                          TRANSPARENT_TEXT);
+#else
+            Graphics_drawStringCentered(&g_sContext, (uint8_t *)screen->lines[i],
+                                        AUTO_STRING_LENGTH, 48, 15 * (i + 1),
+                                        TRANSPARENT_TEXT);
+#endif
+        }
+    }
+
+    Graphics_flushBuffer(&g_sContext);
+
+    for(i = 0; i < LCD_VERTICAL_MAX; i++)
+    {
+        memcpy(&buffer[i * LINE_BYTES], spyPanelLine(i), LINE_BYTES);
+    }
+}
+
+//*****************************************************************************
+//
+// Run length codes a screen. Returns the number of bytes written to out,
+// which must hold at least SCREEN_BYTES + SCREEN_BYTES / 128 bytes.
+//
+//*****************************************************************************
+static unsigned encode(const uint8_t *in, uint8_t *out)
+{
+    unsigned pos = 0;
+    unsigned size = 0;
+    unsigned literal = 0;
+    unsigned run;
+
+    while(pos < SCREEN_BYTES)
+    {
+        for(run = 1; (pos + run < SCREEN_BYTES) && (run < 128) &&
+                     (in[pos + run] == in[pos]); run++)
+        {
+        }
+
+        if(run >= 2)
+        {
+            literal = 0;
+            out[size++] = 0x80 | (run - 1);
+            out[size++] = in[pos];
+            pos += run;
+        }
+        else
+        {
+            // Extend the current literal block, or start a new one
+            if(!literal || (out[literal] == 0x7F))
+            {
+                literal = size;
+                out[size++] = 0xFF;
+            }
+
+            out[literal]++;
+            out[size++] = in[pos++];
+        }
+    }
+
+    return size;
+}
+
+//*****************************************************************************
+//
+// Decodes a screen the way Sharp96x96_DrawScreen() does, to check encode().
+//
+//*****************************************************************************
+static unsigned decode(const uint8_t *in, unsigned size, uint8_t *out)
+{
+    unsigned pos = 0;
+    unsigned i = 0;
+    unsigned count;
+
+    while((i < size) && (pos < SCREEN_BYTES))
+    {
+        count = (in[i] & 0x7F) + 1;
+
+        if(in[i++] & 0x80)
+        {
+            memset(&out[pos], in[i++], count);
+        }
+        else
+        {
+            memcpy(&out[pos], &in[i], count);
+            i += count;
+        }
+
+        pos += count;
+    }
+
+    return pos;
+}
+
+static void printHeader(void)
+{
+    printf("//*****************************************************************************\n");
+    printf("//\n");
+    printf("// Generated by tools/prerender_screens.c, do not edit.\n");
+    printf("//\n");
+    printf("//*****************************************************************************\n");
+    printf("\n");
+}
+
+static int emitSource(const tScreen *screens, unsigned count)
+{
+    static uint8_t buffer[SCREEN_BYTES];
+    static uint8_t check[SCREEN_BYTES];
+    static uint8_t coded[SCREEN_BYTES + SCREEN_BYTES / 128];
+    unsigned i, j, size;
+
+    printHeader();
+    printf("#include <stdint.h>\n");
+    printf("#include \"grlib.h\"\n");
+    printf("#include \"LcdDriver/Sharp96x96.h\"\n");
+    printf("\n");
+    printf("#include \"screens/screens.h\"\n");
+    printf("\n");
+
+    for(i = 0; i < count; i++)
+    {
+        rasterize(&screens[i], buffer);
+        size = encode(buffer, coded);
+
+        if((decode(coded, size, check) != SCREEN_BYTES) ||
+           memcmp(buffer, check, SCREEN_BYTES))
+        {
+            fprintf(stderr, "%s: run length coding does not round trip\n",
+                    screens[i].name);
+            return 1;
+        }
+
+        printf("static const uint8_t g_pucScreen%sData[] =\n{", screens[i].name);
+
+        for(j = 0; j < size; j++)
+        {
+            printf("%s0x%02x,", (j % 12) ? " " : "\n    ", coded[j]);
+        }
+
+        printf("\n};\n\n");
+
+        printf("const Sharp96x96_Screen g_sScreen%s =\n{\n", screens[i].name);
+        printf("    %u,\n", size);
+        printf("    g_pucScreen%sData\n", screens[i].name);
+        printf("};\n\n");
+    }
+
+    return 0;
+}
+
+static int emitHeader(const tScreen *screens, unsigned count)
+{
+    unsigned i;
+
+    printHeader();
+    printf("#ifndef __SCREENS_H__\n");
+    printf("#define __SCREENS_H__\n");
+    printf("\n");
+    printf("#include \"grlib.h\"\n");
+    printf("#include \"LcdDriver/Sharp96x96.h\"\n");
+    printf("\n");
+
+    for(i = 0; i < count; i++)
+    {
+        printf("extern const Sharp96x96_Screen g_sScreen%s;\n", screens[i].name);
+    }
+
+    printf("\n");
+    printf("#endif // __SCREENS_H__\n");
+
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned i;
+
+    for(i = 0; (argc == 3) && (i < NUM_ELEMENTS(g_labs)); i++)
+    {
+        if(strcmp(argv[1], g_labs[i].lab))
+        {
+            continue;
+        }
+
+        if(!strcmp(argv[2], "header"))
+        {
+            return emitHeader(g_labs[i].screens, g_labs[i].count);
+        }
+
+        if(!strcmp(argv[2], "source"))
+        {
+            // As configDisplay() does
+            Sharp96x96_Init();
+            Graphics_initContext(&g_sContext, &g_sharp96x96LCD);
+            Graphics_setForegroundColor(&g_sContext, ClrBlack);
+            Graphics_setBackgroundColor(&g_sContext, ClrWhite);
+            Graphics_setFont(&g_sContext, &g_sFontFixed6x8);
+
+            return emitSource(g_labs[i].screens, g_labs[i].count);
+        }
+    }
+
+    fprintf(stderr, "usage: %s lab1|lab2 source|header\n", argv[0]);
+    return 1;
+}
@@ -0,0 +1,300 @@
+//*****************************************************************************
+//
+// rotate_assets.c - Emits ROTATE_90 versions of the fonts and images.
+//
+// The Sharp96x96 driver is built with ROTATE_90, where a screen column is a
+// line of the DisplayBuffer. This host tool transposes the fonts and images
+// so that every screen column of a glyph or image is a run of bytes that the
+// driver can merge straight into a DisplayBuffer line, with the top pixel in
+// bit 7 of the first byte.
+//
+// Build and run it from the root of a lab project, for the fonts:
+//
+//     gcc -I grlib -o rotate_assets ../tools/rotate_assets.c fonts/fontfixed6x8.c
+//     ./rotate_assets fonts > fonts/fontfixed6x8_rot90.c
+//
+// and, in projects that have an images directory:
+//
+//     gcc -DWITH_IMAGES -I grlib -o rotate_assets ../tools/rotate_assets.c
+//         fonts/fontfixed6x8.c images/TI_Logo_69x64.c images/LPRocket_96x37.c
+//     ./rotate_assets images > images/images_rot90.c
+//
+// The generated images_packed.c and images_rot90.c are left out, they are not
+// inputs and need the driver headers.
+//
+// Only uncompressed, fixed width fonts and uncompressed images are supported.
+// Image palette entries that are not black become white, as they would
+// through the driver's color translation.
+//
+//*****************************************************************************
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "grlib.h"
+
+#ifdef WITH_IMAGES
+extern const tImage LPRocket_96x37_1BPP_UNCOMP;
+extern const tImage TI_Logo_69x64_1BPP_UNCOMP;
+#endif
+
+//*****************************************************************************
+//
+// The assets to rotate. The name is the suffix of the generated symbols.
+//
+//*****************************************************************************
+static const struct
+{
+    const char *name;
+    const Graphics_Font *font;
+}
+g_fonts[] =
+{
+    { "FontFixed6x8", &g_sFontFixed6x8 },
+};
+
+#ifdef WITH_IMAGES
+static const struct
+{
+    const char *name;
+    const Graphics_Image *image;
+}
+g_images[] =
+{
+    { "LPRocket_96x37", &LPRocket_96x37_1BPP_UNCOMP },
+    { "TI_Logo_69x64", &TI_Logo_69x64_1BPP_UNCOMP },
+};
+#endif
+
+#define NUM_ELEMENTS(a)     (sizeof(a) / sizeof((a)[0]))
+
+//*****************************************************************************
+//
+// A screen column of at most 64 pixels, top pixel first
+//
+//*****************************************************************************
+static uint8_t g_column[8];
+
+static void columnClear(void)
+{
+    memset(g_column, 0, sizeof(g_column));
+}
+
+static void columnSet(int row)
+{
+    g_column[row >> 3] |= 0x80 >> (row & 0x7);
+}
+
+static void columnPrint(int height)
+{
+    int i;
+
+    for(i = 0; i < ((height + 7) >> 3); i++)
+    {
+        printf(" 0x%02x,", g_column[i]);
+    }
+}
+
+static void printHeader(void)
+{
+    printf("//*****************************************************************************\n");
+    printf("//\n");
+    printf("// Generated by tools/rotate_assets.c, do not edit.\n");
+    printf("//\n");
+    printf("//*****************************************************************************\n");
+    printf("\n");
+    printf("#include <stdint.h>\n");
+    printf("#include \"grlib.h\"\n");
+    printf("#include \"LcdDriver/Sharp96x96.h\"\n");
+    printf("\n");
+}
+
+//*****************************************************************************
+//
+// Emits the rotated version of a font. The glyph data of an uncompressed
+// font is a bit stream of width bits per row, most significant bit first,
+// preceded by the glyph size and width bytes.
+//
+//*****************************************************************************
+static int rotateFont(const char *name, const Graphics_Font *font)
+{
+    int ch, row, col, bit;
+    int width = font->maxWidth;
+    int height = font->data[font->offset[0]];
+    const uint8_t *glyph;
+
+    if(font->format != FONT_FMT_UNCOMPRESSED)
+    {
+        fprintf(stderr, "%s: only uncompressed fonts are supported\n", name);
+        return 1;
+    }
+
+    if(height > 64)
+    {
+        fprintf(stderr, "%s: glyphs taller than 64 pixels are not supported\n", name);
+        return 1;
+    }
+
+    printf("static const uint8_t g_pucRotated%sData[] =\n{\n", name);
+
+    for(ch = 0; ch < 96; ch++)
+    {
+        glyph = &font->data[font->offset[ch]];
+
+        if((glyph[0] != height) || (glyph[1] != width))
+        {
+            fprintf(stderr, "%s: glyph %d is not %dx%d, only fixed width fonts are supported\n",
+                    name, ch + ' ', width, height);
+            return 1;
+        }
+
+        printf("    //\n    // '%c'\n    //\n   ", (ch + ' ' == 0x7F) ? ' ' : ch + ' ');
+
+        for(col = 0; col < width; col++)
+        {
+            columnClear();
+
+            for(row = 0; row < height; row++)
+            {
+                bit = row * width + col;
+
+                if(glyph[2 + (bit >> 3)] & (0x80 >> (bit & 0x7)))
+                {
+                    columnSet(row);
+                }
+            }
+
+            columnPrint(height);
+        }
+
+        printf("\n");
+    }
+
+    printf("};\n\n");
+
+    printf("const Sharp96x96_RotatedFont g_sRotated%s =\n{\n", name);
+    printf("    &g_s%s,\n", name);
+    printf("    %d,\n", width);
+    printf("    %d,\n", height);
+    printf("    %d,\n", font->baseline);
+    printf("    g_pucRotated%sData\n", name);
+    printf("};\n\n");
+
+    return 0;
+}
+
+#ifdef WITH_IMAGES
+//*****************************************************************************
+//
+// Emits the rotated version of an image. The pixel data of an uncompressed
+// image is stored row by row, each row padded to a whole byte.
+//
+//*****************************************************************************
+static int rotateImage(const char *name, const Graphics_Image *image)
+{
+    // The images are compiled for the host, where their palettes are arrays of
+    // unsigned long rather than of the uint32_t the structure points to
+    const unsigned long *palette = (const unsigned long *)image->pPalette;
+    int bpp = image->bPP;
+    int stride = (image->xSize * bpp + 7) >> 3;
+    int row, col, bit, index;
+
+    if((bpp != 1) && (bpp != 2) && (bpp != 4) && (bpp != 8))
+    {
+        fprintf(stderr, "%s: only uncompressed images are supported\n", name);
+        return 1;
+    }
+
+    if(image->ySize > 64)
+    {
+        fprintf(stderr, "%s: images taller than 64 pixels are not supported\n", name);
+        return 1;
+    }
+
+    printf("static const uint8_t g_pucRotated%sData[] =\n{\n", name);
+
+    for(col = 0; col < image->xSize; col++)
+    {
+        columnClear();
+
+        for(row = 0; row < image->ySize; row++)
+        {
+            bit = col * bpp;
+            index = (image->pPixel[row * stride + (bit >> 3)] >> (8 - bpp - (bit & 0x7))) &
+                    ((1 << bpp) - 1);
+
+            if(palette[index])
+            {
+                columnSet(row);
+            }
+        }
+
+        printf("   ");
+        columnPrint(image->ySize);
+        printf("\n");
+    }
+
+    printf("};\n\n");
+
+    printf("const Sharp96x96_RotatedImage %s_ROT90 =\n{\n", name);
+    printf("    %d,\n", image->xSize);
+    printf("    %d,\n", image->ySize);
+    printf("    g_pucRotated%sData\n", name);
+    printf("};\n\n");
+
+    return 0;
+}
+#endif
+
+int main(int argc, char *argv[])
+{
+    unsigned i;
+
+    if((argc == 2) && !strcmp(argv[1], "fonts"))
+    {
+        printHeader();
+
+        for(i = 0; i < NUM_ELEMENTS(g_fonts); i++)
+        {
+            if(rotateFont(g_fonts[i].name, g_fonts[i].font))
+            {
+                return 1;
+            }
+        }
+
+        // The table the driver searches for the rotated version of a font
+        printf("const Sharp96x96_RotatedFont *const g_ppsSharp96x96RotatedFonts[] =\n{\n");
+
+        for(i = 0; i < NUM_ELEMENTS(g_fonts); i++)
+        {
+            printf("    &g_sRotated%s,\n", g_fonts[i].name);
+        }
+
+        printf("    0\n};\n");
+
+        return 0;
+    }
+
+#ifdef WITH_IMAGES
+    if((argc == 2) && !strcmp(argv[1], "images"))
+    {
+        printHeader();
+        printf("#include \"images/images.h\"\n\n");
+
+        for(i = 0; i < NUM_ELEMENTS(g_images); i++)
+        {
+            if(rotateImage(g_images[i].name, g_images[i].image))
+            {
+                return 1;
+            }
+        }
+
+        return 0;
+    }
+#endif
+
+    fprintf(stderr, "usage: %s fonts|images\n", argv[0]);
+    return 1;
+}
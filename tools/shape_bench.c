@@ -0,0 +1,226 @@
+//*****************************************************************************
+//
+// shape_bench.c - Measures how fast lines and circles are drawn into the
+// DisplayBuffer.
+//
+// Every shape is drawn with the generic grlib path, Graphics_drawLine(),
+// Graphics_drawCircle() and Graphics_fillCircle(), and with the driver's span
+// rasterizer, Sharp96x96_DrawLine(), Sharp96x96_DrawCircle() and
+// Sharp96x96_FillCircle(). The two are first checked to draw the same pixels,
+// then timed. Nothing is flushed, only the drawing is timed.
+//
+// The times are host times. Only the ratio between the two paths carries over
+// to the MSP430.
+//
+// Build and run it from the root of a lab project:
+//
+//     gcc -O2 -I ../tools/sharp_host -I grlib -I . -o shape_bench
+//         ../tools/shape_bench.c ../tools/sharp_host/sharp_spy.c
+//         ../tools/sharp_host/msp430_model.c ../tools/sharp_host/grlib_host.c
+//         LcdDriver/Sharp96x96.c LcdDriver/HAL_MSP_EXP430FR5529_Sharp96x96.c
+//         LcdDriver/HAL_MSP_EXP430FR5529_SpiBus.c
+//         fonts/fontfixed6x8.c fonts/fontfixed6x8_rot90.c
+//     ./shape_bench
+//
+//*****************************************************************************
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+
+#include "grlib.h"
+#include "LcdDriver/Sharp96x96.h"
+#include "LcdDriver/HAL_MSP_EXP430FR5529_Sharp96x96.h"
+#include "sharp_spy.h"
+
+#define NUM_ELEMENTS(a)     (sizeof(a) / sizeof((a)[0]))
+
+// How long each case runs for
+#define BENCH_SECONDS       0.5
+
+// Lines of the fan, from the bottom left corner to points spread along the
+// top and right edges
+#define FAN_LINES           32
+
+static Graphics_Context g_sContext;
+
+//*****************************************************************************
+//
+// The shapes, each drawn through grlib when bSpans is false and through the
+// span rasterizer when it is true.
+//
+//*****************************************************************************
+static void fillCircle40(bool bSpans)
+{
+    if(bSpans)
+    {
+        Sharp96x96_FillCircle(&g_sContext, 48, 48, 40);
+    }
+    else
+    {
+        Graphics_fillCircle(&g_sContext, 48, 48, 40);
+    }
+}
+
+static void circle40(bool bSpans)
+{
+    if(bSpans)
+    {
+        Sharp96x96_DrawCircle(&g_sContext, 48, 48, 40);
+    }
+    else
+    {
+        Graphics_drawCircle(&g_sContext, 48, 48, 40);
+    }
+}
+
+static void lineFan(bool bSpans)
+{
+    int16_t i;
+    int16_t x;
+    int16_t y;
+
+    for(i = 0; i < FAN_LINES; i++)
+    {
+        // Along the top edge, then down the right edge
+        if(i < FAN_LINES / 2)
+        {
+            x = i * (SHARP_SCREEN_WIDTH * 2 / FAN_LINES);
+            y = 0;
+        }
+        else
+        {
+            x = SHARP_SCREEN_WIDTH - 1;
+            y = (i - FAN_LINES / 2) * (SHARP_SCREEN_HEIGHT * 2 / FAN_LINES);
+        }
+
+        if(bSpans)
+        {
+            Sharp96x96_DrawLine(&g_sContext, 0, SHARP_SCREEN_HEIGHT - 1, x, y);
+        }
+        else
+        {
+            Graphics_drawLine(&g_sContext, 0, SHARP_SCREEN_HEIGHT - 1, x, y);
+        }
+    }
+}
+
+// A circle partly off the screen, to check the clipping of the runs
+static void clippedCircle(bool bSpans)
+{
+    if(bSpans)
+    {
+        Sharp96x96_DrawCircle(&g_sContext, 80, 10, 30);
+        Sharp96x96_FillCircle(&g_sContext, 5, 90, 20);
+    }
+    else
+    {
+        Graphics_drawCircle(&g_sContext, 80, 10, 30);
+        Graphics_fillCircle(&g_sContext, 5, 90, 20);
+    }
+}
+
+static const struct
+{
+    const char *name;
+    void (*pfnDraw)(bool bSpans);
+}
+g_shapes[] =
+{
+    { "fill circle r40", fillCircle40 },
+    { "circle r40", circle40 },
+    { "line fan x32", lineFan },
+    { "clipped circles", clippedCircle },
+};
+
+//*****************************************************************************
+//
+// Returns the average time of a draw in microseconds.
+//
+//*****************************************************************************
+static double run(unsigned i, bool bSpans)
+{
+    clock_t start = clock();
+    clock_t end = start + (clock_t)(BENCH_SECONDS * CLOCKS_PER_SEC);
+    clock_t now;
+    uint32_t draws = 0;
+
+    do
+    {
+        g_shapes[i].pfnDraw(bSpans);
+        draws++;
+        now = clock();
+    }
+    while(now < end);
+
+    return ((double)(now - start) / CLOCKS_PER_SEC) * 1000000 / draws;
+}
+
+//*****************************************************************************
+//
+// Checks that both paths draw the same pixels for shape i, by comparing what
+// they send to the panel. Returns non-zero if they differ.
+//
+//*****************************************************************************
+static int checkSame(unsigned i)
+{
+    static uint8_t first[LCD_VERTICAL_MAX][LCD_HORIZONTAL_MAX >> 3];
+    uint16_t line;
+    int differ = 0;
+
+    Graphics_clearDisplay(&g_sContext);
+    g_shapes[i].pfnDraw(false);
+    Graphics_flushBuffer(&g_sContext);
+
+    for(line = 0; line < LCD_VERTICAL_MAX; line++)
+    {
+        memcpy(first[line], spyPanelLine(line), sizeof(first[line]));
+    }
+
+    Graphics_clearDisplay(&g_sContext);
+    g_shapes[i].pfnDraw(true);
+    Graphics_flushBuffer(&g_sContext);
+
+    for(line = 0; line < LCD_VERTICAL_MAX; line++)
+    {
+        differ |= memcmp(first[line], spyPanelLine(line), sizeof(first[line]));
+    }
+
+    return differ;
+}
+
+int main(void)
+{
+    double grlibUs;
+    double spansUs;
+    unsigned i;
+
+    // As configDisplay() does
+    Sharp96x96_Init();
+    Graphics_initContext(&g_sContext, &g_sharp96x96LCD);
+    Graphics_setForegroundColor(&g_sContext, ClrBlack);
+    Graphics_setBackgroundColor(&g_sContext, ClrWhite);
+
+    printf("%-16s %14s %14s %8s\n", "shape", "grlib us/draw", "spans us/draw",
+           "speedup");
+
+    for(i = 0; i < NUM_ELEMENTS(g_shapes); i++)
+    {
+        if(checkSame(i))
+        {
+            fprintf(stderr, "%s: the two paths draw different pixels\n",
+                    g_shapes[i].name);
+            return 1;
+        }
+
+        grlibUs = run(i, false);
+        spansUs = run(i, true);
+
+        printf("%-16s %14.2f %14.2f %7.1fx\n", g_shapes[i].name, grlibUs,
+               spansUs, grlibUs / spansUs);
+    }
+
+    return 0;
+}
@@ -0,0 +1,499 @@
+//*****************************************************************************
+//
+// sharp_dma_test.c - Checks the byte stream the DMA flush engine of the HAL
+// puts on the SPI bus.
+//
+// The HAL and the bus manager of a lab project are built unchanged against the
+// UCB0 and DMA0 model of sharp_host, so DMA_ISR chains the blocks of a frame
+// exactly as on the part. Every case starts a frame, lets it run with
+// interrupts enabled, and compares every byte clocked out with the stream the
+// LCD expects, along with the chip selects and USCI setup it went out with:
+//
+//     lines            Sharp96x96_DmaSendLines() of a few lines of a ring
+//     block            Sharp96x96_DmaSendBlock() of a wire format frame
+//     lines_pause      a DAC write submitted in the middle of a line frame
+//     block_pause      a DAC write submitted in the middle of a wire frame
+//     lines_pause_two  two DAC writes submitted in the middle of a line frame
+//     block_pause_two  two DAC writes submitted in the middle of a wire frame
+//     lines_busy       a line frame started while DAC writes go out
+//     block_busy       a wire frame started while DAC writes go out
+//
+// A frame paused for the DAC must close after the line in flight, send the
+// DAC bytes with the DAC clock and chip select, then carry on with a new
+// command byte once the bus manager grants it the bus back. A frame started
+// while the bus is busy must wait for the queue the same way. A DAC word
+// rewritten and submitted again while it goes out is sent whole, then again
+// with the new data. Within an LCD transaction every byte must follow the
+// previous one at the SPI clock, with no gap between two DMA blocks, and the
+// decoder reports a chip select released before the LCD's hold time. No ISR may
+// wait for the USCI.
+//
+// Build and run it from the root of a lab project:
+//
+//     gcc -I ../tools/sharp_host -I grlib -I . -o sharp_dma_test
+//         ../tools/sharp_dma_test.c ../tools/sharp_host/sharp_spy.c
+//         ../tools/sharp_host/msp430_model.c ../tools/sharp_host/grlib_host.c
+//         LcdDriver/Sharp96x96.c LcdDriver/HAL_MSP_EXP430FR5529_Sharp96x96.c
+//         LcdDriver/HAL_MSP_EXP430FR5529_SpiBus.c
+//         fonts/fontfixed6x8.c fonts/fontfixed6x8_rot90.c
+//     ./sharp_dma_test
+//
+// The exit status is non-zero if any case failed.
+//
+//*****************************************************************************
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "grlib.h"
+#include "LcdDriver/Sharp96x96.h"
+#include "LcdDriver/HAL_MSP_EXP430FR5529_Sharp96x96.h"
+#include "sharp_spy.h"
+
+#define NUM_ELEMENTS(a)     (sizeof(a) / sizeof((a)[0]))
+
+#define LINE_BYTES          (LCD_HORIZONTAL_MAX >> 3)
+
+// The command byte of the frames, with VCOM set
+#define TEST_COMMAND        (SHARP_LCD_CMD_WRITE_LINE | SHARP_VCOM_TOGGLE_BIT)
+
+// The ring offset of the line frames
+#define TEST_FIRST_LINE     10
+
+// Bytes of a frame sent before the DAC write is submitted, in the middle of
+// the first line
+#define TEST_PAUSE_AFTER    5
+
+// The low byte of the DAC word once rewritten
+#define TEST_REWRITE        0x00
+
+// Longest an ISR may take. One that waits for the USCI takes at least the time
+// of an LCD byte.
+#define TEST_ISR_TICKS      LCD_BYTE_TICKS
+
+// The DAC of the labs, an MCP4921. The model only watches Port 6, so its chip
+// select is on the spare P6.4 here rather than on P8.2.
+#define DAC_PIN_CS          BIT4
+#define DAC_SPI_CLK_TICKS   CLOCK_SPI_DIV(20000000UL)
+
+// A byte of the expected stream, sent to the LCD or to the DAC
+typedef struct
+{
+    uint8_t byte;
+    bool lcd;
+} tExpected;
+
+// How the DAC writes meet the frame
+typedef enum
+{
+    TEST_PLAIN,             // No DAC write
+    TEST_PAUSE,             // One submitted in the middle of the frame
+    TEST_PAUSE_TWO,         // Two submitted in the middle of the frame
+    TEST_BUSY               // One submitted before the frame, and rewritten
+                            // and submitted again as it goes out
+} tMode;
+
+static const uint8_t g_pucLines[] = { 0, 5, LCD_VERTICAL_MAX - 1 };
+
+static uint8_t g_pucBuffer[LCD_VERTICAL_MAX][LINE_BYTES];
+static uint8_t g_pucFrame[2 + NUM_ELEMENTS(g_pucLines) * SHARP_WIRE_LINE_BYTES];
+static uint16_t g_puiLines[SHARP_LINE_BITMAP_WORDS];
+
+static tExpected g_psExpected[SPY_LOG_LENGTH];
+static uint16_t g_uiExpected;
+
+static tSpiBusDevice g_sDacDevice;
+static const uint8_t g_pucDacFirst[2] = { 0x37, 0xFF };
+static uint8_t g_pucDacWord[2];
+static tSpiBusTransaction g_sDacWrite;
+static uint8_t g_pucDacWord2[2] = { 0x3A, 0x5C };
+static tSpiBusTransaction g_sDacWrite2;
+
+static unsigned g_uiFrameDone;
+static unsigned g_uiDacDone;
+
+static void frameDone(void)
+{
+    g_uiFrameDone++;
+}
+
+static void dacDone(void)
+{
+    g_uiDacDone++;
+}
+
+//*****************************************************************************
+//
+// Builds the expected stream.
+//
+//*****************************************************************************
+static void expect(uint8_t byte, bool lcd)
+{
+    g_psExpected[g_uiExpected].byte = byte;
+    g_psExpected[g_uiExpected].lcd = lcd;
+    g_uiExpected++;
+}
+
+// The address, data and trailer of LCD line
+static void expectLine(uint8_t line)
+{
+    uint8_t slot = (line + TEST_FIRST_LINE) % LCD_VERTICAL_MAX;
+    unsigned i;
+
+    expect(reverse(line + 1), true);
+
+    for(i = 0; i < LINE_BYTES; i++)
+    {
+        expect(g_pucBuffer[slot][i], true);
+    }
+
+    expect(SHARP_LCD_TRAILER_BYTE, true);
+}
+
+static void expectDac(const uint8_t *pucWord)
+{
+    expect(pucWord[0], false);
+    expect(pucWord[1], false);
+}
+
+// The whole stream of g_pucLines. Line and wire frames both pause after the
+// first line: the DAC had come in during its data. The frame is closed by a
+// second trailer, and resumes with the command byte and the address of the
+// next line.
+static void expectFrame(tMode mode)
+{
+    unsigned i;
+
+    if(TEST_BUSY == mode)
+    {
+        expectDac(g_pucDacFirst);
+        expectDac(g_pucDacWord);
+    }
+
+    expect(TEST_COMMAND, true);
+
+    for(i = 0; i < NUM_ELEMENTS(g_pucLines); i++)
+    {
+        expectLine(g_pucLines[i]);
+
+        if(((TEST_PAUSE == mode) || (TEST_PAUSE_TWO == mode)) && !i)
+        {
+            expect(SHARP_LCD_TRAILER_BYTE, true);
+            expectDac(g_pucDacWord);
+
+            if(TEST_PAUSE_TWO == mode)
+            {
+                expectDac(g_pucDacWord2);
+            }
+
+            expect(TEST_COMMAND, true);
+        }
+    }
+
+    expect(SHARP_LCD_TRAILER_BYTE, true);
+}
+
+//*****************************************************************************
+//
+// Sets up a case: a fresh bus log and the wire frame of g_pucLines.
+//
+//*****************************************************************************
+static void caseInit(void)
+{
+    unsigned i;
+    uint8_t *pucByte = g_pucFrame;
+
+    spyReset();
+    spyTakeLongestIsr();
+    memcpy(g_pucDacWord, g_pucDacFirst, sizeof(g_pucDacWord));
+    g_uiExpected = 0;
+    g_uiFrameDone = 0;
+    g_uiDacDone = 0;
+
+    memset(g_puiLines, 0, sizeof(g_puiLines));
+
+    *pucByte++ = TEST_COMMAND;
+
+    for(i = 0; i < NUM_ELEMENTS(g_pucLines); i++)
+    {
+        *pucByte++ = reverse(g_pucLines[i] + 1);
+        memcpy(pucByte, g_pucBuffer[(g_pucLines[i] + TEST_FIRST_LINE) % LCD_VERTICAL_MAX],
+               LINE_BYTES);
+        pucByte += LINE_BYTES;
+        *pucByte++ = SHARP_LCD_TRAILER_BYTE;
+    }
+
+    *pucByte = SHARP_LCD_TRAILER_BYTE;
+}
+
+//*****************************************************************************
+//
+// Gets the bus busy before a TEST_BUSY frame is started: a DAC write, which
+// goes out straight away, then the same one rewritten while its first byte is
+// being clocked out.
+//
+//*****************************************************************************
+static void caseBusy(tMode mode)
+{
+    if(TEST_BUSY != mode)
+    {
+        return;
+    }
+
+    if(!SpiBus_Submit(&g_sDacWrite) || spyLogCount())
+    {
+        fprintf(stderr, "  the DAC write was not started\n");
+    }
+
+    g_pucDacWord[1] = TEST_REWRITE;
+
+    if(!SpiBus_Submit(&g_sDacWrite))
+    {
+        fprintf(stderr, "  the DAC write was not queued again\n");
+    }
+}
+
+//*****************************************************************************
+//
+// Lets the frame run, submitting the DAC writes after TEST_PAUSE_AFTER bytes
+// in the pause modes.
+//
+//*****************************************************************************
+static void caseRun(tMode mode)
+{
+    if((TEST_PAUSE == mode) || (TEST_PAUSE_TWO == mode))
+    {
+        while(spyLogCount() < TEST_PAUSE_AFTER)
+        {
+            __no_operation();
+        }
+
+        if(!Sharp96x96_DmaBusy() || !SpiBus_Submit(&g_sDacWrite) ||
+           ((TEST_PAUSE_TWO == mode) && !SpiBus_Submit(&g_sDacWrite2)))
+        {
+            fprintf(stderr, "  the DAC write was not queued\n");
+        }
+    }
+
+    // A frame waiting for the bus is in flight already
+    if(!Sharp96x96_DmaBusy())
+    {
+        fprintf(stderr, "  the frame was not started\n");
+    }
+
+    Sharp96x96_DmaWaitIdle();
+    spyRunToIdle();
+}
+
+//*****************************************************************************
+//
+// Compares the bus log with the expected stream. Returns the number of
+// failures.
+//
+//*****************************************************************************
+static unsigned caseCheck(void)
+{
+    const tSpyByte *psByte;
+    const tSpyByte *psPrevious = 0;
+    tSpyStats stats;
+    unsigned failures = 0;
+    unsigned gaps = 0;
+    uint32_t ulTicks;
+    uint16_t i;
+    bool lcd;
+
+    if(spyLogCount() != g_uiExpected)
+    {
+        fprintf(stderr, "  %u bytes sent, %u expected\n", (unsigned)spyLogCount(),
+                g_uiExpected);
+        failures++;
+    }
+
+    for(i = 0; (i < g_uiExpected) && (i < spyLogCount()); i++)
+    {
+        psByte = spyLog(i);
+        lcd = (psByte->port6 & PIN_CS) != 0;
+
+        if((psByte->byte != g_psExpected[i].byte) || (lcd != g_psExpected[i].lcd))
+        {
+            fprintf(stderr, "  byte %u: 0x%02x to the %s, 0x%02x to the %s expected\n",
+                    i, psByte->byte, lcd ? "LCD" : "DAC", g_psExpected[i].byte,
+                    g_psExpected[i].lcd ? "LCD" : "DAC");
+            failures++;
+            break;
+        }
+
+        // The DAC alone is selected, with its own clock
+        if(!lcd && ((psByte->port6 & DAC_PIN_CS) ||
+                    (psByte->clkDiv != DAC_SPI_CLK_TICKS)))
+        {
+            fprintf(stderr, "  byte %u: DAC byte sent with P6OUT 0x%02x and "
+                    "clock divisor %u\n", i, psByte->port6, psByte->clkDiv);
+            failures++;
+        }
+
+        if(lcd && !(psByte->port6 & DAC_PIN_CS))
+        {
+            fprintf(stderr, "  byte %u: LCD byte sent with the DAC selected\n", i);
+            failures++;
+        }
+
+        // The LCD bytes of a transaction leave no idle clock in between
+        if(lcd && psPrevious && (psPrevious->port6 & PIN_CS) &&
+           (psByte->ticks - psPrevious->ticks != 8 * psByte->clkDiv))
+        {
+            gaps++;
+        }
+
+        psPrevious = psByte;
+    }
+
+    if(gaps)
+    {
+        fprintf(stderr, "  %u gaps between two LCD bytes\n", gaps);
+        failures++;
+    }
+
+    ulTicks = spyTakeLongestIsr();
+
+    if(ulTicks >= TEST_ISR_TICKS)
+    {
+        fprintf(stderr, "  an ISR took %lu ticks\n", (unsigned long)ulTicks);
+        failures++;
+    }
+
+    spyTakeStats(&stats);
+
+    if(stats.errors)
+    {
+        fprintf(stderr, "  %u protocol errors\n", stats.errors);
+        failures++;
+    }
+
+    if(Sharp96x96_DmaBusy() || (g_uiFrameDone != 1))
+    {
+        fprintf(stderr, "  frame not closed: busy %d, done %u times\n",
+                Sharp96x96_DmaBusy(), g_uiFrameDone);
+        failures++;
+    }
+
+    for(i = 0; i < SHARP_LINE_BITMAP_WORDS; i++)
+    {
+        if(g_puiLines[i])
+        {
+            fprintf(stderr, "  lines left in the bitmap\n");
+            failures++;
+            break;
+        }
+    }
+
+    return failures;
+}
+
+//*****************************************************************************
+//
+// The cases.
+//
+//*****************************************************************************
+static void caseLines(tMode mode)
+{
+    unsigned i;
+
+    for(i = 0; i < NUM_ELEMENTS(g_pucLines); i++)
+    {
+        g_puiLines[g_pucLines[i] >> 4] |= 1u << (g_pucLines[i] & 0xF);
+    }
+
+    caseBusy(mode);
+    Sharp96x96_DmaSendLines(TEST_COMMAND, &g_pucBuffer[0][0], TEST_FIRST_LINE,
+                            g_puiLines, frameDone);
+    caseRun(mode);
+
+    expectFrame(mode);
+}
+
+// The block goes out a line at a time, so it pauses as a line frame does
+static void caseBlock(tMode mode)
+{
+    caseBusy(mode);
+    Sharp96x96_DmaSendBlock(g_pucFrame, sizeof(g_pucFrame), frameDone);
+    caseRun(mode);
+
+    expectFrame(mode);
+}
+
+static const struct
+{
+    const char *name;
+    void (*run)(tMode mode);
+    tMode mode;
+    unsigned dacWrites;
+} g_cases[] =
+{
+    { "lines", caseLines, TEST_PLAIN, 0 },
+    { "block", caseBlock, TEST_PLAIN, 0 },
+    { "lines_pause", caseLines, TEST_PAUSE, 1 },
+    { "block_pause", caseBlock, TEST_PAUSE, 1 },
+    { "lines_pause_two", caseLines, TEST_PAUSE_TWO, 2 },
+    { "block_pause_two", caseBlock, TEST_PAUSE_TWO, 2 },
+    { "lines_busy", caseLines, TEST_BUSY, 2 },
+    { "block_busy", caseBlock, TEST_BUSY, 2 },
+};
+
+int main(void)
+{
+    unsigned failed = 0;
+    unsigned failures;
+    unsigned i, j;
+
+    // Every byte of the ring tells its line and column apart
+    for(i = 0; i < LCD_VERTICAL_MAX; i++)
+    {
+        for(j = 0; j < LINE_BYTES; j++)
+        {
+            g_pucBuffer[i][j] = (uint8_t)(i * LINE_BYTES + j);
+        }
+    }
+
+    g_sDacDevice.pucCsOut = &P6OUT;
+    g_sDacDevice.ucCsPin = DAC_PIN_CS;
+    g_sDacDevice.bCsActiveHigh = false;
+    g_sDacDevice.ucCtl0 = UCCKPH | UCMSB;
+    g_sDacDevice.uiClkDiv = DAC_SPI_CLK_TICKS;
+
+    g_sDacWrite.psDevice = &g_sDacDevice;
+    g_sDacWrite.pucData = g_pucDacWord;
+    g_sDacWrite.ucSize = sizeof(g_pucDacWord);
+    g_sDacWrite.pfnDone = dacDone;
+
+    g_sDacWrite2 = g_sDacWrite;
+    g_sDacWrite2.pucData = g_pucDacWord2;
+
+    Sharp96x96_Init();
+    P6OUT |= DAC_PIN_CS;
+    __enable_interrupt();
+
+    for(i = 0; i < NUM_ELEMENTS(g_cases); i++)
+    {
+        caseInit();
+        g_cases[i].run(g_cases[i].mode);
+
+        failures = caseCheck();
+
+        if(g_uiDacDone != g_cases[i].dacWrites)
+        {
+            fprintf(stderr, "  DAC write done %u times\n", g_uiDacDone);
+            failures++;
+        }
+
+        printf("%-16s %s\n", g_cases[i].name, failures ? "FAIL" : "ok");
+        failed += (failures != 0);
+    }
+
+    printf("%u of %u cases passed\n", (unsigned)NUM_ELEMENTS(g_cases) - failed,
+           (unsigned)NUM_ELEMENTS(g_cases));
+
+    return failed ? 1 : 0;
+}
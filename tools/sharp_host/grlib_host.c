@@ -0,0 +1,460 @@
+//*****************************************************************************
+//
+// grlib_host.c - The part of grlib the labs use, for host builds.
+//
+// grlib only ships as a prebuilt MSP430 library, so the host build of the
+// driver links against this instead. Primitives are clipped to the context
+// clip region and handed to the display driver, as grlib does. Text and
+// images support uncompressed formats only, which is all the labs use.
+//
+//*****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "grlib.h"
+
+//*****************************************************************************
+//
+// Returns the glyph of a character, characters without one become a period.
+//
+//*****************************************************************************
+static const uint8_t *glyphGet(const Graphics_Font *font, uint8_t ch)
+{
+    if((ch < ' ') || (ch > 0x7F))
+    {
+        ch = '.';
+    }
+
+    return &font->data[font->offset[ch - ' ']];
+}
+
+void Graphics_initContext(Graphics_Context *context,
+                          const Graphics_Display *display)
+{
+    context->size = sizeof(Graphics_Context);
+    context->display = display;
+    context->clipRegion.xMin = 0;
+    context->clipRegion.yMin = 0;
+    context->clipRegion.xMax = display->width - 1;
+    context->clipRegion.yMax = display->heigth - 1;
+    context->foreground = 0;
+    context->background = 0;
+    context->font = 0;
+}
+
+void Graphics_setForegroundColor(Graphics_Context *context, int32_t value)
+{
+    context->foreground = context->display->callColorTranslate(
+        context->display->displayData, value);
+}
+
+void Graphics_setBackgroundColor(Graphics_Context *context, int32_t value)
+{
+    context->background = context->display->callColorTranslate(
+        context->display->displayData, value);
+}
+
+void Graphics_setForegroundColorTranslated(Graphics_Context *context,
+                                           int32_t value)
+{
+    context->foreground = value;
+}
+
+void Graphics_setFont(Graphics_Context *context, const Graphics_Font *font)
+{
+    context->font = font;
+}
+
+uint8_t Graphics_getFontHeight(const Graphics_Font *font)
+{
+    return font->height;
+}
+
+void Graphics_clearDisplay(const Graphics_Context *context)
+{
+    context->display->callClearDisplay(context->display->displayData,
+                                       context->background);
+}
+
+void Graphics_flushBuffer(const Graphics_Context *context)
+{
+    context->display->callFlush(context->display->displayData);
+}
+
+void Graphics_fillRectangleOnDisplay(const Graphics_Display *display,
+                                     const Graphics_Rectangle *rect,
+                                     uint16_t value)
+{
+    display->callRectFill(display->displayData, rect, value);
+}
+
+void Graphics_fillRectangle(const Graphics_Context *context,
+                            const Graphics_Rectangle *rect)
+{
+    const Graphics_Rectangle *clip = &context->clipRegion;
+    Graphics_Rectangle temp = *rect;
+
+    if(temp.xMin < clip->xMin) temp.xMin = clip->xMin;
+    if(temp.yMin < clip->yMin) temp.yMin = clip->yMin;
+    if(temp.xMax > clip->xMax) temp.xMax = clip->xMax;
+    if(temp.yMax > clip->yMax) temp.yMax = clip->yMax;
+
+    if((temp.xMin <= temp.xMax) && (temp.yMin <= temp.yMax))
+    {
+        Graphics_fillRectangleOnDisplay(context->display, &temp,
+                                        context->foreground);
+    }
+}
+
+void Graphics_drawPixel(const Graphics_Context *context, uint16_t x,
+                        uint16_t y)
+{
+    const Graphics_Rectangle *clip = &context->clipRegion;
+
+    if((x >= clip->xMin) && (x <= clip->xMax) &&
+       (y >= clip->yMin) && (y <= clip->yMax))
+    {
+        context->display->callPixelDraw(context->display->displayData, x, y,
+                                        context->foreground);
+    }
+}
+
+void Graphics_drawLineH(const Graphics_Context *context, int32_t x1,
+                        int32_t x2, int32_t y)
+{
+    const Graphics_Rectangle *clip = &context->clipRegion;
+    int32_t temp;
+
+    if(x1 > x2)
+    {
+        temp = x1;
+        x1 = x2;
+        x2 = temp;
+    }
+
+    if((y < clip->yMin) || (y > clip->yMax) ||
+       (x2 < clip->xMin) || (x1 > clip->xMax))
+    {
+        return;
+    }
+
+    if(x1 < clip->xMin) x1 = clip->xMin;
+    if(x2 > clip->xMax) x2 = clip->xMax;
+
+    context->display->callLineDrawH(context->display->displayData, x1, x2, y,
+                                    context->foreground);
+}
+
+void Graphics_drawLineV(const Graphics_Context *context, int32_t x,
+                        int32_t y1, int32_t y2)
+{
+    const Graphics_Rectangle *clip = &context->clipRegion;
+    int32_t temp;
+
+    if(y1 > y2)
+    {
+        temp = y1;
+        y1 = y2;
+        y2 = temp;
+    }
+
+    if((x < clip->xMin) || (x > clip->xMax) ||
+       (y2 < clip->yMin) || (y1 > clip->yMax))
+    {
+        return;
+    }
+
+    if(y1 < clip->yMin) y1 = clip->yMin;
+    if(y2 > clip->yMax) y2 = clip->yMax;
+
+    context->display->callLineDrawV(context->display->displayData, x, y1, y2,
+                                    context->foreground);
+}
+
+//*****************************************************************************
+//
+// Lines are stepped with Bresenham's algorithm a pixel at a time through
+// callPixelDraw, as grlib does.
+//
+//*****************************************************************************
+void Graphics_drawLine(const Graphics_Context *context, int32_t x1, int32_t y1,
+                       int32_t x2, int32_t y2)
+{
+    int32_t temp;
+    int32_t deltaX;
+    int32_t deltaY;
+    int32_t error;
+    int32_t yStep;
+    bool steep;
+
+    steep = labs(y2 - y1) > labs(x2 - x1);
+
+    if(steep)
+    {
+        temp = x1;
+        x1 = y1;
+        y1 = temp;
+        temp = x2;
+        x2 = y2;
+        y2 = temp;
+    }
+
+    if(x1 > x2)
+    {
+        temp = x1;
+        x1 = x2;
+        x2 = temp;
+        temp = y1;
+        y1 = y2;
+        y2 = temp;
+    }
+
+    deltaX = x2 - x1;
+    deltaY = labs(y2 - y1);
+    error = -deltaX / 2;
+    yStep = (y1 < y2) ? 1 : -1;
+
+    for(; x1 <= x2; x1++)
+    {
+        if(steep)
+        {
+            Graphics_drawPixel(context, y1, x1);
+        }
+        else
+        {
+            Graphics_drawPixel(context, x1, y1);
+        }
+
+        error += deltaY;
+
+        if(error > 0)
+        {
+            y1 += yStep;
+            error -= deltaX;
+        }
+    }
+}
+
+void Graphics_drawRectangle(const Graphics_Context *context,
+                            const Graphics_Rectangle *rect)
+{
+    Graphics_drawLineH(context, rect->xMin, rect->xMax, rect->yMin);
+    Graphics_drawLineH(context, rect->xMin, rect->xMax, rect->yMax);
+    Graphics_drawLineV(context, rect->xMin, rect->yMin, rect->yMax);
+    Graphics_drawLineV(context, rect->xMax, rect->yMin, rect->yMax);
+}
+
+//*****************************************************************************
+//
+// Circles are traced with Bresenham's midpoint algorithm, as grlib does, an
+// octant at a time.
+//
+//*****************************************************************************
+void Graphics_drawCircle(const Graphics_Context *context, int32_t x,
+                         int32_t y, int32_t lRadius)
+{
+    int32_t a = 0;
+    int32_t b = lRadius;
+    int32_t d = 3 - (lRadius << 1);
+
+    while(a <= b)
+    {
+        Graphics_drawPixel(context, x + a, y + b);
+        Graphics_drawPixel(context, x - a, y + b);
+        Graphics_drawPixel(context, x + a, y - b);
+        Graphics_drawPixel(context, x - a, y - b);
+        Graphics_drawPixel(context, x + b, y + a);
+        Graphics_drawPixel(context, x - b, y + a);
+        Graphics_drawPixel(context, x + b, y - a);
+        Graphics_drawPixel(context, x - b, y - a);
+
+        if(d < 0)
+        {
+            d += (a << 2) + 6;
+        }
+        else
+        {
+            d += 4 * (a - b) + 10;
+            b--;
+        }
+
+        a++;
+    }
+}
+
+void Graphics_fillCircle(const Graphics_Context *context, int32_t x,
+                         int32_t y, int32_t lRadius)
+{
+    int32_t a = 0;
+    int32_t b = lRadius;
+    int32_t d = 3 - (lRadius << 1);
+
+    while(a <= b)
+    {
+        Graphics_drawLineH(context, x - b, x + b, y + a);
+
+        if(a)
+        {
+            Graphics_drawLineH(context, x - b, x + b, y - a);
+        }
+
+        // The rows at +-b are filled once, before b moves in
+        if((a != b) && (d >= 0))
+        {
+            Graphics_drawLineH(context, x - a, x + a, y + b);
+            Graphics_drawLineH(context, x - a, x + a, y - b);
+        }
+
+        if(d < 0)
+        {
+            d += (a << 2) + 6;
+        }
+        else
+        {
+            d += 4 * (a - b) + 10;
+            b--;
+        }
+
+        a++;
+    }
+}
+
+int32_t Graphics_getStringWidth(const Graphics_Context *context,
+                                const int8_t *string, int32_t lLength)
+{
+    int32_t width = 0;
+
+    while(lLength-- && *string)
+    {
+        width += glyphGet(context->font, (uint8_t)*string++)[1];
+    }
+
+    return width;
+}
+
+//*****************************************************************************
+//
+// Draws a string pixel by pixel. The glyph data of an uncompressed font is a
+// bit stream of width bits per row, most significant bit first, preceded by
+// the glyph size in bytes, these two included, and the width.
+//
+//*****************************************************************************
+void Graphics_drawString(const Graphics_Context *context, uint8_t *string,
+                         int32_t lLength, int32_t x, int32_t y, bool opaque)
+{
+    const Graphics_Rectangle *clip = &context->clipRegion;
+    const Graphics_Display *display = context->display;
+    const uint8_t *glyph;
+    int32_t row, col, bit;
+    int32_t px, py;
+    bool set;
+
+    while(lLength-- && *string)
+    {
+        glyph = glyphGet(context->font, *string++);
+
+        for(row = 0; row < context->font->height; row++)
+        {
+            for(col = 0; col < glyph[1]; col++)
+            {
+                px = x + col;
+                py = y + row;
+
+                if((px < clip->xMin) || (px > clip->xMax) ||
+                   (py < clip->yMin) || (py > clip->yMax))
+                {
+                    continue;
+                }
+
+                bit = row * glyph[1] + col;
+                set = ((2 + (bit >> 3)) < glyph[0]) &&
+                      (glyph[2 + (bit >> 3)] & (0x80 >> (bit & 0x7)));
+
+                if(set)
+                {
+                    display->callPixelDraw(display->displayData, px, py,
+                                           context->foreground);
+                }
+                else if(opaque)
+                {
+                    display->callPixelDraw(display->displayData, px, py,
+                                           context->background);
+                }
+            }
+        }
+
+        x += glyph[1];
+    }
+}
+
+void Graphics_drawStringCentered(const Graphics_Context *context,
+                                 uint8_t *string, int32_t length, int32_t x,
+                                 int32_t y, bool opaque)
+{
+    Graphics_drawString(context, string, length,
+                        x - (Graphics_getStringWidth(context, (int8_t *)string,
+                                                     length) / 2),
+                        y - (context->font->baseline / 2), opaque);
+}
+
+//*****************************************************************************
+//
+// Draws an uncompressed image a row at a time through the driver's
+// callPixelDrawMultiple, as grlib does. Host builds compile the palettes of
+// the images as arrays of unsigned long, so they are narrowed to the uint32_t
+// the driver expects first.
+//
+//*****************************************************************************
+void Graphics_drawImage(const Graphics_Context *context,
+                        const Graphics_Image *pBitmap, int16_t x, int16_t y)
+{
+    const Graphics_Rectangle *clip = &context->clipRegion;
+    const unsigned long *hostPalette = (const unsigned long *)pBitmap->pPalette;
+    uint32_t palette[256];
+    int16_t bpp = pBitmap->bPP;
+    int16_t stride = (pBitmap->xSize * bpp + 7) >> 3;
+    int16_t x0 = 0;
+    int16_t count = pBitmap->xSize;
+    int16_t row;
+    uint16_t i;
+
+    if((bpp != 1) && (bpp != 2) && (bpp != 4) && (bpp != 8))
+    {
+        return;
+    }
+
+    for(i = 0; (i < pBitmap->numColors) && (i < 256); i++)
+    {
+        palette[i] = (uint32_t)hostPalette[i];
+    }
+
+    if(x < clip->xMin)
+    {
+        x0 = clip->xMin - x;
+    }
+
+    if(x + count - 1 > clip->xMax)
+    {
+        count = clip->xMax - x + 1;
+    }
+
+    count -= x0;
+
+    for(row = 0; (row < pBitmap->ySize) && (count > 0); row++)
+    {
+        if((y + row < clip->yMin) || (y + row > clip->yMax))
+        {
+            continue;
+        }
+
+        // The data is already past the clipped pixels. Only the formats that
+        // pack several pixels in a byte need lX0, so at 8 bpp the clipped
+        // count is passed rather than 0 and a driver that applies it shows.
+        context->display->callPixelDrawMultiple(
+            context->display->displayData, x + x0, y + row,
+            (8 == bpp) ? x0 : ((x0 * bpp) & 0x7) / bpp, count, bpp,
+            &pBitmap->pPixel[row * stride + ((x0 * bpp) >> 3)], palette);
+    }
+}
@@ -0,0 +1,162 @@
+//*****************************************************************************
+//
+// msp430.h - Host stand-in for the MSP430F5529 device header.
+//
+// Only the registers and intrinsics that the LcdDriver sources reach are
+// provided, with the bit values of the real header. The peripherals behind
+// them are modeled by msp430_model.c, in SMCLK ticks:
+//
+//     UCB0     a TX buffer, a shift register that takes 8 bit clocks a byte,
+//              the UCTXIFG, UCRXIFG and UCBUSY flags and their interrupt.
+//              Every byte shifted out goes to the Sharp protocol decoder of
+//              sharp_spy.c.
+//     DMA0     single transfers to UCB0TXBUF on the rising edges of UCTXIFG,
+//              DMAIFG, DMAIV and the DMA interrupt.
+//     TA0      continuous mode from SMCLK, the CCR0 compare and its interrupt.
+//     Port 6   watched, so that the decoder sees the LCD chip select.
+//
+// Registers with side effects are accessor calls. An access takes a few ticks
+// of model time, which is how a polling loop sees the USCI progress. Time also
+// passes in __delay_cycles() and while the CPU sleeps. The ISRs of the driver
+// are called when GIE is set, at those same points, as on the part between
+// two instructions.
+//
+//*****************************************************************************
+
+#ifndef __SHARP_HOST_MSP430_H__
+#define __SHARP_HOST_MSP430_H__
+
+#include <stdint.h>
+
+#define BIT0                (0x0001)
+#define BIT1                (0x0002)
+#define BIT2                (0x0004)
+#define BIT3                (0x0008)
+#define BIT4                (0x0010)
+#define BIT5                (0x0020)
+#define BIT6                (0x0040)
+#define BIT7                (0x0080)
+
+// Status register
+#define GIE                 (0x0008)
+#define CPUOFF              (0x0010)
+#define OSCOFF              (0x0020)
+#define SCG0                (0x0040)
+#define SCG1                (0x0080)
+#define LPM0_bits           (CPUOFF)
+#define LPM3_bits           (SCG1 | SCG0 | CPUOFF)
+
+// UCB0CTL0
+#define UCCKPH              (0x80)
+#define UCCKPL              (0x40)
+#define UCMSB               (0x20)
+#define UC7BIT              (0x10)
+#define UCMST               (0x08)
+#define UCMODE_0            (0x00)
+#define UCSYNC              (0x01)
+
+// UCB0CTL1
+#define UCSSEL_3            (0xC0)
+#define UCSSEL__SMCLK       (0x80)
+#define UCSWRST             (0x01)
+
+// UCB0IFG, UCB0IE, UCB0STAT and UCB0IV
+#define UCTXIFG             (0x02)
+#define UCRXIFG             (0x01)
+#define UCTXIE              (0x02)
+#define UCRXIE              (0x01)
+#define UCBUSY              (0x01)
+#define USCI_UCRXIFG        (0x0002)
+#define USCI_UCTXIFG        (0x0004)
+
+// DMACTL0 and DMA0CTL
+#define DMA0TSEL_19         (0x0013)
+#define DMADT_0             (0x0000)
+#define DMASRCINCR_3        (0x0300)
+#define DMADSTINCR_0        (0x0000)
+#define DMASBDB             (0x00C0)
+#define DMAEN               (0x0010)
+#define DMAIFG              (0x0008)
+#define DMAIE               (0x0004)
+#define DMAIV_DMA0IFG       (0x0002)
+
+// TA0CTL and TA0CCTL0
+#define TASSEL__ACLK        (0x0100)
+#define TASSEL__SMCLK       (0x0200)
+#define TASSEL_3            (0x0300)
+#define ID__1               (0x0000)
+#define MC__STOP            (0x0000)
+#define MC__CONTINUOUS      (0x0020)
+#define MC_3                (0x0030)
+#define TACLR               (0x0004)
+#define TAIFG               (0x0001)
+#define CCIE                (0x0010)
+#define CCIFG               (0x0001)
+
+extern volatile uint8_t P1SEL;
+extern volatile uint8_t P1DIR;
+extern volatile uint8_t P1OUT;
+extern volatile uint8_t P3SEL;
+extern volatile uint8_t P3DIR;
+extern volatile uint8_t P6SEL;
+extern volatile uint8_t P6DIR;
+extern volatile uint8_t UCB0CTL0;
+extern volatile uint8_t UCB0CTL1;
+extern volatile uint8_t UCB0BR0;
+extern volatile uint8_t UCB0BR1;
+extern volatile uint8_t UCB0IE;
+extern volatile uint16_t DMACTL0;
+extern volatile uint16_t DMA0SZ;
+extern volatile uintptr_t DMA0SA;
+extern volatile uintptr_t DMA0DA;
+extern volatile uint16_t TA0CCR0;
+
+extern volatile uint8_t *spyPort6(void);
+extern volatile uint8_t *spySpiIfg(void);
+extern uint8_t spySpiStat(void);
+extern volatile uint16_t *spySpiTxBuf(void);
+extern uint8_t spySpiRxBuf(void);
+extern uint16_t spySpiIv(void);
+extern volatile uint16_t *spyDma0Ctl(void);
+extern uint16_t spyDmaIv(void);
+extern volatile uint16_t *spyTa0Ctl(void);
+extern uint16_t spyTa0R(void);
+extern volatile uint16_t *spyTa0Cctl0(void);
+extern void spyWriteAddr(const char *pcRegister, uintptr_t ulValue);
+
+#define P6OUT               (*spyPort6())
+#define UCB0IFG             (*spySpiIfg())
+#define UCB0STAT            spySpiStat()
+#define UCB0TXBUF           (*spySpiTxBuf())
+#define UCB0RXBUF           spySpiRxBuf()
+#define UCB0IV              spySpiIv()
+#define DMA0CTL             (*spyDma0Ctl())
+#define DMAIV               spyDmaIv()
+#define TA0CTL              (*spyTa0Ctl())
+#define TA0R                spyTa0R()
+#define TA0CCTL0            (*spyTa0Cctl0())
+
+// The register is told apart by its name, its address does not fit 16 bits
+#define __data16_write_addr(addr, val)  spyWriteAddr(#addr, (uintptr_t)(val))
+
+extern void spyNop(void);
+extern void spyDelayCycles(uint32_t ulCycles);
+extern void spyEnableInterrupt(void);
+extern void spyDisableInterrupt(void);
+extern unsigned short spyGetInterruptState(void);
+extern void spySetInterruptState(unsigned short uiState);
+extern void spyBisSr(unsigned short uiBits);
+extern void spyBicSrOnExit(unsigned short uiBits);
+
+#define __interrupt
+#define __even_in_range(x, y)           (x)
+#define __no_operation()                spyNop()
+#define __delay_cycles(n)               spyDelayCycles((uint32_t)(n))
+#define __enable_interrupt()            spyEnableInterrupt()
+#define __disable_interrupt()           spyDisableInterrupt()
+#define __get_interrupt_state()         spyGetInterruptState()
+#define __set_interrupt_state(s)        spySetInterruptState(s)
+#define __bis_SR_register(x)            spyBisSr(x)
+#define __bic_SR_register_on_exit(x)    spyBicSrOnExit(x)
+
+#endif // __SHARP_HOST_MSP430_H__
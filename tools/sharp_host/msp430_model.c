@@ -0,0 +1,808 @@
+//*****************************************************************************
+//
+// msp430_model.c - Host model of the MSP430F5529 peripherals the LcdDriver
+// sources use, behind the registers of the host msp430.h.
+//
+// Time is counted in SMCLK ticks and only passes when the code under test
+// reaches the model: a register access, an intrinsic, __delay_cycles() or a
+// sleep. UCB0 shifts a byte out in 8 bit clocks of UCB0BR0/UCB0BR1 ticks,
+// frees UCB0TXBUF as soon as the shift register takes its byte and hands
+// every byte to the decoder of sharp_spy.c when it has been clocked out, when
+// it also sets UCRXIFG.
+// DMA0 moves one byte from DMA0SA to UCB0TXBUF on every rising edge of
+// UCTXIFG, whether the USCI or the software made it. TA0 counts SMCLK ticks in
+// continuous mode and sets CCIFG when TA0R reaches TA0CCR0.
+//
+// The ISRs of the code under test are called when GIE is set and a flag and
+// its enable are set, in the priority order of the part. They are declared
+// weak, so a build without them just never takes the interrupt.
+//
+// Mistakes that would hang or corrupt a transfer on the part are reported
+// through spyModelError(): a byte written to a full UCB0TXBUF, DMA0 armed with
+// no edge left to trigger it, and the CPU put to sleep with nothing left to
+// wake it.
+//
+//*****************************************************************************
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "grlib.h"
+#include "LcdDriver/Sharp96x96.h"
+#include "LcdDriver/HAL_MSP_EXP430FR5529_Sharp96x96.h"
+#include "sharp_spy.h"
+
+// Ticks taken by a register access or an intrinsic, and by interrupt entry
+#define MODEL_ACCESS_TICKS  4
+#define MODEL_INTRINSIC_TICKS 1
+#define MODEL_ISR_TICKS     6
+
+// Nothing written to the UCB0TXBUF port since the model last looked
+#define MODEL_TXBUF_EMPTY   0xFFFF
+
+// No event ahead
+#define MODEL_NEVER         UINT64_MAX
+
+//*****************************************************************************
+//
+// The ISRs of the code under test.
+//
+//*****************************************************************************
+extern void USCI_B0_ISR(void) __attribute__((weak));
+extern void TIMER0_A0_ISR(void) __attribute__((weak));
+extern void DMA_ISR(void) __attribute__((weak));
+
+//*****************************************************************************
+//
+// Registers without side effects.
+//
+//*****************************************************************************
+volatile uint8_t P1SEL;
+volatile uint8_t P1DIR;
+volatile uint8_t P1OUT;
+volatile uint8_t P3SEL;
+volatile uint8_t P3DIR;
+volatile uint8_t P6SEL;
+volatile uint8_t P6DIR;
+volatile uint8_t UCB0CTL0;
+volatile uint8_t UCB0CTL1 = UCSWRST;
+volatile uint8_t UCB0BR0;
+volatile uint8_t UCB0BR1;
+volatile uint8_t UCB0IE;
+volatile uint16_t DMACTL0;
+volatile uint16_t DMA0SZ;
+volatile uintptr_t DMA0SA;
+volatile uintptr_t DMA0DA;
+volatile uint16_t TA0CCR0;
+
+//*****************************************************************************
+//
+// Model state. The *Seen copies hold what the registers the code writes
+// directly held the last time the model looked, so that the edges it made
+// are noticed.
+//
+//*****************************************************************************
+static uint64_t g_ullNow;
+
+static volatile uint8_t g_ucPort6;
+static bool g_bLcdSelected;
+
+static volatile uint8_t g_ucSpiIfg = UCTXIFG;
+static uint8_t g_ucSpiIfgSeen = UCTXIFG;
+static volatile uint16_t g_uiSpiTxPort = MODEL_TXBUF_EMPTY;
+static bool g_bTxFull;
+static uint8_t g_ucTxByte;
+static bool g_bShifting;
+static uint8_t g_ucShiftByte;
+static uint8_t g_ucShiftCtl0;
+static uint16_t g_uiShiftClkDiv;
+static uint64_t g_ullShiftEnd;
+static uint8_t g_ucRxBuf;
+
+static volatile uint16_t g_uiDma0Ctl;
+static uint16_t g_uiDma0CtlSeen;
+static uintptr_t g_ulDmaSrc;
+static uint16_t g_uiDmaLeft;
+static uint16_t g_uiDmaSize;
+
+static volatile uint16_t g_uiTa0Ctl;
+static volatile uint16_t g_uiTa0Cctl0;
+static bool g_bTa0Running;
+static uint64_t g_ullTa0Zero;
+static uint16_t g_uiTa0Held;
+
+static bool g_bGie;
+static bool g_bInIsr;
+static bool g_bWake;
+static uint32_t g_ulLongestIsr;
+
+//*****************************************************************************
+//
+// The SPI clock divisor, a UCB0BR of 0 runs the clock at SMCLK.
+//
+//*****************************************************************************
+static uint16_t modelClkDiv(void)
+{
+    uint16_t uiDiv = UCB0BR0 | ((uint16_t)UCB0BR1 << 8);
+
+    return uiDiv ? uiDiv : 1;
+}
+
+//*****************************************************************************
+//
+// DMA0 on a rising edge of UCTXIFG.
+//
+//*****************************************************************************
+static void modelTxLoad(uint8_t ucByte);
+
+static void modelDmaTrigger(void)
+{
+    uint8_t ucByte;
+
+    if(!(g_uiDma0Ctl & DMAEN) || ((DMACTL0 & 0x1F) != DMA0TSEL_19))
+    {
+        return;
+    }
+
+    if(DMA0DA != (uintptr_t)&g_uiSpiTxPort)
+    {
+        spyModelError("DMA0 destination is not UCB0TXBUF");
+        return;
+    }
+
+    ucByte = *(const uint8_t *)g_ulDmaSrc;
+
+    if((g_uiDma0Ctl & DMASRCINCR_3) == DMASRCINCR_3)
+    {
+        g_ulDmaSrc++;
+    }
+
+    g_uiDmaLeft--;
+    DMA0SZ = g_uiDmaLeft;
+
+    if(!g_uiDmaLeft)
+    {
+        // Single transfer: the size is reloaded and the channel disabled
+        g_uiDma0Ctl = (g_uiDma0Ctl & ~DMAEN) | DMAIFG;
+        g_uiDma0CtlSeen = g_uiDma0Ctl;
+        DMA0SZ = g_uiDmaSize;
+    }
+
+    // Loading an idle USCI sets UCTXIFG again, which triggers the next
+    // transfer from here
+    modelTxLoad(ucByte);
+}
+
+//*****************************************************************************
+//
+// Sets UCTXIFG, triggering DMA0 on its rising edge.
+//
+//*****************************************************************************
+static void modelTxIfgSet(void)
+{
+    bool bEdge = !(g_ucSpiIfg & UCTXIFG);
+
+    g_ucSpiIfg |= UCTXIFG;
+    g_ucSpiIfgSeen = g_ucSpiIfg;
+
+    if(bEdge)
+    {
+        modelDmaTrigger();
+    }
+}
+
+//*****************************************************************************
+//
+// Moves the TX buffer to the shift register if it is free.
+//
+//*****************************************************************************
+static void modelShiftStart(void)
+{
+    if(g_bShifting || !g_bTxFull)
+    {
+        return;
+    }
+
+    g_bShifting = true;
+    g_bTxFull = false;
+    g_ucShiftByte = g_ucTxByte;
+    g_ucShiftCtl0 = UCB0CTL0;
+    g_uiShiftClkDiv = modelClkDiv();
+    g_ullShiftEnd = g_ullNow + 8 * (uint64_t)g_uiShiftClkDiv;
+
+    modelTxIfgSet();
+}
+
+//*****************************************************************************
+//
+// A byte written to UCB0TXBUF, by the CPU or DMA0.
+//
+//*****************************************************************************
+static void modelTxLoad(uint8_t ucByte)
+{
+    if(UCB0CTL1 & UCSWRST)
+    {
+        spyModelError("UCB0TXBUF written with UCSWRST set");
+        return;
+    }
+
+    if(g_bTxFull)
+    {
+        spyModelError("UCB0TXBUF written while full");
+    }
+
+    g_bTxFull = true;
+    g_ucTxByte = ucByte;
+    g_ucSpiIfg &= ~UCTXIFG;
+    g_ucSpiIfgSeen = g_ucSpiIfg;
+
+    modelShiftStart();
+}
+
+//*****************************************************************************
+//
+// The end of the shift of a byte.
+//
+//*****************************************************************************
+static void modelShiftEnd(void)
+{
+    g_bShifting = false;
+    g_ucRxBuf = g_ucShiftByte;
+    g_ucSpiIfg |= UCRXIFG;
+    g_ucSpiIfgSeen = g_ucSpiIfg;
+
+    spyBusByte(g_ucShiftByte, g_ucPort6, g_ucShiftCtl0, g_uiShiftClkDiv,
+               (uint32_t)g_ullNow);
+
+    modelShiftStart();
+}
+
+//*****************************************************************************
+//
+// TA0R, which counts from g_ullTa0Zero while TA0 runs.
+//
+//*****************************************************************************
+static uint16_t modelTa0R(void)
+{
+    return g_bTa0Running ? (uint16_t)(g_ullNow - g_ullTa0Zero) : g_uiTa0Held;
+}
+
+//*****************************************************************************
+//
+// Returns the tick at which TA0R next reaches TA0CCR0. A compare equal to TA0R
+// is only reached once the count comes round again.
+//
+//*****************************************************************************
+static uint64_t modelTa0Match(void)
+{
+    uint32_t ulAhead;
+
+    if(!g_bTa0Running)
+    {
+        return MODEL_NEVER;
+    }
+
+    ulAhead = (uint16_t)(TA0CCR0 - modelTa0R());
+
+    return g_ullNow + (ulAhead ? ulAhead : 0x10000);
+}
+
+//*****************************************************************************
+//
+// Runs the peripherals up to a point in time.
+//
+//*****************************************************************************
+static void modelAdvance(uint64_t ullTo)
+{
+    uint64_t ullShift;
+    uint64_t ullMatch;
+    uint64_t ullNext;
+
+    for(;;)
+    {
+        ullShift = g_bShifting ? g_ullShiftEnd : MODEL_NEVER;
+        ullMatch = modelTa0Match();
+        ullNext = (ullShift < ullMatch) ? ullShift : ullMatch;
+
+        if(ullNext > ullTo)
+        {
+            break;
+        }
+
+        g_ullNow = ullNext;
+
+        if(ullNext == ullMatch)
+        {
+            g_uiTa0Cctl0 |= CCIFG;
+        }
+
+        if(ullNext == ullShift)
+        {
+            modelShiftEnd();
+        }
+    }
+
+    g_ullNow = ullTo;
+}
+
+//*****************************************************************************
+//
+// Runs the peripherals up to their next event that can end a wait: the end of
+// a byte, or a TA0 compare with its interrupt enabled. Returns false if there
+// is none.
+//
+//*****************************************************************************
+static bool modelAdvanceToEvent(void)
+{
+    uint64_t ullNext = g_bShifting ? g_ullShiftEnd : MODEL_NEVER;
+    uint64_t ullMatch = (g_uiTa0Cctl0 & CCIE) ? modelTa0Match() : MODEL_NEVER;
+
+    if(ullMatch < ullNext)
+    {
+        ullNext = ullMatch;
+    }
+
+    if(MODEL_NEVER == ullNext)
+    {
+        return false;
+    }
+
+    modelAdvance(ullNext);
+    return true;
+}
+
+//*****************************************************************************
+//
+// Takes in a write to TA0CTL.
+//
+//*****************************************************************************
+static void modelTa0Sync(void)
+{
+    bool bRunning = (g_uiTa0Ctl & MC_3) == MC__CONTINUOUS;
+
+    if(g_uiTa0Ctl & TACLR)
+    {
+        g_uiTa0Ctl &= ~TACLR;
+        g_uiTa0Held = 0;
+        g_ullTa0Zero = g_ullNow;
+    }
+
+    if(bRunning && ((g_uiTa0Ctl & TASSEL_3) != TASSEL__SMCLK))
+    {
+        spyModelError("TA0 only runs from SMCLK in the model");
+    }
+    else if(!bRunning && ((g_uiTa0Ctl & MC_3) != MC__STOP))
+    {
+        spyModelError("TA0 only runs in continuous mode in the model");
+    }
+
+    if(bRunning && !g_bTa0Running)
+    {
+        g_ullTa0Zero = g_ullNow - g_uiTa0Held;
+    }
+    else if(!bRunning && g_bTa0Running)
+    {
+        g_uiTa0Held = modelTa0R();
+    }
+
+    g_bTa0Running = bRunning;
+}
+
+//*****************************************************************************
+//
+// Takes in what the code wrote to the registers since the model last looked.
+//
+//*****************************************************************************
+static void modelSync(void)
+{
+    bool bSelected;
+
+    if(MODEL_TXBUF_EMPTY != g_uiSpiTxPort)
+    {
+        uint8_t ucByte = (uint8_t)g_uiSpiTxPort;
+
+        g_uiSpiTxPort = MODEL_TXBUF_EMPTY;
+        modelTxLoad(ucByte);
+    }
+
+    if(UCB0CTL1 & UCSWRST)
+    {
+        if(g_bShifting || g_bTxFull)
+        {
+            spyModelError("UCB0 reset with a byte in flight");
+            g_bShifting = false;
+            g_bTxFull = false;
+        }
+
+        // The reset sets UCTXIFG, which is no trigger, and clears the
+        // interrupt enables
+        g_ucSpiIfg = (g_ucSpiIfg & ~UCRXIFG) | UCTXIFG;
+        g_ucSpiIfgSeen = g_ucSpiIfg;
+        UCB0IE &= ~(UCRXIE | UCTXIE);
+    }
+
+    if((g_uiDma0Ctl & DMAEN) && !(g_uiDma0CtlSeen & DMAEN))
+    {
+        g_ulDmaSrc = DMA0SA;
+        g_uiDmaLeft = DMA0SZ;
+        g_uiDmaSize = DMA0SZ;
+
+        if(!g_uiDmaSize)
+        {
+            spyModelError("DMA0 enabled with a size of 0");
+            g_uiDma0Ctl &= ~DMAEN;
+        }
+    }
+
+    g_uiDma0CtlSeen = g_uiDma0Ctl;
+
+    if((g_ucSpiIfg & UCTXIFG) && !(g_ucSpiIfgSeen & UCTXIFG))
+    {
+        g_ucSpiIfgSeen = g_ucSpiIfg;
+        modelDmaTrigger();
+    }
+
+    g_ucSpiIfgSeen = g_ucSpiIfg;
+
+    modelTa0Sync();
+
+    bSelected = (g_ucPort6 & PIN_CS) != 0;
+
+    if(bSelected != g_bLcdSelected)
+    {
+        g_bLcdSelected = bSelected;
+        spyLcdSelect(bSelected);
+    }
+}
+
+//*****************************************************************************
+//
+// Returns the ISR of the highest priority interrupt pending, or 0.
+//
+//*****************************************************************************
+static void (*modelPendingIsr(void))(void)
+{
+    if((g_ucSpiIfg & UCB0IE & (UCRXIFG | UCTXIFG)) && USCI_B0_ISR)
+    {
+        return USCI_B0_ISR;
+    }
+
+    if(((g_uiTa0Cctl0 & (CCIFG | CCIE)) == (CCIFG | CCIE)) && TIMER0_A0_ISR)
+    {
+        return TIMER0_A0_ISR;
+    }
+
+    if(((g_uiDma0Ctl & (DMAIFG | DMAIE)) == (DMAIFG | DMAIE)) && DMA_ISR)
+    {
+        return DMA_ISR;
+    }
+
+    return 0;
+}
+
+//*****************************************************************************
+//
+// Takes the interrupts pending, if GIE is set. Returns true if any was taken.
+//
+//*****************************************************************************
+static bool modelDispatch(void)
+{
+    void (*pfnIsr)(void);
+    bool bTaken = false;
+    uint64_t ullEntry;
+
+    while(g_bGie && !g_bInIsr && ((pfnIsr = modelPendingIsr()) != 0))
+    {
+        g_bInIsr = true;
+        g_bGie = false;
+
+        // The TA0 CCR0 vector has a single source, its flag is cleared on entry
+        if(TIMER0_A0_ISR == pfnIsr)
+        {
+            g_uiTa0Cctl0 &= ~CCIFG;
+        }
+
+        ullEntry = g_ullNow;
+        modelAdvance(g_ullNow + MODEL_ISR_TICKS);
+
+        pfnIsr();
+
+        modelSync();
+
+        if(g_ullNow - ullEntry > g_ulLongestIsr)
+        {
+            g_ulLongestIsr = (uint32_t)(g_ullNow - ullEntry);
+        }
+
+        g_bInIsr = false;
+        g_bGie = true;
+        bTaken = true;
+    }
+
+    return bTaken;
+}
+
+//*****************************************************************************
+//
+// Every entry into the model: takes in the register writes, lets time pass
+// and takes the interrupts that became due.
+//
+//*****************************************************************************
+static void modelEnter(uint32_t ulTicks)
+{
+    modelSync();
+    modelAdvance(g_ullNow + ulTicks);
+    modelDispatch();
+    modelSync();
+}
+
+//*****************************************************************************
+//
+// The registers with side effects.
+//
+//*****************************************************************************
+volatile uint8_t *spyPort6(void)
+{
+    modelEnter(MODEL_ACCESS_TICKS);
+    return &g_ucPort6;
+}
+
+volatile uint8_t *spySpiIfg(void)
+{
+    modelEnter(MODEL_ACCESS_TICKS);
+    return &g_ucSpiIfg;
+}
+
+uint8_t spySpiStat(void)
+{
+    modelEnter(MODEL_ACCESS_TICKS);
+    return (g_bShifting || g_bTxFull) ? UCBUSY : 0;
+}
+
+volatile uint16_t *spySpiTxBuf(void)
+{
+    modelEnter(MODEL_ACCESS_TICKS);
+    return &g_uiSpiTxPort;
+}
+
+uint8_t spySpiRxBuf(void)
+{
+    modelEnter(MODEL_ACCESS_TICKS);
+    g_ucSpiIfg &= ~UCRXIFG;
+    g_ucSpiIfgSeen = g_ucSpiIfg;
+    return g_ucRxBuf;
+}
+
+uint16_t spySpiIv(void)
+{
+    modelEnter(MODEL_ACCESS_TICKS);
+
+    if(g_ucSpiIfg & UCB0IE & UCRXIFG)
+    {
+        g_ucSpiIfg &= ~UCRXIFG;
+        g_ucSpiIfgSeen = g_ucSpiIfg;
+        return USCI_UCRXIFG;
+    }
+
+    if(g_ucSpiIfg & UCB0IE & UCTXIFG)
+    {
+        g_ucSpiIfg &= ~UCTXIFG;
+        g_ucSpiIfgSeen = g_ucSpiIfg;
+        return USCI_UCTXIFG;
+    }
+
+    return 0;
+}
+
+volatile uint16_t *spyDma0Ctl(void)
+{
+    modelEnter(MODEL_ACCESS_TICKS);
+    return &g_uiDma0Ctl;
+}
+
+uint16_t spyDmaIv(void)
+{
+    modelEnter(MODEL_ACCESS_TICKS);
+
+    if(g_uiDma0Ctl & DMAIFG)
+    {
+        g_uiDma0Ctl &= ~DMAIFG;
+        g_uiDma0CtlSeen = g_uiDma0Ctl;
+        return DMAIV_DMA0IFG;
+    }
+
+    return 0;
+}
+
+volatile uint16_t *spyTa0Ctl(void)
+{
+    modelEnter(MODEL_ACCESS_TICKS);
+    return &g_uiTa0Ctl;
+}
+
+uint16_t spyTa0R(void)
+{
+    modelEnter(MODEL_ACCESS_TICKS);
+    return modelTa0R();
+}
+
+volatile uint16_t *spyTa0Cctl0(void)
+{
+    modelEnter(MODEL_ACCESS_TICKS);
+    return &g_uiTa0Cctl0;
+}
+
+void spyWriteAddr(const char *pcRegister, uintptr_t ulValue)
+{
+    modelEnter(MODEL_ACCESS_TICKS);
+
+    if(strstr(pcRegister, "DMA0SA"))
+    {
+        DMA0SA = ulValue;
+    }
+    else if(strstr(pcRegister, "DMA0DA"))
+    {
+        DMA0DA = ulValue;
+    }
+    else
+    {
+        spyModelError("__data16_write_addr() to an unknown register");
+    }
+}
+
+//*****************************************************************************
+//
+// The intrinsics.
+//
+//*****************************************************************************
+void spyNop(void)
+{
+    modelEnter(MODEL_INTRINSIC_TICKS);
+}
+
+void spyDelayCycles(uint32_t ulCycles)
+{
+    modelEnter(ulCycles);
+}
+
+void spyEnableInterrupt(void)
+{
+    g_bGie = !g_bInIsr;
+    modelEnter(MODEL_INTRINSIC_TICKS);
+}
+
+void spyDisableInterrupt(void)
+{
+    modelEnter(MODEL_INTRINSIC_TICKS);
+    g_bGie = false;
+}
+
+unsigned short spyGetInterruptState(void)
+{
+    modelEnter(MODEL_INTRINSIC_TICKS);
+    return g_bGie ? GIE : 0;
+}
+
+void spySetInterruptState(unsigned short uiState)
+{
+    g_bGie = (uiState & GIE) != 0;
+    modelEnter(MODEL_INTRINSIC_TICKS);
+}
+
+void spyBisSr(unsigned short uiBits)
+{
+    if(uiBits & GIE)
+    {
+        g_bGie = true;
+    }
+
+    // Asleep until an ISR clears CPUOFF on its exit, which may be the ISR of
+    // an interrupt already pending
+    g_bWake = false;
+
+    modelEnter(MODEL_INTRINSIC_TICKS);
+
+    if(!(uiBits & CPUOFF))
+    {
+        return;
+    }
+
+    if(g_bInIsr)
+    {
+        spyModelError("CPU put to sleep in an ISR");
+        return;
+    }
+
+    while(!g_bWake)
+    {
+        if(!g_bGie)
+        {
+            spyModelError("CPU put to sleep with interrupts disabled");
+            break;
+        }
+
+        if(modelDispatch())
+        {
+            continue;
+        }
+
+        if(!modelAdvanceToEvent())
+        {
+            spyModelError("CPU asleep with nothing left to wake it");
+            break;
+        }
+
+        modelSync();
+    }
+}
+
+void spyBicSrOnExit(unsigned short uiBits)
+{
+    if(!g_bInIsr)
+    {
+        spyModelError("__bic_SR_register_on_exit() outside an ISR");
+        return;
+    }
+
+    if(uiBits & CPUOFF)
+    {
+        g_bWake = true;
+    }
+}
+
+//*****************************************************************************
+//
+// Runs the peripherals and ISRs until nothing is left in flight, as the main
+// loop of a lab idles with interrupts enabled.
+//
+//*****************************************************************************
+void spyRunToIdle(void)
+{
+    bool bGie = g_bGie;
+
+    if(g_bInIsr)
+    {
+        return;
+    }
+
+    g_bGie = true;
+    modelSync();
+
+    while(modelDispatch() || modelAdvanceToEvent())
+    {
+        modelSync();
+    }
+
+    if(g_uiDma0Ctl & DMAEN)
+    {
+        spyModelError("DMA0 armed with no UCTXIFG edge left to trigger it");
+    }
+
+    g_bGie = bGie;
+}
+
+//*****************************************************************************
+//
+// Returns the ticks the longest ISR took since the previous call, from entry
+// to exit.
+//
+//*****************************************************************************
+uint32_t spyTakeLongestIsr(void)
+{
+    uint32_t ulTicks = g_ulLongestIsr;
+
+    g_ulLongestIsr = 0;
+    return ulTicks;
+}
+
+//*****************************************************************************
+//
+// Returns the model time, in SMCLK ticks.
+//
+//*****************************************************************************
+uint32_t spyTicks(void)
+{
+    return (uint32_t)g_ullNow;
+}
@@ -0,0 +1,440 @@
+//*****************************************************************************
+//
+// sharp_capture.c - Runs the Sharp96x96 driver on the host and captures what
+// it sends to the panel.
+//
+// The driver of a lab project and its HAL are built unchanged against the
+// UCB0 and DMA0 model of msp430_model.c, the Sharp protocol decoder of
+// sharp_spy.c and the grlib subset of grlib_host.c. A fixed set of scenes, modeled on the lab screens, is drawn
+// and flushed one at a time. For every flush the tool reports the SPI
+// transactions, lines and bytes sent and the modeled transfer time, and
+// writes or checks a PBM of the panel contents.
+//
+// Build and run it from the root of a lab project:
+//
+//     gcc -I ../tools/sharp_host -I grlib -I . -o sharp_capture
+//         ../tools/sharp_host/*.c grlib/*.c LcdDriver/Sharp96x96.c
+//         LcdDriver/Sharp96x96_Widgets.c
+//         LcdDriver/HAL_MSP_EXP430FR5529_Sharp96x96.c
+//         LcdDriver/HAL_MSP_EXP430FR5529_SpiBus.c
+//         fonts/fontfixed6x8.c fonts/fontfixed6x8_rot90.c
+//     ./sharp_capture              compare with the reference frames
+//     ./sharp_capture -c frames    compare with frames/NN_scene.pbm
+//     ./sharp_capture -o frames    write frames/NN_scene.pbm
+//
+// The reference frames, in ../tools/sharp_host/frames, are those of the lab
+// projects as configured. They are the same for all three labs. A change that
+// is meant to alter what reaches the panel rewrites them with -o, and the new
+// frames are reviewed and committed with it.
+//
+// The PBMs show the panel memory as sent, one image row per LCD line, so a
+// ROTATE_90 build shows the screen turned by 90 degrees. The exit status is
+// non-zero if the decoder saw a protocol error, or a frame did not match or
+// had no reference to be compared with.
+//
+//*****************************************************************************
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "grlib.h"
+#include "LcdDriver/Sharp96x96.h"
+#include "LcdDriver/Sharp96x96_Widgets.h"
+#include "LcdDriver/HAL_MSP_EXP430FR5529_Sharp96x96.h"
+#include "button.h"
+#include "checkbox.h"
+#include "radioButton.h"
+#include "widget.h"
+#include "sharp_spy.h"
+
+#define NUM_ELEMENTS(a)     (sizeof(a) / sizeof((a)[0]))
+
+// Reference frames, from the root of a lab project
+#define REFERENCE_DIR       "../tools/sharp_host/frames"
+
+Graphics_Context g_sContext;
+static Sharp96x96_Label g_sLabel;
+
+//*****************************************************************************
+//
+// Draws a string centered on a point, as the labs do.
+//
+//*****************************************************************************
+static void drawCentered(const char *string, int32_t x, int32_t y)
+{
+#ifdef ROTATE_90
+    Sharp96x96_DrawStringCentered(&g_sContext, (const uint8_t *)string,
+                                  AUTO_STRING_LENGTH, x, y, TRANSPARENT_TEXT);
+#else
+    Graphics_drawStringCentered(&g_sContext, (uint8_t *)string,
+                                AUTO_STRING_LENGTH, x, y, TRANSPARENT_TEXT);
+#endif
+}
+
+//*****************************************************************************
+//
+// The scenes. Each one draws a screen, the caller flushes it.
+//
+//*****************************************************************************
+static void sceneInit(void)
+{
+    // As configDisplay() does, on a panel fresh out of reset
+    spyReset();
+    Sharp96x96_Init();
+    Graphics_initContext(&g_sContext, &g_sharp96x96LCD);
+    Graphics_setForegroundColor(&g_sContext, ClrBlack);
+    Graphics_setBackgroundColor(&g_sContext, ClrWhite);
+    Graphics_setFont(&g_sContext, &g_sFontFixed6x8);
+    Graphics_clearDisplay(&g_sContext);
+
+    Sharp96x96_LabelInit(&g_sLabel, 48, 15);
+}
+
+static void sceneDate(void)
+{
+    Sharp96x96_LabelSetText(&g_sContext, &g_sLabel, (const uint8_t *)"Nov 05");
+}
+
+static void sceneTime(void)
+{
+    Sharp96x96_LabelSetText(&g_sContext, &g_sLabel, (const uint8_t *)"12:34:56");
+}
+
+static void sceneSecondTick(void)
+{
+    Sharp96x96_LabelSetText(&g_sContext, &g_sLabel, (const uint8_t *)"12:34:57");
+}
+
+static void sceneMinuteTick(void)
+{
+    Sharp96x96_LabelSetText(&g_sContext, &g_sLabel, (const uint8_t *)"12:35:00");
+}
+
+static void sceneTemp(void)
+{
+    Sharp96x96_LabelSetText(&g_sContext, &g_sLabel, (const uint8_t *)"23.4C");
+}
+
+static void sceneEditTime(void)
+{
+    Graphics_clearDisplay(&g_sContext);
+    Sharp96x96_LabelInvalidate(&g_sLabel);
+    drawCentered("12:35:00", 48, 15);
+    Graphics_drawLineH(&g_sContext, 24, 34, 20);
+}
+
+static void sceneMenu(void)
+{
+    Graphics_clearDisplay(&g_sContext);
+    drawCentered("Select a song", 48, 15);
+    drawCentered("1: Twinkle", 48, 30);
+    drawCentered("2: Song 2", 48, 45);
+    drawCentered("3: Song 3", 48, 60);
+}
+
+static void sceneShapes(void)
+{
+    Graphics_Rectangle rect = { 10, 70, 85, 90 };
+
+    Graphics_fillRectangle(&g_sContext, &rect);
+    Graphics_drawLineV(&g_sContext, 5, 0, 95);
+    Graphics_drawLineV(&g_sContext, 90, 0, 95);
+    Graphics_drawPixel(&g_sContext, 47, 80);
+}
+
+static void sceneVcom(void)
+{
+    // Called from the 1 s timer ISR in the labs. No frame has been requested
+    // to carry the flip, so it goes out on its own.
+    Sharp96x96_SendToggleVCOMCommand();
+}
+
+#ifndef DISPLAY_LIST
+static void sceneSurface(void)
+{
+    static uint8_t buffer[SHARP_SURFACE_BYTES(40, 12)];
+    static Sharp96x96_Surface surface;
+    Graphics_Context context;
+    Graphics_Rectangle rect = { 2, 2, 9, 9 };
+
+    // A strike meter, drawn once offscreen then composited twice
+    Sharp96x96_SurfaceInit(&surface, buffer, 40, 12);
+    Graphics_initContext(&context, &surface.display);
+    Graphics_setForegroundColor(&context, ClrBlack);
+    Graphics_setBackgroundColor(&context, ClrWhite);
+    Graphics_setFont(&context, &g_sFontFixed6x8);
+    Graphics_clearDisplay(&context);
+
+    Graphics_fillRectangle(&context, &rect);
+    Graphics_drawLineH(&context, 0, 39, 11);
+    Graphics_drawLineV(&context, 39, 0, 11);
+#ifdef ROTATE_90
+    Sharp96x96_DrawString(&context, (const uint8_t *)"x2", AUTO_STRING_LENGTH,
+                          14, 2, OPAQUE_TEXT);
+#else
+    Graphics_drawString(&context, (uint8_t *)"x2", AUTO_STRING_LENGTH, 14, 2,
+                        OPAQUE_TEXT);
+#endif
+
+    Graphics_clearDisplay(&g_sContext);
+    Sharp96x96_BlitSurface(&g_sContext, &surface, 24, 40, SHARP_BLIT_COPY);
+    Sharp96x96_BlitSurface(&g_sContext, &surface, 67, 83, SHARP_BLIT_AND);
+    Sharp96x96_BlitSurface(&g_sContext, &surface, 30, 44, SHARP_BLIT_XOR);
+}
+
+//*****************************************************************************
+//
+// Images drawn onto a surface: an 8 bpp one clipped on the left, and a row of
+// 1 bpp data handed over with the compression flags of its format still set,
+// as grlib does with a row it has decompressed.
+//
+//*****************************************************************************
+static const unsigned long g_pulImagePalette[] = { ClrBlack, ClrWhite };
+
+// A 12x6 arrow pointing left, entry 0 being black
+static const uint8_t g_pucArrowPixels[] =
+{
+    1, 1, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1,
+    1, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+};
+
+static const Graphics_Image g_sArrowImage =
+{
+    IMAGE_FMT_8BPP_UNCOMP, 12, 6, 2, (const uint32_t *)g_pulImagePalette,
+    g_pucArrowPixels
+};
+
+static void sceneSurfaceImage(void)
+{
+    static const uint8_t pucRow[] = { 0xA5, 0x0F, 0xF0 };
+    static uint8_t buffer[SHARP_SURFACE_BYTES(24, 12)];
+    static Sharp96x96_Surface surface;
+    uint32_t palette[2] = { ClrBlack, ClrWhite };
+    Graphics_Context context;
+
+    Sharp96x96_SurfaceInit(&surface, buffer, 24, 12);
+    Graphics_initContext(&context, &surface.display);
+    Graphics_setForegroundColor(&context, ClrBlack);
+    Graphics_setBackgroundColor(&context, ClrWhite);
+    Graphics_clearDisplay(&context);
+
+    // The first 5 columns of the arrow fall off the surface
+    Graphics_drawImage(&context, &g_sArrowImage, -5, 0);
+    Graphics_drawImage(&context, &g_sArrowImage, 10, 0);
+
+    // Starts 3 pixels into the first byte of the row
+    surface.display.callPixelDrawMultiple(surface.display.displayData, 2, 9, 3,
+                                          18, IMAGE_FMT_1BPP_COMP_RLE4,
+                                          pucRow, palette);
+
+    Graphics_clearDisplay(&g_sContext);
+    Sharp96x96_BlitSurface(&g_sContext, &surface, 36, 42, SHARP_BLIT_COPY);
+}
+#endif
+
+//*****************************************************************************
+//
+// A settings screen of widgets. Selecting them afterwards should only send
+// the lines under the parts that change.
+//
+//*****************************************************************************
+static Graphics_Button g_sOkButton =
+{
+    60, 88, 76, 90, 1, false, ClrWhite, ClrBlack, ClrBlack, ClrBlack, ClrWhite,
+    68, 79, (int8_t *)"OK", &g_sFontFixed6x8
+};
+
+static Graphics_CheckBox g_sBeepCheckBox =
+{
+    8, 24, false, 1, ClrBlack, ClrWhite, ClrBlack, 4, &g_sFontFixed6x8,
+    (int8_t *)"Beep"
+};
+
+static Graphics_RadioButton g_sSlowRadioButton =
+{
+    8, 40, true, 1, ClrBlack, 4, ClrBlack, ClrWhite, &g_sFontFixed6x8,
+    (int8_t *)"Slow"
+};
+
+static Graphics_RadioButton g_sFastRadioButton =
+{
+    8, 52, false, 1, ClrBlack, 4, ClrBlack, ClrWhite, &g_sFontFixed6x8,
+    (int8_t *)"Fast"
+};
+
+static Graphics_Widget g_sScreenWidget;
+static Graphics_Widget g_sSpeedWidget;
+static Graphics_Widget g_sWidgets[4];
+
+static void sceneWidgets(void)
+{
+    Graphics_initWidget(&g_sContext, &g_sScreenWidget, GRAPHICS_WIDGET_GROUP,
+                        0);
+    Graphics_initWidget(&g_sContext, &g_sSpeedWidget, GRAPHICS_WIDGET_GROUP, 0);
+    Graphics_initWidget(&g_sContext, &g_sWidgets[0], GRAPHICS_WIDGET_CHECKBOX,
+                        &g_sBeepCheckBox);
+    Graphics_initWidget(&g_sContext, &g_sWidgets[1],
+                        GRAPHICS_WIDGET_RADIOBUTTON, &g_sSlowRadioButton);
+    Graphics_initWidget(&g_sContext, &g_sWidgets[2],
+                        GRAPHICS_WIDGET_RADIOBUTTON, &g_sFastRadioButton);
+    Graphics_initWidget(&g_sContext, &g_sWidgets[3], GRAPHICS_WIDGET_BUTTON,
+                        &g_sOkButton);
+
+    Graphics_addWidget(&g_sScreenWidget, &g_sWidgets[0]);
+    Graphics_addWidget(&g_sSpeedWidget, &g_sWidgets[1]);
+    Graphics_addWidget(&g_sSpeedWidget, &g_sWidgets[2]);
+    Graphics_addWidget(&g_sScreenWidget, &g_sSpeedWidget);
+    Graphics_addWidget(&g_sScreenWidget, &g_sWidgets[3]);
+
+    Graphics_clearDisplay(&g_sContext);
+    drawCentered("Settings", 48, 10);
+    Graphics_drawWidget(&g_sContext, &g_sScreenWidget);
+}
+
+static void sceneWidgetSelect(void)
+{
+    Graphics_selectWidget(&g_sContext,
+                          Graphics_findWidget(&g_sScreenWidget, 10, 26), true);
+    Graphics_selectWidget(&g_sContext,
+                          Graphics_findWidget(&g_sScreenWidget, 10, 54), true);
+}
+
+static void sceneButtonSelect(void)
+{
+    Graphics_selectWidget(&g_sContext, &g_sWidgets[3], true);
+}
+
+static void sceneVcomFrame(void)
+{
+    Graphics_Rectangle rect = { 30, 30, 65, 65 };
+
+    // A flip while a frame has been requested rides on its command byte, and
+    // the frame is a single transaction
+    Graphics_fillRectangle(&g_sContext, &rect);
+    Sharp96x96_RequestFlush();
+    Sharp96x96_SendToggleVCOMCommand();
+    Sharp96x96_ServiceFlush(&g_sContext, 1000);
+}
+
+static const struct
+{
+    const char *name;
+    void (*draw)(void);
+}
+g_scenes[] =
+{
+    { "init", sceneInit },
+    { "date", sceneDate },
+    { "time", sceneTime },
+    { "second_tick", sceneSecondTick },
+    { "minute_tick", sceneMinuteTick },
+    { "temp", sceneTemp },
+    { "edit_time", sceneEditTime },
+    { "menu", sceneMenu },
+    { "shapes", sceneShapes },
+    { "vcom", sceneVcom },
+#ifndef DISPLAY_LIST
+    { "surface", sceneSurface },
+#endif
+    { "widgets", sceneWidgets },
+    { "toggles", sceneWidgetSelect },
+    { "button_press", sceneButtonSelect },
+    { "vcom_frame", sceneVcomFrame },
+#ifndef DISPLAY_LIST
+    { "surface_image", sceneSurfaceImage },
+#endif
+};
+
+int main(int argc, char *argv[])
+{
+    const char *outDir = 0;
+    const char *checkDir = REFERENCE_DIR;
+    char path[256];
+    tSpyStats stats;
+    uint32_t totalBytes = 0;
+    uint32_t totalUs = 0;
+    unsigned mismatches = 0;
+    unsigned i;
+    int result;
+    int failed = 0;
+
+    if((argc == 3) && !strcmp(argv[1], "-o"))
+    {
+        outDir = argv[2];
+        checkDir = 0;
+    }
+    else if((argc == 3) && !strcmp(argv[1], "-c"))
+    {
+        checkDir = argv[2];
+    }
+    else if(argc != 1)
+    {
+        fprintf(stderr, "usage: %s [-o dir | -c dir]\n", argv[0]);
+        return 1;
+    }
+
+    printf("%-3s %-12s %6s %6s %6s %8s\n", "#", "scene", "trans", "lines",
+           "bytes", "time_us");
+
+    for(i = 0; i < NUM_ELEMENTS(g_scenes); i++)
+    {
+        g_scenes[i].draw();
+        Graphics_flushBuffer(&g_sContext);
+
+        spyTakeStats(&stats);
+        totalBytes += stats.bytes;
+        totalUs += spyTransferTimeUs(&stats);
+
+        printf("%-3u %-12s %6u %6u %6u %8u", i, g_scenes[i].name,
+               stats.transactions, stats.lines, stats.bytes,
+               spyTransferTimeUs(&stats));
+
+        if(stats.clears || stats.vcomToggles)
+        {
+            printf("   clears %u, vcom toggles %u", stats.clears,
+                   stats.vcomToggles);
+        }
+
+        failed |= (stats.errors != 0);
+
+        snprintf(path, sizeof(path), "%s/%02u_%s.pbm",
+                 outDir ? outDir : checkDir, i, g_scenes[i].name);
+
+        if(outDir)
+        {
+            failed |= (spyWritePbm(path) != 0);
+        }
+        else
+        {
+            // A missing reference fails, or a checkout without them would
+            // pass every time
+            result = spyComparePbm(path);
+
+            if(result)
+            {
+                printf("   %s", (result < 0) ? "NO REFERENCE" : "DIFFERS");
+                mismatches++;
+                failed = 1;
+            }
+        }
+
+        printf("\n");
+    }
+
+    printf("total %u bytes, %u us\n", totalBytes, totalUs);
+
+    if(checkDir)
+    {
+        printf("%u of %u frames match %s\n",
+               (unsigned)NUM_ELEMENTS(g_scenes) - mismatches,
+               (unsigned)NUM_ELEMENTS(g_scenes), checkDir);
+    }
+
+    return failed;
+}
@@ -0,0 +1,398 @@
+//*****************************************************************************
+//
+// sharp_spy.c - Sharp memory LCD protocol decoder behind the UCB0 model.
+//
+// msp430_model.c hands every byte UCB0 clocks out to spyBusByte(), with the
+// Port 6 and USCI configuration it went out with. The bytes sent with the LCD
+// chip select asserted go through a decoder of the Sharp command stream:
+//
+//     write line   M0 | VCOM, then per line: address, 12 data bytes, trailer,
+//                  then the frame trailer
+//     clear screen M2 | VCOM, trailer
+//     VCOM toggle  VCOM, trailer
+//
+// Line addresses are sent LSB first, so they go through reverse(). The decoder
+// keeps a copy of the panel memory, counts what each transaction cost and
+// reports any byte that breaks the protocol on stderr. Bytes sent to the other
+// devices of the bus are only counted. Every byte is also logged, for the tests
+// that check the stream itself.
+//
+//*****************************************************************************
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "grlib.h"
+#include "LcdDriver/Sharp96x96.h"
+#include "LcdDriver/HAL_MSP_EXP430FR5529_Sharp96x96.h"
+#include "sharp_spy.h"
+
+#define SPY_LINE_BYTES      (LCD_HORIZONTAL_MAX >> 3)
+
+// The USCI set up for the LCD: the clock phase, polarity and bit order of
+// g_sLcdSpiDevice and its clock divisor
+#define SPY_CTL0_MASK       (UCCKPH | UCCKPL | UCMSB)
+#define SPY_LCD_CTL0        (UCCKPH | UCMSB)
+#define SPY_LCD_CLK_DIV     ((SPI_CLK_TICKS > 1) ? SPI_CLK_TICKS : 1)
+
+// Mode bits of the command byte, the rest of it is VCOM
+#define SPY_CMD_MASK        ((uint8_t)~SHARP_VCOM_TOGGLE_BIT)
+
+// LCD timing of a transaction, from the LS013B4DN04 datasheet: CS setup
+// before the first clock and CS hold after the last one
+#define SPY_CS_SETUP_US     6
+#define SPY_CS_HOLD_US      2
+
+// The SPI clock, UCB0BR of 0 or 1 runs it at SMCLK
+#define SPY_SPI_HZ          (CLOCK_SMCLK_HZ / SPY_LCD_CLK_DIV)
+
+// CS hold in SMCLK ticks
+#define SPY_CS_HOLD_TICKS   CLOCK_TICKS(CLOCK_SMCLK_HZ, 1000000 / SPY_CS_HOLD_US)
+
+//*****************************************************************************
+//
+// Decoder state.
+//
+//*****************************************************************************
+enum
+{
+    SPY_IDLE,               // CS released, waiting for a command byte
+    SPY_ADDRESS,            // Waiting for a line address or the frame trailer
+    SPY_DATA,               // Receiving the data bytes of g_line
+    SPY_LINE_TRAILER,       // Waiting for the trailer of g_line
+    SPY_TRAILER,            // Waiting for the trailer of a clear or VCOM command
+    SPY_DONE                // Transaction complete, waiting for CS to drop
+};
+
+static uint8_t g_panel[LCD_VERTICAL_MAX][SPY_LINE_BYTES];
+static uint8_t g_state = SPY_IDLE;
+static uint8_t g_line;
+static uint8_t g_column;
+static int16_t g_vcom = -1;
+static tSpyStats g_stats;
+static tSpyByte g_log[SPY_LOG_LENGTH];
+static uint32_t g_logCount;
+static uint32_t g_lastLcdTicks;
+
+//*****************************************************************************
+//
+// Reports a protocol violation.
+//
+//*****************************************************************************
+static void spyError(const char *message, uint8_t byte)
+{
+    fprintf(stderr, "sharp_spy: %s (byte 0x%02x, transaction %u)\n", message,
+            byte, g_stats.transactions);
+    g_stats.errors++;
+}
+
+//*****************************************************************************
+//
+// Decodes one byte clocked out to the LCD.
+//
+//*****************************************************************************
+static void spyShiftOut(uint8_t byte)
+{
+    g_stats.bytes++;
+
+    switch(g_state)
+    {
+    case SPY_IDLE:
+        g_stats.transactions++;
+
+        if((g_vcom >= 0) && (g_vcom != (byte & SHARP_VCOM_TOGGLE_BIT)))
+        {
+            g_stats.vcomToggles++;
+        }
+
+        g_vcom = byte & SHARP_VCOM_TOGGLE_BIT;
+
+        switch(byte & SPY_CMD_MASK)
+        {
+        case SHARP_LCD_CMD_WRITE_LINE:
+            g_state = SPY_ADDRESS;
+            break;
+
+        case SHARP_LCD_CMD_CLEAR_SCREEN:
+            memset(g_panel, 0xFF, sizeof(g_panel));
+            g_stats.clears++;
+            g_state = SPY_TRAILER;
+            break;
+
+        case SHARP_LCD_CMD_CHANGE_VCOM:
+            g_state = SPY_TRAILER;
+            break;
+
+        default:
+            spyError("unknown command", byte);
+            g_state = SPY_DONE;
+            break;
+        }
+        break;
+
+    case SPY_ADDRESS:
+        if(SHARP_LCD_TRAILER_BYTE == byte)
+        {
+            g_state = SPY_DONE;
+        }
+        else if((reverse(byte) < 1) || (reverse(byte) > LCD_VERTICAL_MAX))
+        {
+            spyError("line address out of range", byte);
+            g_state = SPY_DONE;
+        }
+        else
+        {
+            g_line = reverse(byte) - 1;
+            g_column = 0;
+            g_state = SPY_DATA;
+        }
+        break;
+
+    case SPY_DATA:
+        g_panel[g_line][g_column++] = byte;
+
+        if(SPY_LINE_BYTES == g_column)
+        {
+            g_stats.lines++;
+            g_state = SPY_LINE_TRAILER;
+        }
+        break;
+
+    case SPY_LINE_TRAILER:
+    case SPY_TRAILER:
+        if(SHARP_LCD_TRAILER_BYTE != byte)
+        {
+            spyError("missing trailer", byte);
+        }
+
+        g_state = (SPY_LINE_TRAILER == g_state) ? SPY_ADDRESS : SPY_DONE;
+        break;
+
+    default:
+        spyError("byte after the end of a transaction", byte);
+        break;
+    }
+}
+
+//*****************************************************************************
+//
+// Takes a byte clocked out by UCB0, with the Port 6 output and the UCB0CTL0
+// and clock divisor it went out with. Called by the UCB0 model.
+//
+//*****************************************************************************
+void spyBusByte(uint8_t byte, uint8_t port6, uint8_t ctl0, uint16_t clkDiv,
+                uint32_t ticks)
+{
+    if(g_logCount < SPY_LOG_LENGTH)
+    {
+        g_log[g_logCount].byte = byte;
+        g_log[g_logCount].port6 = port6;
+        g_log[g_logCount].ctl0 = ctl0;
+        g_log[g_logCount].clkDiv = clkDiv;
+        g_log[g_logCount].ticks = ticks;
+    }
+
+    g_logCount++;
+
+    // A byte to another device of the bus
+    if(!(port6 & PIN_CS))
+    {
+        g_stats.otherBytes++;
+        return;
+    }
+
+    if(((ctl0 & SPY_CTL0_MASK) != SPY_LCD_CTL0) || (clkDiv != SPY_LCD_CLK_DIV))
+    {
+        spyError("byte sent to the LCD with the USCI set up for another device",
+                 byte);
+    }
+
+    g_lastLcdTicks = ticks;
+    spyShiftOut(byte);
+}
+
+//*****************************************************************************
+//
+// Takes a change of the LCD chip select. Called by the UCB0 model.
+//
+//*****************************************************************************
+void spyLcdSelect(bool selected)
+{
+    if(!selected && (g_state != SPY_IDLE) && (g_state != SPY_DONE))
+    {
+        spyError("CS released in the middle of a transaction", 0);
+    }
+    else if(!selected && (g_state == SPY_DONE) &&
+            (spyTicks() - g_lastLcdTicks < SPY_CS_HOLD_TICKS))
+    {
+        spyError("CS released before its hold time after the last clock", 0);
+    }
+
+    g_state = SPY_IDLE;
+}
+
+//*****************************************************************************
+//
+// Reports a misuse of the peripherals. Called by the model.
+//
+//*****************************************************************************
+void spyModelError(const char *message)
+{
+    fprintf(stderr, "msp430_model: %s (at tick %lu)\n", message,
+            (unsigned long)spyTicks());
+    g_stats.errors++;
+}
+
+//*****************************************************************************
+//
+// Returns the number of bytes clocked out since the last spyReset(). Only the
+// first SPY_LOG_LENGTH of them are logged.
+//
+//*****************************************************************************
+uint32_t spyLogCount(void)
+{
+    return g_logCount;
+}
+
+//*****************************************************************************
+//
+// Returns a logged byte.
+//
+//*****************************************************************************
+const tSpyByte *spyLog(uint32_t index)
+{
+    return &g_log[index];
+}
+
+//*****************************************************************************
+//
+// Forgets the panel contents and the statistics. The panel starts out white.
+//
+//*****************************************************************************
+void spyReset(void)
+{
+    memset(g_panel, 0xFF, sizeof(g_panel));
+    memset(&g_stats, 0, sizeof(g_stats));
+    g_state = SPY_IDLE;
+    g_vcom = -1;
+    g_logCount = 0;
+}
+
+//*****************************************************************************
+//
+// Returns the statistics gathered since the previous call and clears them,
+// once the transfers in flight have completed.
+//
+//*****************************************************************************
+void spyTakeStats(tSpyStats *stats)
+{
+    spyRunToIdle();
+
+    *stats = g_stats;
+    memset(&g_stats, 0, sizeof(g_stats));
+}
+
+//*****************************************************************************
+//
+// Models how long the bus was busy: every byte at the SPI clock, plus the CS
+// setup and hold time of every transaction.
+//
+//*****************************************************************************
+uint32_t spyTransferTimeUs(const tSpyStats *stats)
+{
+    return (uint32_t)(((uint64_t)stats->bytes * 8 * 1000000 + SPY_SPI_HZ - 1) / SPY_SPI_HZ) +
+           (uint32_t)stats->transactions * (SPY_CS_SETUP_US + SPY_CS_HOLD_US);
+}
+
+//*****************************************************************************
+//
+// Returns the panel memory of a line, once the transfers in flight have
+// completed. Bit 7 of the first byte is the left pixel and set bits are white.
+//
+//*****************************************************************************
+const uint8_t *spyPanelLine(uint16_t line)
+{
+    spyRunToIdle();
+    return g_panel[line];
+}
+
+//*****************************************************************************
+//
+// Writes the panel as a binary PBM, one image row per LCD line.
+//
+//*****************************************************************************
+int spyWritePbm(const char *path)
+{
+    FILE *file = fopen(path, "wb");
+    int line, i;
+
+    if(!file)
+    {
+        perror(path);
+        return -1;
+    }
+
+    spyRunToIdle();
+    fprintf(file, "P4\n%d %d\n", LCD_HORIZONTAL_MAX, LCD_VERTICAL_MAX);
+
+    // PBM pixels are black when set
+    for(line = 0; line < LCD_VERTICAL_MAX; line++)
+    {
+        for(i = 0; i < SPY_LINE_BYTES; i++)
+        {
+            fputc((uint8_t)~g_panel[line][i], file);
+        }
+    }
+
+    fclose(file);
+    return 0;
+}
+
+//*****************************************************************************
+//
+// Compares the panel with a PBM written by spyWritePbm(). Returns 0 when they
+// match, 1 when they differ and -1 when the file cannot be read.
+//
+//*****************************************************************************
+int spyComparePbm(const char *path)
+{
+    FILE *file = fopen(path, "rb");
+    int width, height;
+    int line, i;
+    int result = 0;
+
+    if(!file)
+    {
+        perror(path);
+        return -1;
+    }
+
+    if((fscanf(file, "P4 %d %d", &width, &height) != 2) || (fgetc(file) == EOF) ||
+       (width != LCD_HORIZONTAL_MAX) || (height != LCD_VERTICAL_MAX))
+    {
+        fprintf(stderr, "%s: not a %dx%d binary PBM\n", path, LCD_HORIZONTAL_MAX,
+                LCD_VERTICAL_MAX);
+        fclose(file);
+        return -1;
+    }
+
+    spyRunToIdle();
+
+    for(line = 0; (line < LCD_VERTICAL_MAX) && !result; line++)
+    {
+        for(i = 0; i < SPY_LINE_BYTES; i++)
+        {
+            if(fgetc(file) != (uint8_t)~g_panel[line][i])
+            {
+                fprintf(stderr, "%s: line %d differs\n", path, line);
+                result = 1;
+                break;
+            }
+        }
+    }
+
+    fclose(file);
+    return result;
+}
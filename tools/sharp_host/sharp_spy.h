@@ -0,0 +1,66 @@
+//*****************************************************************************
+//
+// sharp_spy.h - Sharp memory LCD protocol decoder behind the UCB0 model.
+//
+//*****************************************************************************
+
+#ifndef __SHARP_SPY_H__
+#define __SHARP_SPY_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Bytes kept in the log of the bus
+#define SPY_LOG_LENGTH      4096
+
+//*****************************************************************************
+//
+// What the decoder has seen on the SPI bus since the last spyTakeStats().
+//
+//*****************************************************************************
+typedef struct
+{
+    uint32_t bytes;             // Bytes clocked out with CS asserted
+    uint32_t otherBytes;        // Bytes clocked out to the other devices
+    uint16_t transactions;      // CS assertions
+    uint16_t lines;             // Lines written by write line commands
+    uint16_t clears;            // Clear screen commands
+    uint16_t vcomToggles;       // Transactions that flipped the VCOM bit
+    uint16_t errors;            // Protocol violations, reported on stderr
+} tSpyStats;
+
+//*****************************************************************************
+//
+// A byte clocked out by UCB0.
+//
+//*****************************************************************************
+typedef struct
+{
+    uint8_t byte;               // The byte
+    uint8_t port6;              // P6OUT while it went out, for the chip selects
+    uint8_t ctl0;               // UCB0CTL0 it went out with
+    uint16_t clkDiv;            // SPI clock divisor it went out with
+    uint32_t ticks;             // SMCLK tick its last bit went out at
+} tSpyByte;
+
+extern void spyReset(void);
+extern void spyTakeStats(tSpyStats *stats);
+extern uint32_t spyTransferTimeUs(const tSpyStats *stats);
+extern const uint8_t *spyPanelLine(uint16_t line);
+extern int spyWritePbm(const char *path);
+extern int spyComparePbm(const char *path);
+extern uint32_t spyLogCount(void);
+extern const tSpyByte *spyLog(uint32_t index);
+
+// The peripheral model of msp430_model.c
+extern void spyRunToIdle(void);
+extern uint32_t spyTicks(void);
+extern uint32_t spyTakeLongestIsr(void);
+
+// Called by the model
+extern void spyBusByte(uint8_t byte, uint8_t port6, uint8_t ctl0,
+                       uint16_t clkDiv, uint32_t ticks);
+extern void spyLcdSelect(bool selected);
+extern void spyModelError(const char *message);
+
+#endif // __SHARP_SPY_H__